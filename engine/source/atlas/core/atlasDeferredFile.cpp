@@ -10,6 +10,8 @@
 #include "core/fileStream.h"
 
 AtlasDeferredFile::AtlasDeferredFile()
+    : mDeferredRequestQueue(compareRequests, ThreadSafeRingQueue<AtlasDeferredIO*>::DefaultCapacity, true),
+    mDeferredResultQueue(ThreadSafeRingQueue<AtlasDeferredIO*>::DefaultCapacity, true)
 {
     mFilename = NULL;
     mStream = NULL;
@@ -17,7 +19,9 @@ AtlasDeferredFile::AtlasDeferredFile()
 
     mStreamMutex = Mutex::createMutex();
     mLoadingMutex = Mutex::createMutex();
-    mLoadingSemaphore = Semaphore::createSemaphore(0);
+    mPendingMutex = Mutex::createMutex();
+    mPendingRequests = 0;
+    mNextSequence = 0;
 
     mDeferredLoaderThread = NULL;
     mDeferredLoaderThreadActive = false;
@@ -31,7 +35,7 @@ AtlasDeferredFile::~AtlasDeferredFile()
 
     Mutex::destroyMutex(mStreamMutex);
     Mutex::destroyMutex(mLoadingMutex);
-    Semaphore::destroySemaphore(mLoadingSemaphore);
+    Mutex::destroyMutex(mPendingMutex);
 
     if (mStream)
     {
@@ -82,6 +86,19 @@ bool AtlasDeferredFile::initStream(const char* filename, U32 mode)
 
 //-----------------------------------------------------------------------------
 
+int AtlasDeferredFile::compareRequests(const QueuedRequest* a, const QueuedRequest* b)
+{
+    // Chunk writes always append and stub writes only touch stub records,
+    // so a read never overlaps a write it's let past.
+    const bool aWrite = a->adio->isWrite();
+    const bool bWrite = b->adio->isWrite();
+    if (aWrite != bWrite)
+        return aWrite ? 1 : -1;
+
+    // Wrap-safe, the sequence numbers in the queue are all close together.
+    return S32(a->sequence - b->sequence);
+}
+
 void AtlasDeferredFile::loaderThunk(void* a)
 {
     ((AtlasDeferredFile*)a)->loaderThread();
@@ -91,23 +108,25 @@ void AtlasDeferredFile::loaderThread()
 {
     while (true)
     {
-        AtlasDeferredIO* adio = NULL;
+        QueuedRequest request;
 
         U32 waitStartTime = Platform::getRealMilliseconds();
 
-        Semaphore::acquireSemaphore(mLoadingSemaphore, true);
+        // Sleep until there's a request, or stop() wakes us.
+        bool gotRequest = mDeferredRequestQueue.dequeue(request, true);
 
         mTimeSpentWaiting += Platform::getRealMilliseconds() - waitStartTime;
 
-        // May have been waken to quit.
+        // May have been woken to quit.
         if (!mDeferredLoaderThreadActive)
             return;
 
         // Otherwise, do our processing...
         Mutex::lockMutex(mLoadingMutex);
 
-        if (mDeferredRequestQueue.dequeue(adio))
+        if (gotRequest)
         {
+            AtlasDeferredIO* adio = request.adio;
             U32 workStartTime = Platform::getRealMilliseconds();
 
             Mutex::lockMutex(mStreamMutex);
@@ -126,6 +145,10 @@ void AtlasDeferredFile::loaderThread()
                 adio->complete();
 
             mTimeSpentWorking += Platform::getRealMilliseconds() - workStartTime;
+
+            Mutex::lockMutex(mPendingMutex);
+            mPendingRequests--;
+            Mutex::unlockMutex(mPendingMutex);
         }
 
         Mutex::unlockMutex(mLoadingMutex);
@@ -149,8 +172,15 @@ void AtlasDeferredFile::queue(AtlasDeferredIO* adio)
     }
     else
     {
-        mDeferredRequestQueue.queue(adio);
-        Semaphore::releaseSemaphore(mLoadingSemaphore);
+        QueuedRequest request;
+        request.adio = adio;
+
+        Mutex::lockMutex(mPendingMutex);
+        request.sequence = mNextSequence++;
+        mPendingRequests++;
+        Mutex::unlockMutex(mPendingMutex);
+
+        mDeferredRequestQueue.queue(request);
     }
 }
 
@@ -158,18 +188,15 @@ void AtlasDeferredFile::queue(AtlasDeferredIO* adio)
 bool AtlasDeferredFile::hasPendingIO()
 {
     PROFILE_START(AtlasDeferredFile_hasPendingIO);
-    if (isLoading())
-    {
-        PROFILE_END();
-        return true;
-    }
 
-    const Vector<AtlasDeferredIO*>& tmp = mDeferredRequestQueue.lockVector();
-    const U32 count = tmp.size();
-    mDeferredRequestQueue.unlockVector();
+    // Counts requests from queue() until the loader thread has finished
+    // them, so a request it is in the middle of still counts.
+    Mutex::lockMutex(mPendingMutex);
+    const bool pending = mPendingRequests != 0;
+    Mutex::unlockMutex(mPendingMutex);
 
     PROFILE_END();
-    return count != 0;
+    return pending;
 }
 
 void AtlasDeferredFile::start()
@@ -193,12 +220,12 @@ void AtlasDeferredFile::sync()
     // Copy results to a temp buffer to minimize lock time.
     FrameAllocatorMarker copyFam;
 
-    Vector<AtlasDeferredIO*>& resQ = mDeferredResultQueue.lockVector();
-    U32 resCount = resQ.size();
+    // Only take what's there now; anything arriving meanwhile waits for the
+    // next sync. We're the only consumer, so everything counted is ours.
+    U32 resCount = mDeferredResultQueue.size();
     AtlasDeferredIO** resData = (AtlasDeferredIO**)copyFam.alloc(resCount * sizeof(AtlasDeferredIO*));
-    dMemcpy(resData, resQ.address(), resCount * sizeof(AtlasDeferredIO*));
-    resQ.clear();
-    mDeferredResultQueue.unlockVector();
+    for (U32 i = 0; i < resCount; i++)
+        mDeferredResultQueue.dequeue(resData[i], true);
 
     PROFILE_END();
 
@@ -219,7 +246,7 @@ void AtlasDeferredFile::stop()
         mDeferredLoaderThreadActive = false;
 
         // Poke the thread so it'll stop.
-        Semaphore::releaseSemaphore(mLoadingSemaphore);
+        mDeferredRequestQueue.notify();
 
         // And clean up.
         SAFE_DELETE(mDeferredLoaderThread);
@@ -31,13 +31,33 @@ class AtlasDeferredFile
     void* mStreamMutex;
     Stream* mStream;
 
-    ThreadSafeQueue<AtlasDeferredIO*> mDeferredRequestQueue;
-    ThreadSafeQueue<AtlasDeferredIO*> mDeferredResultQueue;
+    /// A request and the order it was queued in.
+    struct QueuedRequest
+    {
+        AtlasDeferredIO* adio;
+        U32 sequence;
+    };
+
+    static int compareRequests(const QueuedRequest* a, const QueuedRequest* b);
+
+    /// Requests for the loader thread. Reads, which something is waiting
+    /// on, go ahead of writes; otherwise requests are done in the order they
+    /// were queued. Growable, so queue() never waits on the loader thread.
+    ThreadSafePriorityQueue<QueuedRequest> mDeferredRequestQueue;
+
+    /// Requests queued but not yet finished by the loader thread, and the
+    /// sequence number for the next one. Guarded by mPendingMutex.
+    void* mPendingMutex;
+    U32 mPendingRequests;
+    U32 mNextSequence;
+
+    /// Results awaiting sync(). Growable, as the loader thread must never
+    /// wait on the thread that calls sync().
+    ThreadSafeRingQueue<AtlasDeferredIO*> mDeferredResultQueue;
 
     bool mCanWriteStream;
 
     void* mLoadingMutex;
-    void* mLoadingSemaphore;
     Thread* mDeferredLoaderThread;
     volatile bool mDeferredLoaderThreadActive;
 
@@ -93,19 +113,10 @@ public:
         return mStream;
     }
 
-    /// Return true if we currently have an IO activity going on.
+    /// Return true if there are requests waiting for the loader thread.
     inline bool isLoading()
     {
-        bool isIt = false;
-
-        // If there's anything in the semaphore, we're loading.
-        if (Semaphore::acquireSemaphore(mLoadingSemaphore, false))
-        {
-            Semaphore::releaseSemaphore(mLoadingSemaphore);
-            isIt = true;
-        }
-
-        return isIt;
+        return mDeferredRequestQueue.size() != 0;
     }
 
     void* getLoadingMutex()
@@ -54,13 +54,12 @@ Resource<AtlasFile> AtlasFile::load(const char* filename)
 bool AtlasFile::smLogStubLoadStatus = false;
 
 AtlasFile::AtlasFile()
+    : mPendingDeserializeQueue(ThreadSafeRingQueue<AtlasReadNote*>::DefaultCapacity, true)
 {
     mLastSyncTime = Sim::getCurrentTime();
     mDeserializerThread = NULL;
     mDeserializerThreadActive = false;
     mLastProcessedTOC = 0;
-
-    mDeserializerSemaphore = Semaphore::createSemaphore(0);
 }
 
 AtlasFile::~AtlasFile()
@@ -70,9 +69,6 @@ AtlasFile::~AtlasFile()
 
     // And stop our threads.
     stopLoaderThreads();
-
-    // Do a little cleanup as well!
-    Semaphore::destroySemaphore(mDeserializerSemaphore);
 }
 
 //-----------------------------------------------------------------------------
@@ -249,7 +245,7 @@ void AtlasFile::stopLoaderThreads()
         mDeserializerThreadActive = false;
 
         // Flag the thread so it'll exit.
-        Semaphore::releaseSemaphore(mDeserializerSemaphore);
+        mPendingDeserializeQueue.notify();
 
         SAFE_DELETE(mDeserializerThread);
     }
@@ -409,23 +405,17 @@ void AtlasFile::deserializerThread()
 {
     while (true)
     {
-        // Block on a semaphore - on wake we're either quitting or have work.
-        Semaphore::acquireSemaphore(mDeserializerSemaphore, true);
+        // Block on the queue - on wake we're either quitting or have work.
+        AtlasReadNote* arn;
+        bool gotNote = mPendingDeserializeQueue.dequeue(arn, true);
 
         // Time to quit!
         if (!mDeserializerThreadActive)
             return;
 
-        // Otherwise, we have work, let's get on with it.
-        AtlasReadNote* arn;
-
-        // If we didn't get anything, stop and try again.
-        if (!mPendingDeserializeQueue.dequeue(arn))
-        {
-            Con::warnf("AtlasFile::deserializerThread - odd, nothing in pending "
-                "deserialize queue, was I woken for nothing? Sknxx...");
+        // Only stopLoaderThreads() wakes us without a note.
+        if (!gotNote)
             continue;
-        }
 
         // Otherwise, we've some work to do!
         AssertFatal((volatile void*)arn->adio->data, "AtlasFile::deserializerThread - no data in ADIO! (1)");
@@ -566,8 +556,7 @@ void AtlasFile::precache()
         Platform::sleep(32);
 
         // Check for pending data; if there is some just skip to a synch.
-        pendingCount = mPendingDeserializeQueue.lockVector().size();
-        mPendingDeserializeQueue.unlockVector();
+        pendingCount = mPendingDeserializeQueue.size();
 
         if (pendingCount)
             continue;
@@ -104,7 +104,9 @@ protected:
     ThreadSafeQueue<AtlasReadNote*> mPendingLoadQueue;
 
     /// Queue of notes that are done with IO and awaiting deserialization.
-    ThreadSafeQueue<AtlasReadNote*> mPendingDeserializeQueue;
+    /// The deserializer thread sleeps on it; it's growable since the IO
+    /// thread fills it and must never block.
+    ThreadSafeRingQueue<AtlasReadNote*> mPendingDeserializeQueue;
 
     /// Queue of notes that are ready for processing by the main thread.
     ThreadSafeQueue<AtlasReadNote*> mPendingProcessQueue;
@@ -122,8 +124,6 @@ protected:
     /// Control flag for the deserialization thread.
     volatile bool mDeserializerThreadActive;
 
-    void* mDeserializerSemaphore;
-
     /// Track time of last sync() call.
     U32 mLastSyncTime;
 
@@ -216,11 +216,8 @@ public:
     {
         AssertFatal(arn->adio->data, "AtlasFile::queuePendingDeserialize - no adio data!");
 
-        // Add to queue.
+        // Add to queue, this wakes the deserializer thread.
         mPendingDeserializeQueue.queue(arn);
-
-        // Release the semaphore so our flag will get scheduled.
-        Semaphore::releaseSemaphore(mDeserializerSemaphore);
     }
 
     /// Helper function - after you've done a bunch of writes, BEFORE you
@@ -4,4 +4,388 @@
 //-----------------------------------------------------------------------------
 
 #include "atlas/core/threadSafeQueue.h"
+#include "platform/platformThread.h"
+#include "console/console.h"
 
+BlockingQueueBase::BlockingQueueBase(U32 capacity, bool growable)
+{
+    AssertFatal(capacity, "BlockingQueueBase - zero capacity!");
+
+    mMutex = Mutex::createMutex();
+    mItemSemaphore = Semaphore::createSemaphore(0);
+    mSpaceSemaphore = growable ? NULL : Semaphore::createSemaphore(capacity);
+
+    mCount = 0;
+    mCapacity = capacity;
+    mWakeups = 0;
+}
+
+BlockingQueueBase::~BlockingQueueBase()
+{
+    Mutex::destroyMutex(mMutex);
+    Semaphore::destroySemaphore(mItemSemaphore);
+    if (mSpaceSemaphore)
+        Semaphore::destroySemaphore(mSpaceSemaphore);
+}
+
+bool BlockingQueueBase::lockForQueue(bool block)
+{
+    if (mSpaceSemaphore && !Semaphore::acquireSemaphore(mSpaceSemaphore, block))
+        return false;
+
+    Mutex::lockMutex(mMutex);
+    return true;
+}
+
+void BlockingQueueBase::unlockAfterQueue()
+{
+    mCount++;
+    Mutex::unlockMutex(mMutex);
+
+    Semaphore::releaseSemaphore(mItemSemaphore);
+}
+
+bool BlockingQueueBase::lockForDequeue(bool block)
+{
+    // The item semaphore counts items plus wakeups, so once we've got it
+    // there is one or the other waiting for us.
+    if (!Semaphore::acquireSemaphore(mItemSemaphore, block))
+        return false;
+
+    Mutex::lockMutex(mMutex);
+
+    // Prefer real items; a wakeup is only consumed once we're drained.
+    if (!mCount)
+    {
+        AssertFatal(mWakeups, "BlockingQueueBase::lockForDequeue - woken with no item or wakeup!");
+        mWakeups--;
+        Mutex::unlockMutex(mMutex);
+        return false;
+    }
+
+    return true;
+}
+
+void BlockingQueueBase::unlockAfterDequeue()
+{
+    mCount--;
+    Mutex::unlockMutex(mMutex);
+
+    if (mSpaceSemaphore)
+        Semaphore::releaseSemaphore(mSpaceSemaphore);
+}
+
+void BlockingQueueBase::notify()
+{
+    Mutex::lockMutex(mMutex);
+    mWakeups++;
+    Mutex::unlockMutex(mMutex);
+
+    Semaphore::releaseSemaphore(mItemSemaphore);
+}
+
+U32 BlockingQueueBase::size()
+{
+    Mutex::lockMutex(mMutex);
+    U32 count = mCount;
+    Mutex::unlockMutex(mMutex);
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+// Stress test and benchmark.
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    /// The old pattern: a ThreadSafeQueue paired with a semaphore, as
+    /// AtlasDeferredFile used to do it.
+    struct VectorQueueAdapter
+    {
+        ThreadSafeQueue<U32> mQueue;
+        void* mSemaphore;
+
+        VectorQueueAdapter(U32) { mSemaphore = Semaphore::createSemaphore(0); }
+        ~VectorQueueAdapter() { Semaphore::destroySemaphore(mSemaphore); }
+
+        void push(U32 item)
+        {
+            mQueue.queue(item);
+            Semaphore::releaseSemaphore(mSemaphore);
+        }
+
+        U32 pop()
+        {
+            U32 item = 0;
+            Semaphore::acquireSemaphore(mSemaphore, true);
+            mQueue.dequeue(item);
+            return item;
+        }
+    };
+
+    struct RingQueueAdapter
+    {
+        ThreadSafeRingQueue<U32> mQueue;
+
+        RingQueueAdapter(U32 capacity) : mQueue(capacity) {}
+
+        void push(U32 item) { mQueue.queue(item); }
+
+        U32 pop()
+        {
+            U32 item = 0;
+            mQueue.dequeue(item, true);
+            return item;
+        }
+    };
+
+    template<class Q>
+    struct QueueBenchState
+    {
+        Q* queue;
+        U32 itemsPerProducer;
+        U32 producerIndex;
+        U32 received;
+    };
+
+    template<class Q>
+    void benchProducer(void* arg)
+    {
+        QueueBenchState<Q>* state = (QueueBenchState<Q>*)arg;
+
+        // Items are never zero, zero tells the consumers to stop.
+        U32 base = state->producerIndex * state->itemsPerProducer;
+        for (U32 i = 1; i <= state->itemsPerProducer; i++)
+            state->queue->push(base + i);
+    }
+
+    template<class Q>
+    void benchConsumer(void* arg)
+    {
+        QueueBenchState<Q>* state = (QueueBenchState<Q>*)arg;
+        while (state->queue->pop())
+            state->received++;
+    }
+
+    /// Push items through a queue with the given number of producer and
+    /// consumer threads; returns elapsed ms.
+    template<class Q>
+    U32 runQueueBench(U32 producers, U32 consumers, U32 itemsPerProducer, U32 capacity, U32& received)
+    {
+        Q queue(capacity);
+        Vector<QueueBenchState<Q> > states;
+        Vector<Thread*> threads;
+        states.setSize(producers + consumers);
+
+        for (U32 i = 0; i < producers + consumers; i++)
+        {
+            states[i].queue = &queue;
+            states[i].itemsPerProducer = itemsPerProducer;
+            states[i].producerIndex = i;
+            states[i].received = 0;
+        }
+
+        U32 start = Platform::getRealMilliseconds();
+
+        for (U32 i = 0; i < consumers; i++)
+            threads.push_back(new Thread(benchConsumer<Q>, &states[producers + i]));
+        for (U32 i = 0; i < producers; i++)
+            threads.push_back(new Thread(benchProducer<Q>, &states[i]));
+
+        // Wait for the producers, then tell each consumer to quit.
+        for (S32 i = consumers; i < threads.size(); i++)
+            threads[i]->join();
+        for (U32 i = 0; i < consumers; i++)
+            queue.push(0);
+        for (U32 i = 0; i < consumers; i++)
+            threads[i]->join();
+
+        U32 elapsed = Platform::getRealMilliseconds() - start;
+
+        received = 0;
+        for (U32 i = 0; i < consumers; i++)
+            received += states[producers + i].received;
+
+        for (S32 i = 0; i < threads.size(); i++)
+            delete threads[i];
+
+        return elapsed;
+    }
+
+    /// Queue everything, then drain it, on one thread. This is where the
+    /// Vector's pop_front hurts.
+    template<class Q>
+    U32 runQueueBacklog(U32 items)
+    {
+        Q queue(items + 1);
+        U32 start = Platform::getRealMilliseconds();
+
+        for (U32 i = 1; i <= items; i++)
+            queue.push(i);
+        for (U32 i = 1; i <= items; i++)
+            queue.pop();
+
+        return Platform::getRealMilliseconds() - start;
+    }
+
+    //-------------------------------------------------------------------------
+
+    struct QueueStressState
+    {
+        ThreadSafeRingQueue<U32>* ring;
+        ThreadSafePriorityQueue<U32>* prio;
+        U8* seen;
+        U32 itemsPerProducer;
+        U32 producerIndex;
+        U32 producers;
+        U32 errors;
+    };
+
+    void stressProducer(void* arg)
+    {
+        QueueStressState* state = (QueueStressState*)arg;
+
+        U32 base = state->producerIndex * state->itemsPerProducer;
+        for (U32 i = 0; i < state->itemsPerProducer; i++)
+        {
+            // Mix in some non-blocking attempts so that path gets exercised.
+            if (!(i & 7) && state->ring->queue(base + i, false))
+                continue;
+            state->ring->queue(base + i);
+        }
+
+        for (U32 i = 0; i < state->itemsPerProducer; i++)
+            state->prio->queue(U32(Platform::getRandom() * 100000.f));
+    }
+
+    void stressConsumer(void* arg)
+    {
+        QueueStressState* state = (QueueStressState*)arg;
+
+        // Items from any one producer must come out in the order they went in.
+        Vector<S32> lastSeen;
+        lastSeen.setSize(state->producers);
+        for (U32 i = 0; i < state->producers; i++)
+            lastSeen[i] = -1;
+
+        U32 item;
+        while (state->ring->dequeue(item, true))
+        {
+            if (state->seen[item])
+                state->errors++;
+            state->seen[item] = 1;
+
+            U32 producer = item / state->itemsPerProducer;
+            S32 index = item % state->itemsPerProducer;
+            if (index <= lastSeen[producer])
+                state->errors++;
+            lastSeen[producer] = index;
+        }
+    }
+
+    int compareU32(const U32* a, const U32* b)
+    {
+        return *a < *b ? -1 : (*a > *b ? 1 : 0);
+    }
+}
+
+ConsoleFunction(testThreadSafeQueue, bool, 1, 4, "([producers, consumers, itemsPerProducer]) "
+    "Hammer ThreadSafeRingQueue and ThreadSafePriorityQueue from several threads "
+    "and check every item comes out exactly once and in order.")
+{
+    U32 producers = argc > 1 ? getMax(dAtoi(argv[1]), 1) : 4;
+    U32 consumers = argc > 2 ? getMax(dAtoi(argv[2]), 1) : 4;
+    U32 itemsPerProducer = argc > 3 ? getMax(dAtoi(argv[3]), 1) : 100000;
+    U32 total = producers * itemsPerProducer;
+
+    // Small enough that producers will regularly find it full.
+    ThreadSafeRingQueue<U32> ring(64);
+    ThreadSafePriorityQueue<U32> prio(compareU32, 64, true);
+
+    U8* seen = new U8[total];
+    dMemset(seen, 0, total);
+
+    Vector<QueueStressState> states;
+    Vector<Thread*> threads;
+    states.setSize(producers + consumers);
+    for (S32 i = 0; i < states.size(); i++)
+    {
+        states[i].ring = &ring;
+        states[i].prio = &prio;
+        states[i].seen = seen;
+        states[i].itemsPerProducer = itemsPerProducer;
+        states[i].producerIndex = i;
+        states[i].producers = producers;
+        states[i].errors = 0;
+    }
+
+    for (U32 i = 0; i < consumers; i++)
+        threads.push_back(new Thread(stressConsumer, &states[producers + i]));
+    for (U32 i = 0; i < producers; i++)
+        threads.push_back(new Thread(stressProducer, &states[i]));
+
+    for (S32 i = consumers; i < threads.size(); i++)
+        threads[i]->join();
+    for (U32 i = 0; i < consumers; i++)
+        ring.notify();
+    for (U32 i = 0; i < consumers; i++)
+        threads[i]->join();
+
+    U32 errors = 0;
+    for (S32 i = 0; i < states.size(); i++)
+        errors += states[i].errors;
+
+    U32 missing = 0;
+    for (U32 i = 0; i < total; i++)
+        if (!seen[i])
+            missing++;
+
+    if (ring.size())
+        errors++;
+
+    // The priority queue was filled concurrently; it has to drain sorted.
+    U32 prioCount = 0, prev = 0, item;
+    while (prio.dequeue(item))
+    {
+        if (item < prev)
+            errors++;
+        prev = item;
+        prioCount++;
+    }
+    if (prioCount != total)
+        errors++;
+
+    for (S32 i = 0; i < threads.size(); i++)
+        delete threads[i];
+    delete[] seen;
+
+    Con::printf("testThreadSafeQueue - %d producers, %d consumers, %d items: %d errors, %d missing",
+        producers, consumers, total, errors, missing);
+
+    return errors == 0 && missing == 0;
+}
+
+ConsoleFunction(benchThreadSafeQueue, void, 1, 4, "([producers, consumers, itemsPerProducer]) "
+    "Compare ThreadSafeRingQueue throughput against the Vector backed ThreadSafeQueue.")
+{
+    U32 producers = argc > 1 ? getMax(dAtoi(argv[1]), 1) : 2;
+    U32 consumers = argc > 2 ? getMax(dAtoi(argv[2]), 1) : 2;
+    U32 itemsPerProducer = argc > 3 ? getMax(dAtoi(argv[3]), 1) : 200000;
+    U32 total = producers * itemsPerProducer;
+
+    Con::printf("benchThreadSafeQueue - %d producers, %d consumers, %d items", producers, consumers, total);
+
+    U32 received;
+    U32 vecTime = runQueueBench<VectorQueueAdapter>(producers, consumers, itemsPerProducer, 0, received);
+    Con::printf("   Vector queue : %6d ms, %d items/ms (%d received)", vecTime, total / getMax(vecTime, U32(1)), received);
+
+    U32 ringTime = runQueueBench<RingQueueAdapter>(producers, consumers, itemsPerProducer, 256, received);
+    Con::printf("   Ring queue   : %6d ms, %d items/ms (%d received)", ringTime, total / getMax(ringTime, U32(1)), received);
+
+    // A deep backlog; kept smaller since the Vector version is quadratic.
+    U32 backlog = getMin(total, U32(50000));
+    vecTime = runQueueBacklog<VectorQueueAdapter>(backlog);
+    ringTime = runQueueBacklog<RingQueueAdapter>(backlog);
+    Con::printf("   %d deep backlog: Vector %d ms, Ring %d ms", backlog, vecTime, ringTime);
+}
@@ -8,6 +8,7 @@
 
 #include "platform/platform.h"
 #include "platform/platformMutex.h"
+#include "platform/platformSemaphore.h"
 #include "core/tVector.h"
 
 /// A simple thread-safe queue.
@@ -109,4 +110,235 @@ public:
     }
 };
 
-#endif
\ No newline at end of file
+//-----------------------------------------------------------------------------
+
+/// Locking and blocking shared by the bounded queues below.
+///
+/// A mutex guards the contents, one counting semaphore tracks queued items
+/// (plus any pending wakeups) and, for bounded queues, a second tracks free
+/// slots. Consumers sleep on the item semaphore instead of polling, and
+/// producers on a full bounded queue sleep on the slot semaphore.
+///
+/// @ingroup AtlasCore
+class BlockingQueueBase
+{
+protected:
+    void* mMutex;
+    void* mItemSemaphore;
+    void* mSpaceSemaphore; ///< NULL if the queue grows instead of blocking.
+
+    U32 mCount;
+    U32 mCapacity;
+    U32 mWakeups;
+
+    BlockingQueueBase(U32 capacity, bool growable);
+    ~BlockingQueueBase();
+
+    /// Wait for a free slot (if bounded) and take the lock. Returns false,
+    /// without the lock, if block is false and the queue is full.
+    bool lockForQueue(bool block);
+
+    /// Release the lock after adding an item, and wake a consumer.
+    void unlockAfterQueue();
+
+    /// Wait for an item and take the lock. Returns false, without the lock,
+    /// if block is false and the queue is empty, or if the wait was ended by
+    /// notify().
+    bool lockForDequeue(bool block);
+
+    /// Release the lock after removing an item, and wake a producer.
+    void unlockAfterDequeue();
+
+public:
+    /// Wake one consumer blocked in dequeue() with nothing to return; it
+    /// gets false back. If nobody is waiting, the next dequeue() on an empty
+    /// queue returns false immediately. Used to shut down worker threads.
+    void notify();
+
+    /// Number of items currently queued.
+    U32 size();
+
+    /// Current capacity; bounded queues never exceed this.
+    U32 getCapacity() const { return mCapacity; }
+
+    /// Growable queues never block producers.
+    bool isGrowable() const { return mSpaceSemaphore == NULL; }
+};
+
+//-----------------------------------------------------------------------------
+
+/// Multi-producer, multi-consumer FIFO on a power of two ring buffer.
+///
+/// Unlike ThreadSafeQueue, removing from the front is O(1), and consumers
+/// can block until there is work rather than pairing the queue with their
+/// own semaphore. If constructed bounded, producers block (or fail, with
+/// block = false) when it is full. Growable queues double instead; use
+/// them when the producer is a thread that must never wait on the consumer.
+///
+/// @ingroup AtlasCore
+template<class T>
+class ThreadSafeRingQueue : public BlockingQueueBase
+{
+    T* mItems;
+    U32 mHead;
+
+    void grow()
+    {
+        T* items = new T[mCapacity * 2];
+        for (U32 i = 0; i < mCount; i++)
+            items[i] = mItems[(mHead + i) & (mCapacity - 1)];
+
+        delete[] mItems;
+        mItems = items;
+        mHead = 0;
+        mCapacity *= 2;
+    }
+
+public:
+    enum
+    {
+        DefaultCapacity = 256,
+    };
+
+    ThreadSafeRingQueue(U32 capacity = DefaultCapacity, bool growable = false)
+        : BlockingQueueBase(getNextPow2(capacity), growable)
+    {
+        mItems = new T[mCapacity];
+        mHead = 0;
+    }
+
+    ~ThreadSafeRingQueue()
+    {
+        delete[] mItems;
+    }
+
+    /// Add an item to the back of the queue. Returns false only if block is
+    /// false and a bounded queue is full.
+    bool queue(const T& data, bool block = true)
+    {
+        if (!lockForQueue(block))
+            return false;
+
+        if (mCount == mCapacity)
+            grow();
+
+        mItems[(mHead + mCount) & (mCapacity - 1)] = data;
+        unlockAfterQueue();
+        return true;
+    }
+
+    /// Remove the item at the front of the queue. If block is set, waits
+    /// for one to arrive.
+    bool dequeue(T& res, bool block = false)
+    {
+        if (!lockForDequeue(block))
+            return false;
+
+        res = mItems[mHead];
+        mHead = (mHead + 1) & (mCapacity - 1);
+        unlockAfterDequeue();
+        return true;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+/// Blocking queue which hands out the highest priority item first.
+///
+/// Ordering comes from a qsort-compatible compare function, as with
+/// ThreadSafeQueue::sort(); the item which would sort first is dequeued
+/// first. Items are kept in a binary heap, so queue and dequeue are
+/// O(log n) rather than a full sort whenever priorities change. Items of
+/// equal priority come out in no particular order.
+///
+/// @ingroup AtlasCore
+template<class T>
+class ThreadSafePriorityQueue : public BlockingQueueBase
+{
+public:
+    typedef int (*CompareFunc)(const T* a, const T* b);
+
+private:
+    Vector<T> mHeap;
+    CompareFunc mCompare;
+
+    bool before(U32 a, U32 b) const
+    {
+        return mCompare(&mHeap[a], &mHeap[b]) < 0;
+    }
+
+    void swap(U32 a, U32 b)
+    {
+        T tmp = mHeap[a];
+        mHeap[a] = mHeap[b];
+        mHeap[b] = tmp;
+    }
+
+public:
+    ThreadSafePriorityQueue(CompareFunc compare, U32 capacity = 256, bool growable = false)
+        : BlockingQueueBase(capacity, growable)
+    {
+        mCompare = compare;
+        mHeap.reserve(capacity);
+    }
+
+    /// Add an item. Returns false only if block is false and a bounded
+    /// queue is full.
+    bool queue(const T& data, bool block = true)
+    {
+        if (!lockForQueue(block))
+            return false;
+
+        mHeap.push_back(data);
+        if (U32(mHeap.size()) > mCapacity)
+            mCapacity = mHeap.size();
+
+        // Sift up.
+        U32 i = mHeap.size() - 1;
+        while (i && before(i, (i - 1) / 2))
+        {
+            swap(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+
+        unlockAfterQueue();
+        return true;
+    }
+
+    /// Remove the highest priority item. If block is set, waits for one to
+    /// arrive.
+    bool dequeue(T& res, bool block = false)
+    {
+        if (!lockForDequeue(block))
+            return false;
+
+        res = mHeap.first();
+        mHeap.first() = mHeap.last();
+        mHeap.pop_back();
+
+        // Sift down.
+        U32 count = mHeap.size();
+        U32 i = 0;
+        while (true)
+        {
+            U32 best = i;
+            U32 left = i * 2 + 1;
+            U32 right = left + 1;
+
+            if (left < count && before(left, best))
+                best = left;
+            if (right < count && before(right, best))
+                best = right;
+            if (best == i)
+                break;
+
+            swap(i, best);
+            i = best;
+        }
+
+        unlockAfterDequeue();
+        return true;
+    }
+};
+
+#endif
@@ -53,6 +53,12 @@ void AbstractPolyList::addBox(const Box3F& box)
     }
 }
 
+void AbstractPolyList::addPoints(const Point3F* points, U32 count, U32* ids)
+{
+    for (U32 i = 0; i < count; i++)
+        ids[i] = addPoint(points[i]);
+}
+
 bool AbstractPolyList::getMapping(MatrixF*, Box3F*)
 {
     // return list transform and bounds in list space...optional
@@ -140,6 +140,12 @@ public:
     /// an ID number for that point.
     virtual U32  addPoint(const Point3F& p) = 0;
 
+    /// Adds a run of points, writing the ID of each one to ids.  Meant for
+    /// callers that have already removed duplicates, so lists that keep
+    /// every point can take them in one go.  By default, just calls
+    /// addPoint for each.
+    virtual void addPoints(const Point3F* points, U32 count, U32* ids);
+
     /// Adds a plane to the poly list, and returns
     /// an ID number for that point.
     virtual U32  addPlane(const PlaneF& plane) = 0;
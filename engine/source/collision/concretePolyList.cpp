@@ -51,6 +51,23 @@ U32 ConcretePolyList::addPoint(const Point3F& p)
 }
 
 
+void ConcretePolyList::addPoints(const Point3F* points, U32 count, U32* ids)
+{
+    U32 base = mVertexList.size();
+    mVertexList.increment(count);
+
+    Point3F* v = mVertexList.address() + base;
+    for (U32 i = 0; i < count; i++, v++)
+    {
+        v->x = points[i].x * mScale.x;
+        v->y = points[i].y * mScale.y;
+        v->z = points[i].z * mScale.z;
+        mMatrix.mulP(*v);
+        ids[i] = base + i;
+    }
+}
+
+
 U32 ConcretePolyList::addPlane(const PlaneF& plane)
 {
     mPolyPlaneList.increment();
@@ -48,6 +48,7 @@ public:
 
     // Virtual methods
     U32  addPoint(const Point3F& p);
+    void addPoints(const Point3F* points, U32 count, U32* ids);
     U32  addPlane(const PlaneF& plane);
     void begin(U32 material, U32 surfaceKey);
     void plane(U32 v1, U32 v2, U32 v3);
@@ -1235,16 +1235,37 @@ TypeReq TTagExprNode::getPreferredType()
 
 //------------------------------------------------------------
 
+/// Numeric arguments are passed to calls without being formatted into strings.
+///
+/// A conditional is left as a string, since its branches may not agree on a type.
+static TypeReq getCallArgType(ExprNode* arg)
+{
+    TypeReq type = arg->getPreferredType();
+    if ((type == TypeReqUInt || type == TypeReqFloat) && !dynamic_cast<ConditionalExprNode*>(arg))
+        return type;
+    return TypeReqString;
+}
+
+static U32 getCallArgPushOp(TypeReq type)
+{
+    if (type == TypeReqUInt)
+        return OP_PUSH_UINT;
+    if (type == TypeReqFloat)
+        return OP_PUSH_FLT;
+    return OP_PUSH;
+}
+
 U32 FuncCallExprNode::precompile(TypeReq type)
 {
     // OP_PUSH_FRAME
-    // arg OP_PUSH arg OP_PUSH arg OP_PUSH
+    // arg OP_PUSH arg OP_PUSH_UINT arg OP_PUSH_FLT
     // eval all the args, then call the function.
 
     // OP_CALLFUNC
     // function
     // namespace
     // isDot
+    // lookup cache: namespace, entry, sequence
 
     U32 size = 0;
     if (type != TypeReqString)
@@ -1252,8 +1273,8 @@ U32 FuncCallExprNode::precompile(TypeReq type)
     precompileIdent(funcName);
     precompileIdent(nameSpace);
     for (ExprNode* walk = args; walk; walk = (ExprNode*)walk->getNext())
-        size += walk->precompile(TypeReqString) + 1;
-    return size + 5;
+        size += walk->precompile(getCallArgType(walk)) + 1;
+    return size + 8;
 }
 
 U32 FuncCallExprNode::compile(dsize_t* codeStream, U32 ip, TypeReq type)
@@ -1261,8 +1282,9 @@ U32 FuncCallExprNode::compile(dsize_t* codeStream, U32 ip, TypeReq type)
     codeStream[ip++] = OP_PUSH_FRAME;
     for (ExprNode* walk = args; walk; walk = (ExprNode*)walk->getNext())
     {
-        ip = walk->compile(codeStream, ip, TypeReqString);
-        codeStream[ip++] = OP_PUSH;
+        TypeReq argType = getCallArgType(walk);
+        ip = walk->compile(codeStream, ip, argType);
+        codeStream[ip++] = getCallArgPushOp(argType);
     }
     if (callType == MethodCall || callType == ParentCall)
         codeStream[ip++] = OP_CALLFUNC;
@@ -1274,6 +1296,9 @@ U32 FuncCallExprNode::compile(dsize_t* codeStream, U32 ip, TypeReq type)
     codeStream[ip] = STEtoU32(nameSpace, ip);
     ip++;
     codeStream[ip++] = callType;
+    codeStream[ip++] = 0;
+    codeStream[ip++] = 0;
+    codeStream[ip++] = 0;
     if (type != TypeReqString)
         codeStream[ip++] = conversionOp(TypeReqString, type);
     return ip;
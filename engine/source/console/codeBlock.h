@@ -121,9 +121,12 @@ public:
     /// -1 a new frame is created. If the index is out of range the
     /// top stack frame is used.
     /// @param packageName The code package name or null.
+    /// @param argValues Typed version of argv from the string stack, or null.
+    /// Integer arguments are bound to the function's locals without being
+    /// formatted.
     const char* exec(U32 offset, const char* fnName, Namespace* ns, U32 argc,
         const char** argv, bool noCalls, StringTableEntry packageName,
-        S32 setFrame = -1);
+        S32 setFrame = -1, ConsoleValue* argValues = NULL);
 };
 
 #endif
\ No newline at end of file
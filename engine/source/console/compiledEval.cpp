@@ -62,6 +62,56 @@ static const char* getNamespaceList(Namespace* ns)
 
 //------------------------------------------------------------
 
+/// Call sites carry an inline cache of their last lookup after their regular
+/// operands: the namespace it was done in, the entry it found, and the
+/// Namespace::mCacheSequence it is good for.  Anything that changes what a
+/// lookup would return bumps the sequence.
+enum CallSiteCache {
+    CallCacheNamespace,
+    CallCacheEntry,
+    CallCacheSequence,
+    CallSiteCacheSize
+};
+
+static U32 gCallCacheHits = 0;
+static U32 gCallCacheMisses = 0;
+
+/// Look up a function for a call site.  Pass the namespace to look in, or
+/// NULL and the namespace name for a plain function call.
+static inline Namespace::Entry* lookupCallSite(dsize_t* cache, Namespace* ns, StringTableEntry nsName, StringTableEntry fnName)
+{
+    // Plain function calls always resolve the same namespace name, so only the
+    // sequence has to match.
+    if (cache[CallCacheEntry] && cache[CallCacheSequence] == Namespace::mCacheSequence &&
+        (!ns || *((Namespace**)&cache[CallCacheNamespace]) == ns))
+    {
+        gCallCacheHits++;
+        return *((Namespace::Entry**)&cache[CallCacheEntry]);
+    }
+
+    gCallCacheMisses++;
+    if (!ns)
+        ns = Namespace::find(nsName);
+    Namespace::Entry* entry = ns->lookup(fnName);
+
+    cache[CallCacheNamespace] = *((dsize_t*)&ns);
+    cache[CallCacheEntry] = *((dsize_t*)&entry);
+    cache[CallCacheSequence] = Namespace::mCacheSequence;
+    return entry;
+}
+
+ConsoleFunction(getCallCacheStats, const char*, 1, 2, "([bool reset]) "
+    "Returns \"hits misses\" for the call site lookup caches, optionally resetting them.")
+{
+    char* ret = Con::getReturnBuffer(32);
+    dSprintf(ret, 32, "%d %d", gCallCacheHits, gCallCacheMisses);
+    if (argc > 1 && dAtob(argv[1]))
+        gCallCacheHits = gCallCacheMisses = 0;
+    return ret;
+}
+
+//------------------------------------------------------------
+
 F64 consoleStringToNumber(const char* str, StringTableEntry file, U32 line)
 {
     F64 val = dAtof(str);
@@ -206,7 +256,7 @@ void CodeBlock::getFunctionArgs(char buffer[1024], U32 ip)
     }
 }
 
-const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNamespace, U32 argc, const char** argv, bool noCalls, StringTableEntry packageName, S32 setFrame)
+const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNamespace, U32 argc, const char** argv, bool noCalls, StringTableEntry packageName, S32 setFrame, ConsoleValue* argValues)
 {
     static char traceBuffer[1024];
     U32 i;
@@ -245,7 +295,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
             }
             for (i = 0; i < argc; i++)
             {
-                dStrcat(traceBuffer, argv[i + 1]);
+                dStrcat(traceBuffer, argValues ? argValues[i + 1].getString() : argv[i + 1]);
                 if (i != argc - 1)
                     dStrcat(traceBuffer, ", ");
             }
@@ -258,7 +308,12 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
         {
             StringTableEntry var = U32toSTE(code[ip + i + 6]);
             gEvalState.setCurVarNameCreate(var);
-            gEvalState.setStringVariable(argv[i + 1]);
+            if (!argValues)
+                gEvalState.setStringVariable(argv[i + 1]);
+            else if (argValues[i + 1].type == ConsoleValue::TypeUInt)
+                gEvalState.setIntVariable(argValues[i + 1].ival);
+            else
+                gEvalState.setStringVariable(argValues[i + 1].getString());
         }
         ip = ip + fnArgc + 6;
         curFloatTable = functionFloats;
@@ -303,6 +358,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
 
     U32 callArgc;
     const char** callArgv;
+    ConsoleValue* callValues;
 
     static char curFieldArray[256];
 
@@ -924,22 +980,18 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
             fnName = U32toSTE(code[ip]);
 
             // Try to look it up.
-            ns = Namespace::find(fnNamespace);
-            nsEntry = ns->lookup(fnName);
+            nsEntry = lookupCallSite(&code[ip + 3], NULL, fnNamespace, fnName);
             if (!nsEntry)
             {
-                ip += 3;
+                ip += 3 + CallSiteCacheSize;
                 Con::warnf(ConsoleLogEntry::General,
                     "%s: Unable to find function %s%s%s",
-                    getFileLine(ip - 4), fnNamespace ? fnNamespace : "",
+                    getFileLine(ip - 7), fnNamespace ? fnNamespace : "",
                     fnNamespace ? "::" : "", fnName);
                 STR.getArgcArgv(fnName, &callArgc, &callArgv);
                 break;
             }
-            // Now, rewrite our code a bit (ie, avoid future lookups) and fall
-            // through to OP_CALLFUNC
-            code[ip + 1] = *((dsize_t*)&nsEntry);
-            code[ip - 1] = OP_CALLFUNC;
+            // fall through to OP_CALLFUNC
 
         case OP_CALLFUNC:
         {
@@ -953,27 +1005,31 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
             }
 
             U32 callType = code[ip + 2];
+            dsize_t* callCache = &code[ip + 3];
 
-            ip += 3;
-            STR.getArgcArgv(fnName, &callArgc, &callArgv);
+            ip += 3 + CallSiteCacheSize;
+            STR.getArgcArgv(fnName, &callArgc, &callArgv, &callValues);
 
             if (callType == FuncCallExprNode::FunctionCall) {
-                nsEntry = *((Namespace::Entry**)&code[ip - 2]);
+                // Already looked up by OP_CALLFUNC_RESOLVE.
                 ns = NULL;
             }
             else if (callType == FuncCallExprNode::MethodCall)
             {
                 saveObject = gEvalState.thisObject;
-                gEvalState.thisObject = Sim::findObject(callArgv[1]);
+                if (callValues[1].type == ConsoleValue::TypeUInt)
+                    gEvalState.thisObject = Sim::findObject(SimObjectId(callValues[1].ival));
+                else
+                    gEvalState.thisObject = Sim::findObject(callValues[1].getString());
                 if (!gEvalState.thisObject)
                 {
                     gEvalState.thisObject = 0;
-                    Con::warnf(ConsoleLogEntry::General, "%s: Unable to find object: '%s' attempting to call function '%s'", getFileLine(ip - 4), callArgv[1], fnName);
+                    Con::warnf(ConsoleLogEntry::General, "%s: Unable to find object: '%s' attempting to call function '%s'", getFileLine(ip - 7), callValues[1].getString(), fnName);
                     break;
                 }
                 ns = gEvalState.thisObject->getNamespace();
                 if (ns)
-                    nsEntry = ns->lookup(fnName);
+                    nsEntry = lookupCallSite(callCache, ns, NULL, fnName);
                 else
                     nsEntry = NULL;
             }
@@ -983,7 +1039,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                 {
                     ns = thisNamespace->mParent;
                     if (ns)
-                        nsEntry = ns->lookup(fnName);
+                        nsEntry = lookupCallSite(callCache, ns, NULL, fnName);
                     else
                         nsEntry = NULL;
                 }
@@ -998,7 +1054,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
             {
                 if (!noCalls)
                 {
-                    Con::warnf(ConsoleLogEntry::General, "%s: Unknown command %s.", getFileLine(ip - 4), fnName);
+                    Con::warnf(ConsoleLogEntry::General, "%s: Unknown command %s.", getFileLine(ip - 7), fnName);
                     if (callType == FuncCallExprNode::MethodCall)
                     {
                         Con::warnf(ConsoleLogEntry::General, "  Object %s(%d) %s",
@@ -1012,7 +1068,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
             if (nsEntry->mType == Namespace::Entry::ScriptFunctionType)
             {
                 if (nsEntry->mFunctionOffset)
-                    nsEntry->mCode->exec(nsEntry->mFunctionOffset, fnName, nsEntry->mNamespace, callArgc, callArgv, false, nsEntry->mPackage);
+                    nsEntry->mCode->exec(nsEntry->mFunctionOffset, fnName, nsEntry->mNamespace, callArgc, callArgv, false, nsEntry->mPackage, -1, callValues);
                 else // no body
                     STR.setStringValue("");
             }
@@ -1021,16 +1077,27 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                 if ((nsEntry->mMinArgs && S32(callArgc) < nsEntry->mMinArgs) || (nsEntry->mMaxArgs && S32(callArgc) > nsEntry->mMaxArgs))
                 {
                     const char* nsName = ns ? ns->mName : "";
-                    Con::warnf(ConsoleLogEntry::Script, "%s: %s::%s - wrong number of arguments.", getFileLine(ip - 4), nsName, fnName);
-                    Con::warnf(ConsoleLogEntry::Script, "%s: usage: %s", getFileLine(ip - 4), nsEntry->mUsage);
+                    Con::warnf(ConsoleLogEntry::Script, "%s: %s::%s - wrong number of arguments.", getFileLine(ip - 7), nsName, fnName);
+                    Con::warnf(ConsoleLogEntry::Script, "%s: usage: %s", getFileLine(ip - 7), nsEntry->mUsage);
                 }
                 else
                 {
+                    // Functions that don't take typed arguments need every
+                    // argument as a string.
+                    bool typedCall = nsEntry->typedCb.mStringCallbackFunc != NULL;
+                    if (!typedCall)
+                    {
+                        for (U32 i = 1; i < callArgc; i++)
+                            callValues[i].getString();
+                    }
+
                     switch (nsEntry->mType)
                     {
                     case Namespace::Entry::StringCallbackType:
                     {
-                        const char* ret = nsEntry->cb.mStringCallbackFunc(gEvalState.thisObject, callArgc, callArgv);
+                        const char* ret = typedCall ?
+                            nsEntry->typedCb.mStringCallbackFunc(gEvalState.thisObject, callArgc, callValues) :
+                            nsEntry->cb.mStringCallbackFunc(gEvalState.thisObject, callArgc, callArgv);
                         if (ret != STR.getStringValue())
                             STR.setStringValue(ret);
                         else
@@ -1039,7 +1106,9 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                     }
                     case Namespace::Entry::IntCallbackType:
                     {
-                        S32 result = nsEntry->cb.mIntCallbackFunc(gEvalState.thisObject, callArgc, callArgv);
+                        S32 result = typedCall ?
+                            nsEntry->typedCb.mIntCallbackFunc(gEvalState.thisObject, callArgc, callValues) :
+                            nsEntry->cb.mIntCallbackFunc(gEvalState.thisObject, callArgc, callArgv);
                         if (code[ip] == OP_STR_TO_UINT)
                         {
                             ip++;
@@ -1060,7 +1129,9 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                     }
                     case Namespace::Entry::FloatCallbackType:
                     {
-                        F64 result = nsEntry->cb.mFloatCallbackFunc(gEvalState.thisObject, callArgc, callArgv);
+                        F64 result = typedCall ?
+                            nsEntry->typedCb.mFloatCallbackFunc(gEvalState.thisObject, callArgc, callValues) :
+                            nsEntry->cb.mFloatCallbackFunc(gEvalState.thisObject, callArgc, callArgv);
                         if (code[ip] == OP_STR_TO_UINT)
                         {
                             ip++;
@@ -1080,16 +1151,21 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                         break;
                     }
                     case Namespace::Entry::VoidCallbackType:
-                        nsEntry->cb.mVoidCallbackFunc(gEvalState.thisObject, callArgc, callArgv);
+                        if (typedCall)
+                            nsEntry->typedCb.mVoidCallbackFunc(gEvalState.thisObject, callArgc, callValues);
+                        else
+                            nsEntry->cb.mVoidCallbackFunc(gEvalState.thisObject, callArgc, callArgv);
 #ifdef CONSOLE_WARN_VOID_ASSIGNMENT
                         if (code[ip] != OP_STR_TO_NONE && Con::getBoolVariable("$Con::warnVoidAssignment", true))
-                            Con::warnf(ConsoleLogEntry::General, "%s: Call to %s in %s uses result of void function call.", getFileLine(ip - 4), fnName, functionName);
+                            Con::warnf(ConsoleLogEntry::General, "%s: Call to %s in %s uses result of void function call.", getFileLine(ip - 7), fnName, functionName);
 #endif
                         STR.setStringValue("");
                         break;
                     case Namespace::Entry::BoolCallbackType:
                     {
-                        bool result = nsEntry->cb.mBoolCallbackFunc(gEvalState.thisObject, callArgc, callArgv);
+                        bool result = typedCall ?
+                            nsEntry->typedCb.mBoolCallbackFunc(gEvalState.thisObject, callArgc, callValues) :
+                            nsEntry->cb.mBoolCallbackFunc(gEvalState.thisObject, callArgc, callArgv);
                         if (code[ip] == OP_STR_TO_UINT)
                         {
                             ip++;
@@ -1146,6 +1222,14 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
             STR.push();
             break;
 
+        case OP_PUSH_UINT:
+            STR.pushUInt(intStack[UINT--]);
+            break;
+
+        case OP_PUSH_FLT:
+            STR.pushFloat(floatStack[FLT--]);
+            break;
+
         case OP_PUSH_FRAME:
             STR.pushFrame();
             break;
@@ -118,6 +118,8 @@ namespace Compiler
         OP_COMPARE_STR,
 
         OP_PUSH,
+        OP_PUSH_UINT,
+        OP_PUSH_FLT,
         OP_PUSH_FRAME,
 
         OP_BREAK,
@@ -73,6 +73,7 @@ void ConsoleConstructor::init(const char* cName, const char* fName, const char*
     usage = usg;
     className = cName;
     sc = 0; fc = 0; vc = 0; bc = 0; ic = 0;
+    tsc = 0; tfc = 0; tvc = 0; tbc = 0; tic = 0;
     group = false;
     next = first;
     first = this;
@@ -83,15 +84,15 @@ void ConsoleConstructor::setup()
     for (ConsoleConstructor* walk = first; walk; walk = walk->next)
     {
         if (walk->sc)
-            Con::addCommand(walk->className, walk->funcName, walk->sc, walk->usage, walk->mina, walk->maxa);
+            Con::addCommand(walk->className, walk->funcName, walk->sc, walk->usage, walk->mina, walk->maxa, walk->tsc);
         else if (walk->ic)
-            Con::addCommand(walk->className, walk->funcName, walk->ic, walk->usage, walk->mina, walk->maxa);
+            Con::addCommand(walk->className, walk->funcName, walk->ic, walk->usage, walk->mina, walk->maxa, walk->tic);
         else if (walk->fc)
-            Con::addCommand(walk->className, walk->funcName, walk->fc, walk->usage, walk->mina, walk->maxa);
+            Con::addCommand(walk->className, walk->funcName, walk->fc, walk->usage, walk->mina, walk->maxa, walk->tfc);
         else if (walk->vc)
-            Con::addCommand(walk->className, walk->funcName, walk->vc, walk->usage, walk->mina, walk->maxa);
+            Con::addCommand(walk->className, walk->funcName, walk->vc, walk->usage, walk->mina, walk->maxa, walk->tvc);
         else if (walk->bc)
-            Con::addCommand(walk->className, walk->funcName, walk->bc, walk->usage, walk->mina, walk->maxa);
+            Con::addCommand(walk->className, walk->funcName, walk->bc, walk->usage, walk->mina, walk->maxa, walk->tbc);
         else if (walk->group)
             Con::markCommandGroup(walk->className, walk->funcName, walk->usage);
         else if (walk->overload)
@@ -131,6 +132,41 @@ ConsoleConstructor::ConsoleConstructor(const char* className, const char* funcNa
     bc = bfunc;
 }
 
+ConsoleConstructor::ConsoleConstructor(const char* className, const char* funcName, StringCallback sfunc, TypedStringCallback tsfunc, const char* usage, S32 minArgs, S32 maxArgs)
+{
+    init(className, funcName, usage, minArgs, maxArgs);
+    sc = sfunc;
+    tsc = tsfunc;
+}
+
+ConsoleConstructor::ConsoleConstructor(const char* className, const char* funcName, IntCallback ifunc, TypedIntCallback tifunc, const char* usage, S32 minArgs, S32 maxArgs)
+{
+    init(className, funcName, usage, minArgs, maxArgs);
+    ic = ifunc;
+    tic = tifunc;
+}
+
+ConsoleConstructor::ConsoleConstructor(const char* className, const char* funcName, FloatCallback ffunc, TypedFloatCallback tffunc, const char* usage, S32 minArgs, S32 maxArgs)
+{
+    init(className, funcName, usage, minArgs, maxArgs);
+    fc = ffunc;
+    tfc = tffunc;
+}
+
+ConsoleConstructor::ConsoleConstructor(const char* className, const char* funcName, VoidCallback vfunc, TypedVoidCallback tvfunc, const char* usage, S32 minArgs, S32 maxArgs)
+{
+    init(className, funcName, usage, minArgs, maxArgs);
+    vc = vfunc;
+    tvc = tvfunc;
+}
+
+ConsoleConstructor::ConsoleConstructor(const char* className, const char* funcName, BoolCallback bfunc, TypedBoolCallback tbfunc, const char* usage, S32 minArgs, S32 maxArgs)
+{
+    init(className, funcName, usage, minArgs, maxArgs);
+    bc = bfunc;
+    tbc = tbfunc;
+}
+
 ConsoleConstructor::ConsoleConstructor(const char* className, const char* groupName, const char* aUsage)
 {
     init(className, groupName, usage, -1, -2);
@@ -789,34 +825,34 @@ namespace Con
 
     //---------------------------------------------------------------------------
 
-    void addCommand(const char* nsName, const char* name, StringCallback cb, const char* usage, S32 minArgs, S32 maxArgs)
+    void addCommand(const char* nsName, const char* name, StringCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedStringCallback typedCb)
     {
         Namespace* ns = lookupNamespace(nsName);
-        ns->addCommand(StringTable->insert(name), cb, usage, minArgs, maxArgs);
+        ns->addCommand(StringTable->insert(name), cb, usage, minArgs, maxArgs, typedCb);
     }
 
-    void addCommand(const char* nsName, const char* name, VoidCallback cb, const char* usage, S32 minArgs, S32 maxArgs)
+    void addCommand(const char* nsName, const char* name, VoidCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedVoidCallback typedCb)
     {
         Namespace* ns = lookupNamespace(nsName);
-        ns->addCommand(StringTable->insert(name), cb, usage, minArgs, maxArgs);
+        ns->addCommand(StringTable->insert(name), cb, usage, minArgs, maxArgs, typedCb);
     }
 
-    void addCommand(const char* nsName, const char* name, IntCallback cb, const char* usage, S32 minArgs, S32 maxArgs)
+    void addCommand(const char* nsName, const char* name, IntCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedIntCallback typedCb)
     {
         Namespace* ns = lookupNamespace(nsName);
-        ns->addCommand(StringTable->insert(name), cb, usage, minArgs, maxArgs);
+        ns->addCommand(StringTable->insert(name), cb, usage, minArgs, maxArgs, typedCb);
     }
 
-    void addCommand(const char* nsName, const char* name, FloatCallback cb, const char* usage, S32 minArgs, S32 maxArgs)
+    void addCommand(const char* nsName, const char* name, FloatCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedFloatCallback typedCb)
     {
         Namespace* ns = lookupNamespace(nsName);
-        ns->addCommand(StringTable->insert(name), cb, usage, minArgs, maxArgs);
+        ns->addCommand(StringTable->insert(name), cb, usage, minArgs, maxArgs, typedCb);
     }
 
-    void addCommand(const char* nsName, const char* name, BoolCallback cb, const char* usage, S32 minArgs, S32 maxArgs)
+    void addCommand(const char* nsName, const char* name, BoolCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedBoolCallback typedCb)
     {
         Namespace* ns = lookupNamespace(nsName);
-        ns->addCommand(StringTable->insert(name), cb, usage, minArgs, maxArgs);
+        ns->addCommand(StringTable->insert(name), cb, usage, minArgs, maxArgs, typedCb);
     }
 
     void markCommandGroup(const char* nsName, const char* name, const char* usage)
@@ -140,6 +140,120 @@ typedef void           (*VoidCallback)(SimObject* obj, S32 argc, const char* arg
 typedef bool           (*BoolCallback)(SimObject* obj, S32 argc, const char* argv[]);
 
 typedef void (*ConsumerCallback)(ConsoleLogEntry::Level level, const char* consoleLine);
+
+/// An argument to a typed console function.
+///
+/// When script calls a function with a numeric argument, the interpreter passes
+/// the number along as is instead of formatting it into a string for the callee
+/// to parse back.  Space for the string form is still reserved on the string
+/// stack, and getString() fills it in on demand, so a typed function can treat
+/// any argument either way.
+///
+/// Functions called through Con::execute() and friends get plain strings.
+class ConsoleValue
+{
+public:
+    enum Type {
+        TypeString,
+        TypeUInt,
+        TypeFloat,
+    };
+
+    enum {
+        MaxArgs = 21,           ///< Largest argc a typed function can be called with.
+        NumberBufferSize = 32,  ///< Space a numeric argument has for its string form.
+    };
+
+    U32 type;
+    bool formatted;  ///< For numbers, whether sval holds the string form yet.
+    union {
+        U32 ival;
+        F64 fval;
+    };
+    char* sval;      ///< String value, or buffer for the string form of a number.
+
+    bool isNumber() const { return type != TypeString; }
+
+    // Float arguments are read as F32s.  formatFloat() writes them so that
+    // the string form reads back the same, so a typed function sees the same
+    // value when it is called through its string wrapper.
+
+    S32 getInt() const
+    {
+        if (type == TypeUInt)
+            return S32(ival);
+        if (type == TypeFloat)
+            return S32(F32(fval));
+        return dAtoi(sval);
+    }
+
+    F32 getFloat() const
+    {
+        if (type == TypeUInt)
+            return F32(S32(ival));
+        if (type == TypeFloat)
+            return F32(fval);
+        return dAtof(sval);
+    }
+
+    bool getBool() const
+    {
+        if (type == TypeUInt)
+            return ival != 0;
+        if (type == TypeFloat)
+            return F32(fval) != 0;
+        return dAtob(sval);
+    }
+
+    /// Get the argument as a string, formatting it the same way the
+    /// interpreter would have if it is a number.
+    const char* getString()
+    {
+        if (type != TypeString && !formatted)
+        {
+            if (type == TypeUInt)
+                dSprintf(sval, NumberBufferSize, "%d", ival);
+            else
+                formatFloat(sval, fval);
+            formatted = true;
+        }
+        return sval;
+    }
+
+    /// Format a float argument into a NumberBufferSize buffer.  Uses %g
+    /// when that reads back as the same F32, and more digits when it doesn't.
+    /// Whole numbers are written without an exponent so dAtoi() agrees.
+    static void formatFloat(char* buffer, F64 value);
+
+    /// Fill in values from string arguments.  Returns the argument count,
+    /// clamped to MaxArgs.
+    static S32 setStrings(ConsoleValue* values, S32 argc, const char** argv)
+    {
+        argc = getMin(argc, S32(MaxArgs));
+        for (S32 i = 0; i < argc; i++)
+        {
+            values[i].type = TypeString;
+            values[i].formatted = true;
+            values[i].sval = const_cast<char*>(argv[i]);
+        }
+        return argc;
+    }
+};
+
+/// @name Typed Callbacks
+///
+/// Versions of the callbacks above that get their arguments as ConsoleValues.
+/// They are registered alongside a string callback, which is what gets used
+/// when the call doesn't come straight from compiled script.
+///
+/// @see ConsoleFunctionTyped, ConsoleMethodTyped
+/// @{
+typedef const char* (*TypedStringCallback)(SimObject* obj, S32 argc, ConsoleValue argv[]);
+typedef S32         (*TypedIntCallback)(SimObject* obj, S32 argc, ConsoleValue argv[]);
+typedef F32         (*TypedFloatCallback)(SimObject* obj, S32 argc, ConsoleValue argv[]);
+typedef void        (*TypedVoidCallback)(SimObject* obj, S32 argc, ConsoleValue argv[]);
+typedef bool        (*TypedBoolCallback)(SimObject* obj, S32 argc, ConsoleValue argv[]);
+/// @}
 /// @}
 
 /// @defgroup console_types Scripting Engine Type Functions
@@ -175,7 +289,9 @@ namespace Con
         /// 12/29/04 - BJG - 33->34 Removed some opcodes, part of namespace upgrade.
         /// 12/30/04 - BJG - 34->35 Reordered some things, further general shuffling.
         /// 11/03/05 - BJG - 35->36 Integrated new debugger code.
-        DSOVersion = 36,
+        ///          36->37 Added OP_PUSH_UINT and OP_PUSH_FLT for typed call arguments.
+        ///          37->38 Added a lookup cache to the call opcodes.
+        DSOVersion = 38,
 
         MaxLineLength = 512,  ///< Maximum length of a line of console input.
         MaxDataTypes = 256    ///< Maximum number of registered data types.
@@ -413,11 +529,12 @@ namespace Con
     /// @param usage     Documentation for this function. @ref console_autodoc
     /// @param minArgs   Minimum number of arguments this function accepts
     /// @param maxArgs   Maximum number of arguments this function accepts
-    void addCommand(const char* nameSpace, const char* name, StringCallback cb, const char* usage, S32 minArgs, S32 maxArgs);
-    void addCommand(const char* nameSpace, const char* name, IntCallback cb, const char* usage, S32 minArgs, S32 maxArgs); ///< @copydoc addCommand(const char*, const char *, StringCallback, const char *, S32, S32)
-    void addCommand(const char* nameSpace, const char* name, FloatCallback cb, const char* usage, S32 minArgs, S32 maxArgs); ///< @copydoc addCommand(const char*, const char *, StringCallback, const char *, S32, S32)
-    void addCommand(const char* nameSpace, const char* name, VoidCallback cb, const char* usage, S32 minArgs, S32 maxArgs); ///< @copydoc addCommand(const char*, const char *, StringCallback, const char *, S32, S32)
-    void addCommand(const char* nameSpace, const char* name, BoolCallback cb, const char* usage, S32 minArgs, S32 maxArgs); ///< @copydoc addCommand(const char*, const char *, StringCallback, const char *, S32, S32)
+    /// @param typedCb   Optional version of cb taking typed arguments, used for calls from compiled script.
+    void addCommand(const char* nameSpace, const char* name, StringCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedStringCallback typedCb = NULL);
+    void addCommand(const char* nameSpace, const char* name, IntCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedIntCallback typedCb = NULL); ///< @copydoc addCommand(const char*, const char *, StringCallback, const char *, S32, S32)
+    void addCommand(const char* nameSpace, const char* name, FloatCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedFloatCallback typedCb = NULL); ///< @copydoc addCommand(const char*, const char *, StringCallback, const char *, S32, S32)
+    void addCommand(const char* nameSpace, const char* name, VoidCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedVoidCallback typedCb = NULL); ///< @copydoc addCommand(const char*, const char *, StringCallback, const char *, S32, S32)
+    void addCommand(const char* nameSpace, const char* name, BoolCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedBoolCallback typedCb = NULL); ///< @copydoc addCommand(const char*, const char *, StringCallback, const char *, S32, S32)
     /// @}
 
     /// @name Special Purpose Registration
@@ -612,6 +729,11 @@ public:
     FloatCallback fc;    ///< A function/method that returns a float.
     VoidCallback vc;     ///< A function/method that returns nothing.
     BoolCallback bc;     ///< A function/method that returns a bool.
+    TypedStringCallback tsc;  ///< Typed version of sc, if any.
+    TypedIntCallback tic;     ///< Typed version of ic, if any.
+    TypedFloatCallback tfc;   ///< Typed version of fc, if any.
+    TypedVoidCallback tvc;    ///< Typed version of vc, if any.
+    TypedBoolCallback tbc;    ///< Typed version of bc, if any.
     bool group;          ///< Indicates that this is a group marker.
     bool overload;       ///< Indicates that this is an overload marker.
                          ///  @deprecated Unused.
@@ -700,6 +822,19 @@ public:
     ConsoleConstructor(const char* className, const char* funcName, BoolCallback   bfunc, const char* usage, S32 minArgs, S32 maxArgs);
     /// @}
 
+    /// @name Typed Console Constructors
+    ///
+    /// Used by ConsoleFunctionTyped()/ConsoleMethodTyped(), which provide both a
+    /// string callback and the typed callback it wraps.
+    /// @{
+
+    ConsoleConstructor(const char* className, const char* funcName, StringCallback sfunc, TypedStringCallback tsfunc, const char* usage, S32 minArgs, S32 maxArgs);
+    ConsoleConstructor(const char* className, const char* funcName, IntCallback    ifunc, TypedIntCallback    tifunc, const char* usage, S32 minArgs, S32 maxArgs);
+    ConsoleConstructor(const char* className, const char* funcName, FloatCallback  ffunc, TypedFloatCallback  tffunc, const char* usage, S32 minArgs, S32 maxArgs);
+    ConsoleConstructor(const char* className, const char* funcName, VoidCallback   vfunc, TypedVoidCallback   tvfunc, const char* usage, S32 minArgs, S32 maxArgs);
+    ConsoleConstructor(const char* className, const char* funcName, BoolCallback   bfunc, TypedBoolCallback   tbfunc, const char* usage, S32 minArgs, S32 maxArgs);
+    /// @}
+
     /// @name Magic Console Constructors
     ///
     /// These perform various pieces of "magic" related to consoleDoc functionality.
@@ -806,6 +941,51 @@ public:
 
 #endif
 
+#if !defined(TORQUE_SHIPPING)
+#  define consoleTypedUsage(usage1) usage1
+#else
+#  define consoleTypedUsage(usage1) ""
+#endif
+
+/// Define a console function that takes its arguments as ConsoleValues.
+///
+/// Calls from compiled script pass numeric arguments straight through; any
+/// other caller goes through a string wrapper, so the function can be used
+/// anywhere a normal ConsoleFunction() can.
+///
+/// @code
+///      ConsoleFunctionTyped(mAdd, F32, 3, 3, "(float a, float b)")
+///      {
+///         return argv[1].getFloat() + argv[2].getFloat();
+///      }
+/// @endcode
+#define ConsoleFunctionTyped(name,returnType,minArgs,maxArgs,usage1)                               \
+      static returnType c##name##Typed(SimObject *, S32, ConsoleValue *argv);                     \
+      static returnType c##name(SimObject *object, S32 argc, const char **argv) {                 \
+         ConsoleValue values[ConsoleValue::MaxArgs];                                              \
+         argc = ConsoleValue::setStrings(values, argc, argv);                                     \
+         conmethod_return_##returnType ) c##name##Typed(object,argc,values);                      \
+      };                                                                                          \
+      static ConsoleConstructor g##name##obj(NULL,#name,c##name,c##name##Typed,consoleTypedUsage(usage1),minArgs,maxArgs); \
+      static returnType c##name##Typed(SimObject *, S32 argc, ConsoleValue *argv)
+
+/// Define a console method that takes its arguments as ConsoleValues.
+///
+/// @see ConsoleFunctionTyped
+#define ConsoleMethodTyped(className,name,returnType,minArgs,maxArgs,usage1)                       \
+      static inline returnType c##className##name(className *, S32, ConsoleValue *argv);          \
+      static returnType c##className##name##typedCaster(SimObject *object, S32 argc, ConsoleValue *argv) { \
+         AssertFatal( dynamic_cast<className*>( object ), "Object passed to " #name " is not a " #className "!" ); \
+         conmethod_return_##returnType ) c##className##name(static_cast<className*>(object),argc,argv); \
+      };                                                                                          \
+      static returnType c##className##name##caster(SimObject *object, S32 argc, const char **argv) { \
+         ConsoleValue values[ConsoleValue::MaxArgs];                                              \
+         argc = ConsoleValue::setStrings(values, argc, argv);                                     \
+         conmethod_return_##returnType ) c##className##name##typedCaster(object,argc,values);     \
+      };                                                                                          \
+      static ConsoleConstructor className##name##obj(#className,#name,c##className##name##caster,c##className##name##typedCaster,consoleTypedUsage(usage1),minArgs,maxArgs); \
+      static inline returnType c##className##name(className *object, S32 argc, ConsoleValue *argv)
+
 /// @}
 
 #endif
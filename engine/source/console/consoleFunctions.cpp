@@ -1591,3 +1591,40 @@ ConsoleFunction(isShippingBuild, bool, 1, 1, "Returns true if this is a shipping
     return false;
 #endif
 }
+
+//----------------------------------------------------------------
+
+ConsoleFunction(benchUntypedCall, F32, 3, 3, "(float a, float b) Used by scriptCallBenchmark().")
+{
+    return dAtof(argv[1]) + dAtof(argv[2]);
+}
+
+ConsoleFunctionTyped(benchTypedCall, F32, 3, 3, "(float a, float b) Used by scriptCallBenchmark().")
+{
+    return argv[1].getFloat() + argv[2].getFloat();
+}
+
+ConsoleFunction(scriptCallBenchmark, void, 1, 2, "([int iterations]) "
+    "Times calls from script into C++ with numeric arguments, through the string and the typed argument paths.")
+{
+    S32 iterations = argc > 1 ? dAtoi(argv[1]) : 100000;
+    if (iterations <= 0)
+        iterations = 100000;
+
+    static const char* functions[] = { "benchUntypedCall", "benchTypedCall" };
+
+    Con::printf("Script call benchmark, %d calls each:", iterations);
+    for (U32 i = 0; i < sizeof(functions) / sizeof(functions[0]); i++)
+    {
+        char script[256];
+        dSprintf(script, sizeof(script), "for (%%i = 0; %%i < %d; %%i++) %%r = %s(%%i * 0.5, %%i + 1);",
+            iterations, functions[i]);
+
+        U32 start = Platform::getRealMilliseconds();
+        Con::evaluate(script);
+        U32 elapsed = Platform::getRealMilliseconds() - start;
+
+        Con::printf("  %-18s %6d ms  %10.0f calls/sec", functions[i], elapsed,
+            elapsed ? iterations * 1000.0 / elapsed : 0.0);
+    }
+}
@@ -606,6 +606,7 @@ Namespace::Entry::Entry()
 {
     mCode = NULL;
     mType = InvalidFunctionType;
+    typedCb.mStringCallbackFunc = NULL;
 }
 
 void Namespace::Entry::clear()
@@ -615,6 +616,7 @@ void Namespace::Entry::clear()
         mCode->decRefCount();
         mCode = NULL;
     }
+    typedCb.mStringCallbackFunc = NULL;
 }
 
 Namespace::Namespace()
@@ -665,7 +667,12 @@ bool Namespace::classLinkTo(Namespace* parent)
         return false;
     }
     mRefCountToParent++;
-    walk->mParent = parent;
+    if (walk->mParent != parent)
+    {
+        // This changes what lookups through this namespace find.
+        walk->mParent = parent;
+        trashCache();
+    }
     return true;
 }
 
@@ -833,7 +840,7 @@ void Namespace::addFunction(StringTableEntry name, CodeBlock* cb, U32 functionOf
     ent->mType = Entry::ScriptFunctionType;
 }
 
-void Namespace::addCommand(StringTableEntry name, StringCallback cb, const char* usage, S32 minArgs, S32 maxArgs)
+void Namespace::addCommand(StringTableEntry name, StringCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedStringCallback typedCb)
 {
     Entry* ent = createLocalEntry(name);
     trashCache();
@@ -844,9 +851,10 @@ void Namespace::addCommand(StringTableEntry name, StringCallback cb, const char*
 
     ent->mType = Entry::StringCallbackType;
     ent->cb.mStringCallbackFunc = cb;
+    ent->typedCb.mStringCallbackFunc = typedCb;
 }
 
-void Namespace::addCommand(StringTableEntry name, IntCallback cb, const char* usage, S32 minArgs, S32 maxArgs)
+void Namespace::addCommand(StringTableEntry name, IntCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedIntCallback typedCb)
 {
     Entry* ent = createLocalEntry(name);
     trashCache();
@@ -857,9 +865,10 @@ void Namespace::addCommand(StringTableEntry name, IntCallback cb, const char* us
 
     ent->mType = Entry::IntCallbackType;
     ent->cb.mIntCallbackFunc = cb;
+    ent->typedCb.mIntCallbackFunc = typedCb;
 }
 
-void Namespace::addCommand(StringTableEntry name, VoidCallback cb, const char* usage, S32 minArgs, S32 maxArgs)
+void Namespace::addCommand(StringTableEntry name, VoidCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedVoidCallback typedCb)
 {
     Entry* ent = createLocalEntry(name);
     trashCache();
@@ -870,9 +879,10 @@ void Namespace::addCommand(StringTableEntry name, VoidCallback cb, const char* u
 
     ent->mType = Entry::VoidCallbackType;
     ent->cb.mVoidCallbackFunc = cb;
+    ent->typedCb.mVoidCallbackFunc = typedCb;
 }
 
-void Namespace::addCommand(StringTableEntry name, FloatCallback cb, const char* usage, S32 minArgs, S32 maxArgs)
+void Namespace::addCommand(StringTableEntry name, FloatCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedFloatCallback typedCb)
 {
     Entry* ent = createLocalEntry(name);
     trashCache();
@@ -883,9 +893,10 @@ void Namespace::addCommand(StringTableEntry name, FloatCallback cb, const char*
 
     ent->mType = Entry::FloatCallbackType;
     ent->cb.mFloatCallbackFunc = cb;
+    ent->typedCb.mFloatCallbackFunc = typedCb;
 }
 
-void Namespace::addCommand(StringTableEntry name, BoolCallback cb, const char* usage, S32 minArgs, S32 maxArgs)
+void Namespace::addCommand(StringTableEntry name, BoolCallback cb, const char* usage, S32 minArgs, S32 maxArgs, TypedBoolCallback typedCb)
 {
     Entry* ent = createLocalEntry(name);
     trashCache();
@@ -896,6 +907,7 @@ void Namespace::addCommand(StringTableEntry name, BoolCallback cb, const char* u
 
     ent->mType = Entry::BoolCallbackType;
     ent->cb.mBoolCallbackFunc = cb;
+    ent->typedCb.mBoolCallbackFunc = typedCb;
 }
 
 void Namespace::addOverload(const char* name, const char* altUsage)
@@ -72,6 +72,16 @@ public:
             BoolCallback mBoolCallbackFunc;
             const char* mGroupName;
         } cb;
+
+        /// Typed version of the callback, or NULL.  It returns the same type
+        /// as cb, and is what the interpreter calls when it has one.
+        union {
+            TypedStringCallback mStringCallbackFunc;
+            TypedIntCallback mIntCallbackFunc;
+            TypedVoidCallback mVoidCallbackFunc;
+            TypedFloatCallback mFloatCallbackFunc;
+            TypedBoolCallback mBoolCallbackFunc;
+        } typedCb;
         Entry();
         void clear();
 
@@ -87,11 +97,11 @@ public:
 
     Namespace();
     void addFunction(StringTableEntry name, CodeBlock* cb, U32 functionOffset);
-    void addCommand(StringTableEntry name, StringCallback, const char* usage, S32 minArgs, S32 maxArgs);
-    void addCommand(StringTableEntry name, IntCallback, const char* usage, S32 minArgs, S32 maxArgs);
-    void addCommand(StringTableEntry name, FloatCallback, const char* usage, S32 minArgs, S32 maxArgs);
-    void addCommand(StringTableEntry name, VoidCallback, const char* usage, S32 minArgs, S32 maxArgs);
-    void addCommand(StringTableEntry name, BoolCallback, const char* usage, S32 minArgs, S32 maxArgs);
+    void addCommand(StringTableEntry name, StringCallback, const char* usage, S32 minArgs, S32 maxArgs, TypedStringCallback typedCb = NULL);
+    void addCommand(StringTableEntry name, IntCallback, const char* usage, S32 minArgs, S32 maxArgs, TypedIntCallback typedCb = NULL);
+    void addCommand(StringTableEntry name, FloatCallback, const char* usage, S32 minArgs, S32 maxArgs, TypedFloatCallback typedCb = NULL);
+    void addCommand(StringTableEntry name, VoidCallback, const char* usage, S32 minArgs, S32 maxArgs, TypedVoidCallback typedCb = NULL);
+    void addCommand(StringTableEntry name, BoolCallback, const char* usage, S32 minArgs, S32 maxArgs, TypedBoolCallback typedCb = NULL);
 
     void addOverload(const char* name, const char* altUsage);
 
@@ -4,6 +4,41 @@
 //-----------------------------------------------------------------------------
 
 #include "console/stringStack.h"
+#include "math/mMathFn.h"
+
+void ConsoleValue::formatFloat(char* buffer, F64 value)
+{
+    F32 f = F32(value);
+    if (f > -2147483648.0f && f < 2147483648.0f && F32(S32(f)) == f)
+    {
+        dSprintf(buffer, NumberBufferSize, "%d", S32(f));
+        return;
+    }
+
+    // Nine significant digits always read back as the same F32.
+    for (S32 precision = 6; precision <= 9; precision++)
+    {
+        dSprintf(buffer, NumberBufferSize, "%.*g", precision, f);
+        if (dAtof(buffer) == f)
+            break;
+    }
+
+    // Below 1e-4 %g uses an exponent, which dAtoi() would read as the
+    // leading digit.  Write those out in full while they fit.
+    if (mFabs(f) < 1.0f && dStrchr(buffer, 'e') != NULL)
+    {
+        char fixed[NumberBufferSize];
+        for (S32 decimals = 5; decimals < NumberBufferSize - 3; decimals++)
+        {
+            dSprintf(fixed, sizeof(fixed), "%.*f", decimals, f);
+            if (dAtof(fixed) == f)
+            {
+                dStrcpy(buffer, fixed);
+                return;
+            }
+        }
+    }
+}
 
 void StringStack::getArgcArgv(StringTableEntry name, U32* argc, const char*** in_argv)
 {
@@ -14,7 +49,48 @@ void StringStack::getArgcArgv(StringTableEntry name, U32* argc, const char*** in
     mArgV[0] = name;
 
     for (U32 i = 0; i < argCount; i++)
-        mArgV[i + 1] = mBuffer + mStartOffsets[startStack + i];
+    {
+        U32 slot = startStack + i;
+        char* arg = mBuffer + mStartOffsets[slot];
+        if (mStartTypes[slot] == ConsoleValue::TypeUInt)
+            dSprintf(arg, ConsoleValue::NumberBufferSize, "%d", mStartInts[slot]);
+        else if (mStartTypes[slot] == ConsoleValue::TypeFloat)
+            ConsoleValue::formatFloat(arg, mStartFloats[slot]);
+        mArgV[i + 1] = arg;
+    }
+    argCount++;
+
+    mStartStackSize = startStack - 1;
+    *argc = argCount;
+
+    mStart = mStartOffsets[mStartStackSize];
+    mLen = 0;
+}
+void StringStack::getArgcArgv(StringTableEntry name, U32* argc, const char*** in_argv, ConsoleValue** in_values)
+{
+    U32 startStack = mFrameOffsets[--mNumFrames] + 1;
+    U32 argCount = getMin(mStartStackSize - startStack, (U32)MaxArgs - 1);
+
+    *in_argv = mArgV;
+    *in_values = mArgValues;
+    mArgV[0] = name;
+    mArgValues[0].type = ConsoleValue::TypeString;
+    mArgValues[0].formatted = true;
+    mArgValues[0].sval = const_cast<char*>(name);
+
+    for (U32 i = 0; i < argCount; i++)
+    {
+        U32 slot = startStack + i;
+        ConsoleValue& value = mArgValues[i + 1];
+        value.type = mStartTypes[slot];
+        value.formatted = false;
+        value.sval = mBuffer + mStartOffsets[slot];
+        if (value.type == ConsoleValue::TypeUInt)
+            value.ival = mStartInts[slot];
+        else if (value.type == ConsoleValue::TypeFloat)
+            value.fval = mStartFloats[slot];
+        mArgV[i + 1] = value.sval;
+    }
     argCount++;
 
     mStartStackSize = startStack - 1;
@@ -22,4 +98,4 @@ void StringStack::getArgcArgv(StringTableEntry name, U32* argc, const char*** in
 
     mStart = mStartOffsets[mStartStackSize];
     mLen = 0;
-}
\ No newline at end of file
+}
@@ -28,6 +28,17 @@ struct StringStack
     U32 mFrameOffsets[MaxStackDepth];
     U32 mStartOffsets[MaxStackDepth];
 
+    /// @name Typed Arguments
+    ///
+    /// Arguments pushed with pushUInt() or pushFloat() keep their value here,
+    /// indexed like mStartOffsets, and only reserve space for their string form.
+    /// @{
+    U8  mStartTypes[MaxStackDepth];
+    U32 mStartInts[MaxStackDepth];
+    F64 mStartFloats[MaxStackDepth];
+    ConsoleValue mArgValues[MaxArgs];
+    /// @}
+
     U32 mNumFrames;
     U32 mArgc;
 
@@ -190,9 +201,38 @@ struct StringStack
     /// Push the stack, placing a zero-length string on the top.
     void push()
     {
+        mStartTypes[mStartStackSize] = ConsoleValue::TypeString;
         advanceChar(0);
     }
 
+    /// Push an integer argument without formatting it.
+    void pushUInt(U32 i)
+    {
+        mStartTypes[mStartStackSize] = ConsoleValue::TypeUInt;
+        mStartInts[mStartStackSize] = i;
+        pushNumber();
+    }
+
+    /// Push a float argument without formatting it.
+    void pushFloat(F64 v)
+    {
+        mStartTypes[mStartStackSize] = ConsoleValue::TypeFloat;
+        mStartFloats[mStartStackSize] = v;
+        pushNumber();
+    }
+
+    /// Reserve room for the string form of a number on the top of the stack,
+    /// and push past it, placing a zero-length string on the top.
+    void pushNumber()
+    {
+        validateBufferSize(mStart + ConsoleValue::NumberBufferSize + 2);
+        mBuffer[mStart] = 0;
+        mStartOffsets[mStartStackSize++] = mStart;
+        mStart += ConsoleValue::NumberBufferSize;
+        mBuffer[mStart] = 0;
+        mLen = 0;
+    }
+
     inline void setLen(U32 newlen)
     {
         mLen = newlen;
@@ -242,6 +282,12 @@ struct StringStack
 
     /// Get the arguments for a function call from the stack.
     void getArgcArgv(StringTableEntry name, U32* argc, const char*** in_argv);
+
+    /// Get the arguments for a function call from the stack, as typed values.
+    ///
+    /// Numeric arguments are not formatted, so the strings in in_argv aren't
+    /// valid for them until ConsoleValue::getString() has been called.
+    void getArgcArgv(StringTableEntry name, U32* argc, const char*** in_argv, ConsoleValue** in_values);
 };
 
 #endif
\ No newline at end of file
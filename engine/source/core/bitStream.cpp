@@ -11,6 +11,9 @@
 #include "math/mathIO.h"
 #include "platform/event.h"
 #include "console/consoleObject.h"
+#include "math/mRandom.h"
+
+bool BitStream::smUseWordKernels = true;
 
 static BitStream gPacketStream(NULL, 0);
 static U8 gPacketBuffer[MaxPacketDataSize];
@@ -231,7 +234,7 @@ bool BitStream::testBit(S32 bitCount)
     return (*(dataPtr + (bitCount >> 3)) & (1 << (bitCount & 0x7))) != 0;
 }
 
-bool BitStream::writeFlag(bool val)
+bool BitStream::_writeFlag(bool val)
 {
     if (bitNum + 1 > maxWriteBitNum)
     {
@@ -289,24 +292,6 @@ bool BitStream::_write(U32 size, const void* dataPtr)
     return true;
 }
 
-S32 BitStream::readInt(S32 bitCount)
-{
-    S32 ret = 0;
-    readBits(bitCount, &ret);
-    ret = convertLEndianToHost(ret);
-    if (bitCount == 32)
-        return ret;
-    else
-        ret &= (1 << bitCount) - 1;
-    return ret;
-}
-
-void BitStream::writeInt(S32 val, S32 bitCount)
-{
-    val = convertHostToLEndian(val);
-    writeBits(bitCount, &val);
-}
-
 void BitStream::writeFloat(F32 f, S32 bitCount)
 {
     writeInt((S32)(f * ((1 << bitCount) - 1)), bitCount);
@@ -648,7 +633,8 @@ U32 BitStream::readCompressedPointRP(Point3F* p, U32 numDists, const F32* dists,
 
 InfiniteBitStream::InfiniteBitStream()
 {
-    //
+    // We grow in writeBits() and _writeFlag().
+    mInlineWrites = false;
 }
 
 InfiniteBitStream::~InfiniteBitStream()
@@ -1188,3 +1174,129 @@ const U32 HuffmanProcessor::csm_charFreqs[256] = {
 0
 };
 
+
+//------------------------------------------------------------------------------
+
+/// One object's worth of a typical ghost update.
+struct BenchGhost
+{
+    U32     index;
+    bool    moved;
+    Point3F pos;
+    Point3F vel;
+    Point3F normal;
+    F32     energy;
+    U32     damageState;
+    U32     skin;
+};
+
+static void benchWriteGhost(BitStream* stream, const BenchGhost& ghost)
+{
+    stream->writeRangedU32(ghost.index, 0, 1023);
+    if (stream->writeFlag(ghost.moved))
+    {
+        stream->writeCompressedPoint(ghost.pos);
+        stream->writeVector(ghost.vel, 0.01f, 100.0f, 10, 10, 8);
+        stream->writeNormalVector(ghost.normal, 8);
+    }
+    stream->writeFloat(ghost.energy, 7);
+    stream->writeInt(ghost.damageState, 2);
+    stream->writeCussedU32(ghost.skin);
+}
+
+static U32 benchReadGhost(BitStream* stream)
+{
+    U32 sum = stream->readRangedU32(0, 1023);
+    if (stream->readFlag())
+    {
+        Point3F pos, vel, normal;
+        stream->readCompressedPoint(&pos);
+        stream->readVector(&vel, 0.01f, 100.0f, 10, 10, 8);
+        stream->readNormalVector(&normal, 8);
+        sum = sum * 31 + S32(pos.x * 100.0f) + S32(pos.y * 100.0f) + S32(pos.z * 100.0f);
+        sum = sum * 31 + S32(vel.x * 100.0f) + S32(vel.y * 100.0f) + S32(vel.z * 100.0f);
+        sum = sum * 31 + S32(normal.x * 100.0f) + S32(normal.y * 100.0f) + S32(normal.z * 100.0f);
+    }
+    sum = sum * 31 + S32(stream->readFloat(7) * 100.0f);
+    sum = sum * 31 + stream->readInt(2);
+    sum = sum * 31 + stream->readCussedU32();
+    return sum;
+}
+
+ConsoleFunction(benchBitStream, void, 1, 3, "([ghosts=256], [iterations=2000]) Pack and unpack a ghost update "
+    "stream with and without the word kernels, check that both write the same bits, and report the time each takes.")
+{
+    U32 numGhosts = argc > 1 ? getMax(dAtoi(argv[1]), 1) : 256;
+    U32 iterations = argc > 2 ? getMax(dAtoi(argv[2]), 1) : 2000;
+
+    MRandomLCG rand(1);
+    Vector<BenchGhost> ghosts;
+    ghosts.setSize(numGhosts);
+    for (U32 i = 0; i < numGhosts; i++)
+    {
+        BenchGhost& ghost = ghosts[i];
+        ghost.index = i & 1023;
+        ghost.moved = rand.randI(0, 3) != 0;
+        ghost.pos.set(rand.randF(-500, 500), rand.randF(-500, 500), rand.randF(0, 100));
+        ghost.vel.set(rand.randF(-20, 20), rand.randF(-20, 20), rand.randF(-5, 5));
+        ghost.normal.set(rand.randF(-1, 1), rand.randF(-1, 1), rand.randF(0.1f, 1));
+        ghost.normal.normalize();
+        ghost.energy = rand.randF();
+        ghost.damageState = rand.randI(0, 3);
+        ghost.skin = rand.randI(0, 3) ? 0 : rand.randI(1, 70000);
+    }
+
+    // Plenty of room for the worst case ghost.
+    const U32 bufSize = numGhosts * 64;
+    Vector<U8> buffers[2];
+    U32 sums[2];
+    U32 bytes[2];
+
+    bool oldUseWordKernels = BitStream::smUseWordKernels;
+
+    Con::printf("benchBitStream - %d ghosts, %d iterations", numGhosts, iterations);
+
+    for (U32 pass = 0; pass < 2; pass++)
+    {
+        BitStream::smUseWordKernels = (pass == 1);
+
+        buffers[pass].setSize(bufSize);
+        dMemset(buffers[pass].address(), 0, bufSize);
+        BitStream stream(buffers[pass].address(), bufSize);
+
+        U32 start = Platform::getRealMilliseconds();
+        for (U32 iter = 0; iter < iterations; iter++)
+        {
+            stream.setPosition(0);
+            for (U32 i = 0; i < numGhosts; i++)
+                benchWriteGhost(&stream, ghosts[i]);
+        }
+        U32 writeMs = getMax(Platform::getRealMilliseconds() - start, U32(1));
+        bytes[pass] = stream.getPosition();
+
+        start = Platform::getRealMilliseconds();
+        U32 sum = 0;
+        for (U32 iter = 0; iter < iterations; iter++)
+        {
+            stream.setPosition(0);
+            for (U32 i = 0; i < numGhosts; i++)
+                sum = sum * 31 + benchReadGhost(&stream);
+        }
+        U32 readMs = getMax(Platform::getRealMilliseconds() - start, U32(1));
+        sums[pass] = sum;
+
+        const F64 mb = F64(bytes[pass]) * iterations / (1024.0 * 1024.0);
+        Con::printf("   %s: %d bytes, write %d ms (%.1f MB/s), read %d ms (%.1f MB/s)",
+            pass ? "Word " : "Bytes", bytes[pass], writeMs, mb * 1000.0 / writeMs, readMs, mb * 1000.0 / readMs);
+
+        if (!stream.isValid())
+            Con::errorf("benchBitStream - the stream overflowed!");
+    }
+
+    BitStream::smUseWordKernels = oldUseWordKernels;
+
+    if (bytes[0] != bytes[1] || dMemcmp(buffers[0].address(), buffers[1].address(), bytes[0]) || sums[0] != sums[1])
+        Con::errorf("benchBitStream - the word kernels don't match the byte path!");
+    else
+        Con::printf("   Both paths wrote and read the same bits.");
+}
@@ -42,8 +42,38 @@ protected:
     char* stringBuffer;
     Point3F mCompressPoint;
 
+    /// False for streams which have to see every write through writeBits()
+    /// and _writeFlag(), like InfiniteBitStream which grows as it goes.
+    bool mInlineWrites;
+
     friend class HuffmanProcessor;
+
+    /// @name Word Kernels
+    ///
+    /// writeInt() and readInt(), and so the ranged, signed and float
+    /// functions built on them, work on the 64 bit little endian word at
+    /// the current byte whenever the whole word is inside the buffer.  A
+    /// value then takes one load and store instead of a virtual call and a
+    /// byte loop.  The bits written are the same as writeBits() writes.
+    /// @{
+
+    static U64 _loadWord(const U8* ptr);
+    static void _storeWord(U8* ptr, U64 word);
+
+    bool _canWriteWord() const { return smUseWordKernels && mInlineWrites && (bitNum >> 3) + 8 <= (maxWriteBitNum >> 3); }
+    bool _canReadWord() const { return smUseWordKernels && (bitNum >> 3) + 8 <= (maxReadBitNum >> 3); }
+
+    /// @}
+
+    /// Writes a flag when writeFlag() can't do it inline.
+    virtual bool _writeFlag(bool val);
+
 public:
+    /// Set to false to pack everything through writeBits() and readBits()
+    /// as we used to, for comparing the two.
+    static bool smUseWordKernels;
+
+
     static BitStream* getPacketStream(U32 writeSize = 0);
     static void sendPacketStream(const NetAddress* addr);
 
@@ -56,7 +86,7 @@ public:
     S32  getCurPos() const;
     void setCurPos(const U32);
 
-    BitStream(void* bufPtr, S32 bufSize, S32 maxWriteSize = -1) { setBuffer(bufPtr, bufSize, maxWriteSize); stringBuffer = NULL; }
+    BitStream(void* bufPtr, S32 bufSize, S32 maxWriteSize = -1) { setBuffer(bufPtr, bufSize, maxWriteSize); stringBuffer = NULL; mInlineWrites = true; }
     void clear();
 
     void setStringBuffer(char buffer[256]);
@@ -157,8 +187,8 @@ public:
 
     virtual void writeBits(S32 bitCount, const void* bitPtr);
     virtual void readBits(S32 bitCount, void* bitPtr);
-    virtual bool writeFlag(bool val);
-    virtual bool readFlag();
+    bool writeFlag(bool val);
+    bool readFlag();
 
     void setBit(S32 bitCount, bool set);
     bool testBit(S32 bitCount);
@@ -217,12 +247,15 @@ public:
         BitStream::writeBits(bitCount, bitPtr);
     }
 
-    virtual bool writeFlag(bool val)
+protected:
+    virtual bool _writeFlag(bool val)
     {
         validate(1); // One bit will at most grow our buffer by a byte.
-        return BitStream::writeFlag(val);
+        return BitStream::_writeFlag(val);
     }
 
+public:
+
     const U32 getCRC()
     {
         // This could be kinda inefficient - BJG
@@ -244,6 +277,86 @@ inline void BitStream::setCurPos(const U32 in_position)
     bitNum = S32(in_position);
 }
 
+inline U64 BitStream::_loadWord(const U8* ptr)
+{
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+    // Unaligned loads are fine here.
+    return *(const U64*)ptr;
+#else
+    return U64(ptr[0]) | (U64(ptr[1]) << 8) | (U64(ptr[2]) << 16) | (U64(ptr[3]) << 24) |
+        (U64(ptr[4]) << 32) | (U64(ptr[5]) << 40) | (U64(ptr[6]) << 48) | (U64(ptr[7]) << 56);
+#endif
+}
+
+inline void BitStream::_storeWord(U8* ptr, U64 word)
+{
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+    *(U64*)ptr = word;
+#else
+    for (U32 i = 0; i < 8; i++, word >>= 8)
+        ptr[i] = U8(word);
+#endif
+}
+
+inline void BitStream::writeInt(S32 val, S32 bitCount)
+{
+    AssertFatal(bitCount >= 0 && bitCount <= 32, "BitStream::writeInt: Bad bit count!");
+
+    if (bitCount > 0 && _canWriteWord())
+    {
+        // Keep the bits before us in the first byte, and clear the rest
+        // of the last byte like writeBits() does.  Later bytes are left
+        // as they were.
+        U8* ptr = dataPtr + (bitNum >> 3);
+        const U32 shift = bitNum & 0x7;
+        const U32 end = (shift + bitCount + 7) & ~7;
+        const U64 keep = ((U64(1) << shift) - 1) | (~U64(0) << end);
+        const U64 bits = U64(U32(val) & (0xFFFFFFFF >> (32 - bitCount))) << shift;
+
+        _storeWord(ptr, (_loadWord(ptr) & keep) | bits);
+        bitNum += bitCount;
+        return;
+    }
+
+    val = convertHostToLEndian(val);
+    writeBits(bitCount, &val);
+}
+
+inline S32 BitStream::readInt(S32 bitCount)
+{
+    AssertFatal(bitCount >= 0 && bitCount <= 32, "BitStream::readInt: Bad bit count!");
+
+    if (bitCount > 0 && _canReadWord())
+    {
+        const U64 word = _loadWord(dataPtr + (bitNum >> 3));
+        const U32 ret = U32(word >> (bitNum & 0x7)) & (0xFFFFFFFF >> (32 - bitCount));
+        bitNum += bitCount;
+        return S32(ret);
+    }
+
+    S32 ret = 0;
+    readBits(bitCount, &ret);
+    ret = convertLEndianToHost(ret);
+    if (bitCount == 32)
+        return ret;
+    else
+        ret &= (1 << bitCount) - 1;
+    return ret;
+}
+
+inline bool BitStream::writeFlag(bool val)
+{
+    if (!smUseWordKernels || !mInlineWrites || bitNum + 1 > maxWriteBitNum)
+        return _writeFlag(val);
+
+    if (val)
+        *(dataPtr + (bitNum >> 3)) |= (1 << (bitNum & 0x7));
+    else
+        *(dataPtr + (bitNum >> 3)) &= ~(1 << (bitNum & 0x7));
+    bitNum++;
+    return (val);
+}
+
 inline bool BitStream::readFlag()
 {
     if (bitNum > maxReadBitNum)
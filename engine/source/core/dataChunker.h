@@ -132,4 +132,68 @@ public:
 };
 
 
+//----------------------------------------------------------------------------
+/// Free list allocator that holds on to its memory.
+///
+/// FreeListChunker releases its blocks as soon as everything is freed, which
+/// makes it thrash for things that are constantly allocated and freed in small
+/// numbers, like per-packet bookkeeping.  FreeListPool keeps its blocks until
+/// it is destroyed, and counts how it is used so the pool can be tuned.
+///
+/// The element size can be bigger than T, so one pool can serve a class and its
+/// subclasses.  As with the other chunkers no constructors or destructors are
+/// run; use placement new where that matters.
+template<class T>
+class FreeListPool : private DataChunker
+{
+    U32 mElementSize;
+    T* mFreeListHead;
+
+    U32 mInUse;        ///< Elements currently allocated
+    U32 mPeakInUse;    ///< Most elements ever allocated at once
+    U32 mCapacity;     ///< Elements carved out of blocks so far
+    U32 mAllocCount;   ///< Total calls to alloc()
+
+public:
+    FreeListPool(U32 elementSize = sizeof(T), S32 chunkSize = DataChunker::ChunkSize) : DataChunker(chunkSize)
+    {
+        // Keep elements pointer aligned, since the free list is threaded through them.
+        mElementSize = getMax(elementSize, U32(sizeof(T)));
+        mElementSize = (mElementSize + sizeof(void*) - 1) & ~U32(sizeof(void*) - 1);
+        mFreeListHead = NULL;
+        mInUse = mPeakInUse = mCapacity = mAllocCount = 0;
+    }
+
+    T* alloc()
+    {
+        mAllocCount++;
+        if (++mInUse > mPeakInUse)
+            mPeakInUse = mInUse;
+
+        if (mFreeListHead == NULL)
+        {
+            mCapacity++;
+            return reinterpret_cast<T*>(DataChunker::alloc(mElementSize));
+        }
+        T* ret = mFreeListHead;
+        mFreeListHead = *(reinterpret_cast<T**>(mFreeListHead));
+        return ret;
+    }
+
+    void free(T* elem)
+    {
+        AssertFatal(mInUse != 0, "FreeListPool::free - nothing allocated");
+        mInUse--;
+        *(reinterpret_cast<T**>(elem)) = mFreeListHead;
+        mFreeListHead = elem;
+    }
+
+    U32 getElementSize() const { return mElementSize; }
+    U32 getInUse() const { return mInUse; }
+    U32 getPeakInUse() const { return mPeakInUse; }
+    U32 getCapacity() const { return mCapacity; }
+    U32 getAllocCount() const { return mAllocCount; }
+};
+
+
 #endif
@@ -126,6 +126,18 @@ public:
     /// Returns whether or not this file is capable of the given function.
     bool hasCapability(Capability cap) const;
 
+    /// Maps part of a file opened for reading into memory, read only.
+    ///
+    /// The view stays valid after the file is closed, until it is passed to
+    /// unmap().  The offset doesn't need to be page aligned.
+    ///
+    /// @param  data  Set to the mapped copy of the byte at offset.
+    /// @returns A handle for unmap(), or NULL if the file can't be mapped.
+    void* map(U32 offset, U32 size, const U8** data);
+
+    /// Releases a view returned by map().
+    static void unmap(void* mapping);
+
 protected:
     Status setStatus();                 ///< Called after error encountered.
     Status setStatus(Status status);    ///< Setter for the current status.
@@ -44,7 +44,7 @@ public:
 };
 
 #if defined(TORQUE_DEBUG)
-static S32 sgMaxFrameAllocation = 0;
+static U32 sgMaxFrameAllocation = 0;
 #endif
 
 void FrameAllocator::init(const U32 frameSize)
@@ -0,0 +1,61 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "core/mappedStream.h"
+#include "core/fileio.h"
+
+//-----------------------------------------------------------------------------
+
+MappedStream::MappedStream(void* mapping, const U8* data, U32 size)
+    : Parent(size, (void*)data, true, false)
+{
+    mMapping = mapping;
+}
+
+MappedStream::~MappedStream()
+{
+    File::unmap(mMapping);
+    mMapping = NULL;
+}
+
+MappedStream* MappedStream::open(const char* fileName, U32 offset, U32 size)
+{
+    File file;
+    if (file.open(fileName, File::Read) != File::Ok)
+        return NULL;
+
+    if (size == 0)
+    {
+        U32 fileSize = file.getSize();
+        if (offset >= fileSize)
+            return NULL;
+        size = fileSize - offset;
+    }
+
+    return open(file, offset, size);
+}
+
+MappedStream* MappedStream::open(File& file, U32 offset, U32 size)
+{
+    const U8* data;
+    void* mapping = file.map(offset, size, &data);
+    if (!mapping)
+        return NULL;
+
+    return new MappedStream(mapping, data, size);
+}
+
+void MappedStream::touchPages() const
+{
+    // 4k is the smallest page size around, touching more often is harmless
+    const U8* data = getData();
+    U32 sum = 0;
+    for (U32 i = 0; i < cm_bufferSize; i += 4096)
+        sum += data[i];
+
+    // Keep the loop from being optimized out
+    volatile U32 sink = sum;
+    (void)sink;
+}
@@ -0,0 +1,55 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _MAPPEDSTREAM_H_
+#define _MAPPEDSTREAM_H_
+
+#ifndef _MEMSTREAM_H_
+#include "core/memstream.h"
+#endif
+
+class File;
+
+/// Read only stream over a memory mapped region of a file.
+///
+/// Reads come straight out of the mapping, so there's no intermediate buffer
+/// to copy through, and code that wants the whole thing can use getData()
+/// without reading at all.  The mapping is released when the stream is
+/// deleted.
+///
+/// @code
+///    MappedStream* stream = MappedStream::open("foo/bar.dts");
+///    if (!stream)
+///       ... fall back to a FileStream ...
+/// @endcode
+class MappedStream : public MemStream
+{
+    typedef MemStream Parent;
+
+    void* mMapping;
+
+    MappedStream(void* mapping, const U8* data, U32 size);
+
+public:
+    virtual ~MappedStream();
+
+    /// Maps size bytes of a file starting at offset.  A size of zero maps to
+    /// the end of the file.
+    ///
+    /// @returns NULL if the file couldn't be opened or mapped.
+    static MappedStream* open(const char* fileName, U32 offset = 0, U32 size = 0);
+
+    /// Maps size bytes of an open file starting at offset.  The file can be
+    /// closed once this returns.
+    static MappedStream* open(File& file, U32 offset, U32 size);
+
+    const U8* getData() const { return (const U8*)m_pBufferBase; }
+
+    /// Touches every page of the mapping so it's paged in now rather than on
+    /// first read.
+    void touchPages() const;
+};
+
+#endif // _MAPPEDSTREAM_H_
@@ -0,0 +1,516 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "core/resIndex.h"
+#include "core/fileio.h"
+#include "core/crc.h"
+#include "console/console.h"
+
+#if defined(TORQUE_OS_LINUX)
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+#include <time.h>
+#endif
+
+//------------------------------------------------------------------------------
+// File layout, all little endian:
+//
+//    U32 magic, version, payload size, payload crc
+//    payload:
+//       U32 string count, then each string as U16 length + characters
+//       U32 directory count, then each directory as
+//          path, modify time, pref modify time, file count, subdirectory count,
+//          files (name, size), subdirectories (name)
+//       U32 zip count, then each zip as
+//          path, name, modify time, size, entry count,
+//          entries (path, name, size, compressed size, offset)
+//
+// Strings are stored once and referred to by index, NoString standing for
+// NULL.  File times are stored as the platform's raw FileTime, since the
+// index is never moved between machines.
+
+namespace
+{
+    enum { NoString = 0xFFFFFFFF };
+
+    /// Payload being built by ResourceIndex::write().
+    class IndexWriter
+    {
+    public:
+        Vector<U8> mData;
+        Vector<StringTableEntry> mStrings;
+        HashTable<StringTableEntry, U32> mStringLookup;
+
+        void writeBytes(const void* data, U32 size)
+        {
+            U32 start = mData.size();
+            mData.setSize(start + size);
+            dMemcpy(mData.address() + start, data, size);
+        }
+        void writeU32(U32 value)
+        {
+            value = convertHostToLEndian(value);
+            writeBytes(&value, sizeof(value));
+        }
+        void writeTime(const FileTime& time)
+        {
+            writeBytes(&time, sizeof(time));
+        }
+
+        /// Strings are collected on a first pass, and written ahead of
+        /// everything that refers to them.
+        void addString(StringTableEntry string)
+        {
+            if (string && mStringLookup.find(string) == mStringLookup.end())
+            {
+                mStringLookup.insertUnique(string, mStrings.size());
+                mStrings.push_back(string);
+            }
+        }
+        void writeString(StringTableEntry string)
+        {
+            writeU32(string ? mStringLookup.find(string)->value : U32(NoString));
+        }
+    };
+
+    /// Cursor over a payload read by ResourceIndex::read().  Every read is
+    /// bounds checked, and stays failed once it has failed.
+    class IndexReader
+    {
+        const U8* mData;
+        U32 mSize;
+        U32 mPosition;
+        bool mFailed;
+
+    public:
+        Vector<StringTableEntry> mStrings;
+
+        IndexReader(const U8* data, U32 size)
+        {
+            mData = data;
+            mSize = size;
+            mPosition = 0;
+            mFailed = false;
+        }
+
+        bool isFailed() const { return mFailed; }
+
+        bool readBytes(void* data, U32 size)
+        {
+            if (mFailed || size > mSize - mPosition)
+            {
+                mFailed = true;
+                dMemset(data, 0, size);
+                return false;
+            }
+            dMemcpy(data, mData + mPosition, size);
+            mPosition += size;
+            return true;
+        }
+        U32 readU32()
+        {
+            U32 value;
+            readBytes(&value, sizeof(value));
+            return convertLEndianToHost(value);
+        }
+        void readTime(FileTime& time)
+        {
+            readBytes(&time, sizeof(time));
+        }
+        StringTableEntry readString()
+        {
+            U32 index = readU32();
+            if (index == NoString)
+                return NULL;
+            if (index >= U32(mStrings.size()))
+            {
+                mFailed = true;
+                return NULL;
+            }
+            return mStrings[index];
+        }
+
+        /// Each count is at least one byte per item, which keeps a damaged
+        /// count from turning into a huge allocation.
+        U32 readCount()
+        {
+            U32 count = readU32();
+            if (count > mSize - mPosition)
+            {
+                mFailed = true;
+                return 0;
+            }
+            return count;
+        }
+    };
+}
+
+//------------------------------------------------------------------------------
+
+ResourceIndex::ResourceIndex()
+{
+    dMemset(&mWriteTime, 0, sizeof(mWriteTime));
+}
+
+void ResourceIndex::clear()
+{
+    mDirectories.clear();
+    mFiles.clear();
+    mSubDirectories.clear();
+    mZips.clear();
+    mZipEntries.clear();
+    mDirectoryLookup.clear();
+    mZipLookup.clear();
+    dMemset(&mWriteTime, 0, sizeof(mWriteTime));
+}
+
+StringTableEntry ResourceIndex::getZipKey(StringTableEntry path, StringTableEntry name)
+{
+    if (!path)
+        return name;
+
+    char buf[1024];
+    dSprintf(buf, sizeof(buf), "%s/%s", path, name);
+    return StringTable->insert(buf);
+}
+
+//------------------------------------------------------------------------------
+
+const ResourceIndex::Directory* ResourceIndex::findDirectory(StringTableEntry path) const
+{
+    HashTable<StringTableEntry, U32>::ConstIterator itr = mDirectoryLookup.find(path);
+    return itr != mDirectoryLookup.end() ? &mDirectories[itr->value] : NULL;
+}
+
+const ResourceIndex::Zip* ResourceIndex::findZip(StringTableEntry path, StringTableEntry name) const
+{
+    HashTable<StringTableEntry, U32>::ConstIterator itr = mZipLookup.find(getZipKey(path, name));
+    return itr != mZipLookup.end() ? &mZips[itr->value] : NULL;
+}
+
+void ResourceIndex::addDirectory(StringTableEntry path, const FileTime& modifyTime, const FileTime& prefModifyTime)
+{
+    mDirectoryLookup.insertUnique(path, mDirectories.size());
+
+    mDirectories.increment();
+    Directory& dir = mDirectories.last();
+    dir.path = path;
+    dir.modifyTime = modifyTime;
+    dir.prefModifyTime = prefModifyTime;
+    dir.firstFile = mFiles.size();
+    dir.numFiles = 0;
+    dir.firstSubDirectory = mSubDirectories.size();
+    dir.numSubDirectories = 0;
+}
+
+void ResourceIndex::addZip(StringTableEntry path, StringTableEntry name, const FileTime& modifyTime, U32 size)
+{
+    mZipLookup.insertUnique(getZipKey(path, name), mZips.size());
+
+    mZips.increment();
+    Zip& zip = mZips.last();
+    zip.path = path;
+    zip.name = name;
+    zip.modifyTime = modifyTime;
+    zip.size = size;
+    zip.firstEntry = mZipEntries.size();
+    zip.numEntries = 0;
+}
+
+bool ResourceIndex::isCurrent(const FileTime& cachedTime, const FileTime& modifyTime) const
+{
+    return Platform::compareFileTimes(cachedTime, modifyTime) == 0 &&
+        Platform::compareFileTimes(modifyTime, mWriteTime) < 0;
+}
+
+bool ResourceIndex::isDirectoryCurrent(const Directory* dir, const FileTime& modifyTime, const FileTime& prefModifyTime) const
+{
+    return isCurrent(dir->modifyTime, modifyTime) && isCurrent(dir->prefModifyTime, prefModifyTime);
+}
+
+//------------------------------------------------------------------------------
+
+bool ResourceIndex::read(const char* fileName)
+{
+    clear();
+
+    File file;
+    if (file.open(fileName, File::Read) != File::Ok)
+        return false;
+
+    U32 header[4];
+    if (file.read(sizeof(header), (char*)header) != File::Ok ||
+        convertLEndianToHost(header[0]) != U32(FileMagic) ||
+        convertLEndianToHost(header[1]) != U32(FileVersion))
+        return false;
+
+    U32 payloadSize = convertLEndianToHost(header[2]);
+    if (payloadSize != file.getSize() - sizeof(header))
+        return false;
+
+    Vector<U8> payload;
+    payload.setSize(payloadSize);
+    if (file.read(payloadSize, (char*)payload.address()) != File::Ok ||
+        calculateCRC(payload.address(), payloadSize) != convertLEndianToHost(header[3]))
+        return false;
+    file.close();
+
+    IndexReader reader(payload.address(), payloadSize);
+
+    U32 numStrings = reader.readCount();
+    reader.mStrings.setSize(numStrings);
+    for (U32 i = 0; i < numStrings; i++)
+    {
+        U16 length;
+        char buf[1024];
+        reader.readBytes(&length, sizeof(length));
+        length = convertLEndianToHost(length);
+        if (length >= sizeof(buf) || !reader.readBytes(buf, length))
+        {
+            clear();
+            return false;
+        }
+        buf[length] = 0;
+        reader.mStrings[i] = StringTable->insert(buf);
+    }
+
+    U32 numDirectories = reader.readCount();
+    for (U32 i = 0; i < numDirectories && !reader.isFailed(); i++)
+    {
+        StringTableEntry path = reader.readString();
+        FileTime modifyTime, prefModifyTime;
+        reader.readTime(modifyTime);
+        reader.readTime(prefModifyTime);
+        addDirectory(path, modifyTime, prefModifyTime);
+
+        Directory& dir = mDirectories.last();
+        dir.numFiles = reader.readCount();
+        dir.numSubDirectories = reader.readCount();
+        for (U32 j = 0; j < dir.numFiles; j++)
+        {
+            mFiles.increment();
+            mFiles.last().name = reader.readString();
+            mFiles.last().size = reader.readU32();
+        }
+        for (U32 j = 0; j < dir.numSubDirectories; j++)
+            mSubDirectories.push_back(reader.readString());
+    }
+
+    U32 numZips = reader.readCount();
+    for (U32 i = 0; i < numZips && !reader.isFailed(); i++)
+    {
+        StringTableEntry path = reader.readString();
+        StringTableEntry name = reader.readString();
+        FileTime modifyTime;
+        reader.readTime(modifyTime);
+        U32 size = reader.readU32();
+        addZip(path, name, modifyTime, size);
+
+        Zip& zip = mZips.last();
+        zip.numEntries = reader.readCount();
+        for (U32 j = 0; j < zip.numEntries; j++)
+        {
+            mZipEntries.increment();
+            ZipEntry& entry = mZipEntries.last();
+            entry.path = reader.readString();
+            entry.name = reader.readString();
+            entry.fileSize = reader.readU32();
+            entry.compressedFileSize = reader.readU32();
+            entry.fileOffset = reader.readU32();
+        }
+    }
+
+    if (reader.isFailed())
+    {
+        clear();
+        return false;
+    }
+
+    // Anything changed since this was written isn't trusted, see isCurrent().
+    if (!Platform::getFileTimes(fileName, NULL, &mWriteTime))
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+bool ResourceIndex::write(const char* fileName)
+{
+    IndexWriter writer;
+
+    for (S32 i = 0; i < mDirectories.size(); i++)
+        writer.addString(mDirectories[i].path);
+    for (S32 i = 0; i < mFiles.size(); i++)
+        writer.addString(mFiles[i].name);
+    for (S32 i = 0; i < mSubDirectories.size(); i++)
+        writer.addString(mSubDirectories[i]);
+    for (S32 i = 0; i < mZips.size(); i++)
+    {
+        writer.addString(mZips[i].path);
+        writer.addString(mZips[i].name);
+    }
+    for (S32 i = 0; i < mZipEntries.size(); i++)
+    {
+        writer.addString(mZipEntries[i].path);
+        writer.addString(mZipEntries[i].name);
+    }
+
+    writer.writeU32(writer.mStrings.size());
+    for (S32 i = 0; i < writer.mStrings.size(); i++)
+    {
+        U16 length = dStrlen(writer.mStrings[i]);
+        U16 leLength = convertHostToLEndian(length);
+        writer.writeBytes(&leLength, sizeof(leLength));
+        writer.writeBytes(writer.mStrings[i], length);
+    }
+
+    writer.writeU32(mDirectories.size());
+    for (S32 i = 0; i < mDirectories.size(); i++)
+    {
+        const Directory& dir = mDirectories[i];
+        writer.writeString(dir.path);
+        writer.writeTime(dir.modifyTime);
+        writer.writeTime(dir.prefModifyTime);
+        writer.writeU32(dir.numFiles);
+        writer.writeU32(dir.numSubDirectories);
+        for (U32 j = 0; j < dir.numFiles; j++)
+        {
+            writer.writeString(mFiles[dir.firstFile + j].name);
+            writer.writeU32(mFiles[dir.firstFile + j].size);
+        }
+        for (U32 j = 0; j < dir.numSubDirectories; j++)
+            writer.writeString(mSubDirectories[dir.firstSubDirectory + j]);
+    }
+
+    writer.writeU32(mZips.size());
+    for (S32 i = 0; i < mZips.size(); i++)
+    {
+        const Zip& zip = mZips[i];
+        writer.writeString(zip.path);
+        writer.writeString(zip.name);
+        writer.writeTime(zip.modifyTime);
+        writer.writeU32(zip.size);
+        writer.writeU32(zip.numEntries);
+        for (U32 j = 0; j < zip.numEntries; j++)
+        {
+            const ZipEntry& entry = mZipEntries[zip.firstEntry + j];
+            writer.writeString(entry.path);
+            writer.writeString(entry.name);
+            writer.writeU32(entry.fileSize);
+            writer.writeU32(entry.compressedFileSize);
+            writer.writeU32(entry.fileOffset);
+        }
+    }
+
+    U32 header[4];
+    header[0] = convertHostToLEndian(U32(FileMagic));
+    header[1] = convertHostToLEndian(U32(FileVersion));
+    header[2] = convertHostToLEndian(U32(writer.mData.size()));
+    header[3] = convertHostToLEndian(calculateCRC(writer.mData.address(), writer.mData.size()));
+
+    File file;
+    if (file.open(fileName, File::Write) != File::Ok)
+    {
+        Con::warnf("ResourceIndex: unable to write '%s'", fileName);
+        return false;
+    }
+    bool ok = file.write(sizeof(header), (const char*)header) == File::Ok &&
+        file.write(writer.mData.size(), (const char*)writer.mData.address()) == File::Ok;
+    file.close();
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// Only Linux lists a relative directory from both the pref dir and the working
+// directory, see Platform::getDirectoryTimes().
+
+#if defined(TORQUE_OS_LINUX)
+
+static bool setDirectoryTime(const char* path, time_t time)
+{
+    struct utimbuf times;
+    times.actime = time;
+    times.modtime = time;
+    return utime(path, &times) == 0;
+}
+
+static bool writeEmptyFile(const char* path)
+{
+    File file;
+    if (file.open(path, File::Write) != File::Ok)
+        return false;
+    file.close();
+    return true;
+}
+
+ConsoleFunction(testResourceIndexRescan, bool, 1, 1, "testResourceIndexRescan()\n"
+    "Checks that adding a file to the install copy of a directory which is also "
+    "in the pref dir makes the resource index list it again.")
+{
+    StringTableEntry installRoot = Platform::getWorkingDirectory();
+    StringTableEntry prefRoot = Platform::getUserDataDirectory();
+    if (!dStrcmp(installRoot, prefRoot))
+    {
+        Con::printf("testResourceIndexRescan: the pref dir is the working directory, nothing to check");
+        return true;
+    }
+
+    const char* dirName = "resIndexRescanTest";
+    const char* indexFile = "resIndexRescanTest.idx";
+    StringTableEntry dirPath = StringTable->insert(dirName);
+
+    char installDir[1024], prefDir[1024], installFile[1024], prefFile[1024];
+    dSprintf(installDir, sizeof(installDir), "%s/%s", installRoot, dirName);
+    dSprintf(prefDir, sizeof(prefDir), "%s/%s", prefRoot, dirName);
+    dSprintf(installFile, sizeof(installFile), "%s/added.cs", installDir);
+    dSprintf(prefFile, sizeof(prefFile), "%s/written.dso", prefDir);
+
+    mkdir(installDir, 0755);
+    mkdir(prefDir, 0755);
+    bool ok = writeEmptyFile(prefFile);
+
+    // Date both copies back, rather than waiting for the clock to pass them:
+    // the index doesn't trust anything as new as itself.
+    time_t past = time(NULL) - 60;
+    ok = ok && setDirectoryTime(installDir, past) && setDirectoryTime(prefDir, past);
+
+    ResourceIndex index;
+    FileTime modifyTime, prefModifyTime;
+    ok = ok && Platform::getDirectoryTimes(dirName, &modifyTime, &prefModifyTime);
+    index.addDirectory(dirPath, modifyTime, prefModifyTime);
+    ok = ok && index.write(indexFile) && index.read(indexFile);
+
+    const ResourceIndex::Directory* dir = ok ? index.findDirectory(dirPath) : NULL;
+    bool cached = dir && index.isDirectoryCurrent(dir, modifyTime, prefModifyTime);
+
+    ok = ok && writeEmptyFile(installFile);
+    ok = ok && Platform::getDirectoryTimes(dirName, &modifyTime, &prefModifyTime);
+    bool rescanned = dir && Platform::compareFileTimes(dir->modifyTime, modifyTime) != 0 &&
+        !index.isDirectoryCurrent(dir, modifyTime, prefModifyTime);
+
+    unlink(installFile);
+    unlink(prefFile);
+    rmdir(installDir);
+    rmdir(prefDir);
+    dFileDelete(indexFile);
+
+    if (!ok)
+        Con::errorf("testResourceIndexRescan: unable to set up the test directories");
+    else if (!cached)
+        Con::errorf("testResourceIndexRescan: -FAIL the unchanged directory wasn't taken from the index");
+    else if (!rescanned)
+        Con::errorf("testResourceIndexRescan: -FAIL the install copy changed but the index was still used");
+    else
+        Con::printf("testResourceIndexRescan: +OK");
+
+    return ok && cached && rescanned;
+}
+
+#endif
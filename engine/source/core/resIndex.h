@@ -0,0 +1,132 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _RESINDEX_H_
+#define _RESINDEX_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/tVector.h"
+#endif
+#ifndef _STRINGTABLE_H_
+#include "core/stringTable.h"
+#endif
+#ifndef CORE_TDICTIONARY_H
+#include "core/tDictionary.h"
+#endif
+
+//------------------------------------------------------------------------------
+/// On-disk snapshot of what ResManager found under the mod paths.
+///
+/// Holds the file list of every directory that was searched, along with the
+/// directory's modify times (see Platform::getDirectoryTimes), and the entry list of every zip, along with the
+/// zip's size and modify time.  Adding, removing or renaming a file changes
+/// its directory's modify time, so a directory whose time still matches can
+/// be taken from the index instead of listed again.
+///
+/// The whole file is read in one go and checked against a CRC before any of
+/// it is trusted.
+///
+/// Resource CRCs aren't kept here.  Editing a file in place doesn't touch its
+/// directory's modify time, so nothing would tell a stale one apart; they are
+/// still worked out when the resource is loaded.
+///
+/// @see ResManager::setModPaths
+class ResourceIndex
+{
+public:
+    struct FileEntry
+    {
+        StringTableEntry name;
+        U32 size;
+    };
+
+    struct Directory
+    {
+        StringTableEntry path;
+        FileTime modifyTime;
+        FileTime prefModifyTime;
+        U32 firstFile;         ///< Into mFiles
+        U32 numFiles;
+        U32 firstSubDirectory; ///< Into mSubDirectories
+        U32 numSubDirectories;
+    };
+
+    struct ZipEntry
+    {
+        StringTableEntry path;
+        StringTableEntry name;
+        U32 fileSize;
+        U32 compressedFileSize;
+        U32 fileOffset;
+    };
+
+    struct Zip
+    {
+        StringTableEntry path;
+        StringTableEntry name;
+        FileTime modifyTime;
+        U32 size;
+        U32 firstEntry;        ///< Into mZipEntries
+        U32 numEntries;
+    };
+
+    Vector<Directory>        mDirectories;
+    Vector<FileEntry>        mFiles;
+    Vector<StringTableEntry> mSubDirectories;    ///< Names only, relative to their directory
+    Vector<Zip>              mZips;
+    Vector<ZipEntry>         mZipEntries;
+
+private:
+    enum
+    {
+        FileMagic = 0x58444952,  ///< "RIDX"
+        FileVersion = 2,
+    };
+
+    HashTable<StringTableEntry, U32> mDirectoryLookup;
+    HashTable<StringTableEntry, U32> mZipLookup;
+
+    FileTime mWriteTime;         ///< Modify time of the file this was read from
+
+    static StringTableEntry getZipKey(StringTableEntry path, StringTableEntry name);
+
+public:
+    ResourceIndex();
+
+    void clear();
+
+    /// Loads an index written by write().  Returns false, leaving the index
+    /// empty, if the file is missing, from another version or damaged.
+    bool read(const char* fileName);
+    bool write(const char* fileName);
+
+    const Directory* findDirectory(StringTableEntry path) const;
+    const Zip* findZip(StringTableEntry path, StringTableEntry name) const;
+
+    /// Starts a directory.  Its files and subdirectories are whatever is pushed
+    /// onto mFiles and mSubDirectories until the next one is added.
+    void addDirectory(StringTableEntry path, const FileTime& modifyTime, const FileTime& prefModifyTime);
+
+    /// Starts a zip.  Its entries are whatever is pushed onto mZipEntries until
+    /// the next one is added.
+    void addZip(StringTableEntry path, StringTableEntry name, const FileTime& modifyTime, U32 size);
+
+    /// Returns true if something last modified at modifyTime, and indexed
+    /// with cachedTime, can be taken from this index.
+    ///
+    /// File times are coarse (a second, on some platforms) so anything
+    /// touched as late as the index was written could have changed again
+    /// without its time moving, and isn't trusted.
+    bool isCurrent(const FileTime& cachedTime, const FileTime& modifyTime) const;
+
+    /// Returns true if dir's listing can be used for a directory with these
+    /// times from Platform::getDirectoryTimes().
+    bool isDirectoryCurrent(const Directory* dir, const FileTime& modifyTime, const FileTime& prefModifyTime) const;
+};
+
+#endif // _RESINDEX_H_
@@ -13,6 +13,9 @@
 #include "core/zipHeaders.h"
 #include "core/resizeStream.h"
 #include "core/frameAllocator.h"
+#include "core/memstream.h"
+#include "core/mappedStream.h"
+#include "core/resIndex.h"
 
 #include "core/resManager.h"
 #include "core/findMatch.h"
@@ -22,11 +25,19 @@
 
 #include "util/safeDelete.h"
 
+#include "platform/platformThread.h"
+#include "platform/platformMutex.h"
+#include "platform/platformSemaphore.h"
+#include "platform/profiler.h"
+
 ResManager* ResourceManager = NULL;
 
 bool gAllowExternalWrite = false;
 
 char* ResManager::smExcludedDirectories = ".svn;CVS";
+S32 ResManager::smPreloadThreads = 2;
+bool ResManager::smMapFiles = true;
+const char* ResManager::smIndexFile = "resources.idx";
 
 //------------------------------------------------------------------------------
 ResourceObject::ResourceObject()
@@ -35,6 +46,7 @@ ResourceObject::ResourceObject()
     prev = NULL;
     lockCount = 0;
     mInstance = NULL;
+    mPreload = NULL;
 }
 
 void ResourceObject::destruct()
@@ -62,6 +74,17 @@ ResManager::ResManager()
     timeoutList.prev = NULL;
     registeredList = NULL;
     mLoggingMissingFiles = false;
+
+    mPreloadMutex = Mutex::createMutex();
+    mPreloadWorkSemaphore = Semaphore::createSemaphore(0);
+    mPreloadDoneSemaphore = Semaphore::createSemaphore(0);
+    mPreloadExiting = false;
+    mNextPreloadId = 1;
+
+    mCachedIndex = NULL;
+    mNewIndex = NULL;
+    mDirectoriesCached = mDirectoriesScanned = 0;
+    mZipsCached = mZipsScanned = 0;
 }
 
 void ResManager::fileIsMissing(const char* fileName)
@@ -136,6 +159,15 @@ const char* ResourceObject::getFullPath()
 
 ResManager::~ResManager()
 {
+    // Give back anything still preloading before the locks are checked
+    while (mPreloads.size())
+        releasePreload(mPreloads.last());
+    stopPreloadThreads();
+
+    Semaphore::destroySemaphore(mPreloadDoneSemaphore);
+    Semaphore::destroySemaphore(mPreloadWorkSemaphore);
+    Mutex::destroyMutex(mPreloadMutex);
+
     purge();
     // volume list should be gone.
 
@@ -188,6 +220,9 @@ void ResManager::create()
     ResourceManager = new ResManager;
 
     Con::addVariable("Pref::ResourceManager::excludedDirectories", TypeString, &smExcludedDirectories);
+    Con::addVariable("Pref::ResourceManager::preloadThreads", TypeS32, &smPreloadThreads);
+    Con::addVariable("Pref::ResourceManager::mapFiles", TypeBool, &smMapFiles);
+    Con::addVariable("Pref::ResourceManager::indexFile", TypeString, &smIndexFile);
 }
 
 
@@ -292,35 +327,79 @@ void ResManager::getPaths(const char* fullPath, StringTableEntry& path,
 
 //------------------------------------------------------------------------------
 
+void ResManager::addZipEntry(ResourceObject* zipObject, StringTableEntry path, StringTableEntry file,
+    U32 fileSize, U32 compressedFileSize, U32 fileOffset)
+{
+    ResourceObject* ro = createZipResource(path, file, zipObject->zipPath, zipObject->zipName);
+
+    ro->flags = ResourceObject::VolumeBlock;
+    ro->fileSize = fileSize;
+    ro->compressedFileSize = compressedFileSize;
+    ro->fileOffset = fileOffset;
+
+    dictionary.pushBehind(ro, ResourceObject::File);
+
+    if (mNewIndex)
+    {
+        mNewIndex->mZipEntries.increment();
+        ResourceIndex::ZipEntry& entry = mNewIndex->mZipEntries.last();
+        entry.path = path;
+        entry.name = file;
+        entry.fileSize = fileSize;
+        entry.compressedFileSize = compressedFileSize;
+        entry.fileOffset = fileOffset;
+        mNewIndex->mZips.last().numEntries++;
+    }
+}
+
 bool ResManager::scanZip(ResourceObject* zipObject)
 {
+    char zipFile[1024];
+    dStrncpy(zipFile, buildPath(zipObject->zipPath, zipObject->zipName), sizeof(zipFile) - 1);
+    zipFile[sizeof(zipFile) - 1] = 0;
+
+    // Take the entries from the index if the zip hasn't been touched since
+    FileTime modifyTime;
+    bool haveTime = mNewIndex && Platform::getFileTimes(zipFile, NULL, &modifyTime);
+    if (haveTime && mCachedIndex)
+    {
+        const ResourceIndex::Zip* cached = mCachedIndex->findZip(zipObject->zipPath, zipObject->zipName);
+        if (cached && cached->size == U32(zipObject->fileSize) &&
+            mCachedIndex->isCurrent(cached->modifyTime, modifyTime))
+        {
+            mNewIndex->addZip(zipObject->zipPath, zipObject->zipName, modifyTime, zipObject->fileSize);
+            for (U32 i = 0; i < cached->numEntries; i++)
+            {
+                const ResourceIndex::ZipEntry& entry = mCachedIndex->mZipEntries[cached->firstEntry + i];
+                addZipEntry(zipObject, entry.path, entry.name,
+                    entry.fileSize, entry.compressedFileSize, entry.fileOffset);
+            }
+            mZipsCached++;
+            return true;
+        }
+    }
+
     // now open the volume and add all its resources to the dictionary
     ZipAggregate zipAggregate;
-    if (zipAggregate.
-        openAggregate(buildPath(zipObject->zipPath, zipObject->zipName)) ==
-        false)
+    if (zipAggregate.openAggregate(zipFile) == false)
     {
         Con::errorf("Error opening zip (%s/%s), need to handle this better...",
             zipObject->zipPath, zipObject->zipName);
         return false;
     }
+
+    if (haveTime)
+        mNewIndex->addZip(zipObject->zipPath, zipObject->zipName, modifyTime, zipObject->fileSize);
+
     ZipAggregate::iterator itr;
     for (itr = zipAggregate.begin(); itr != zipAggregate.end(); itr++)
     {
         const ZipAggregate::FileEntry& rEntry = *itr;
-        ResourceObject* ro =
-            createZipResource(rEntry.pPath, rEntry.pFileName,
-                zipObject->zipPath,
-                zipObject->zipName);
-
-        ro->flags = ResourceObject::VolumeBlock;
-        ro->fileSize = rEntry.fileSize;
-        ro->compressedFileSize = rEntry.compressedFileSize;
-        ro->fileOffset = rEntry.fileOffset;
-
-        dictionary.pushBehind(ro, ResourceObject::File);
+        addZipEntry(zipObject, rEntry.pPath, rEntry.pFileName,
+            rEntry.fileSize, rEntry.compressedFileSize, rEntry.fileOffset);
     }
     zipAggregate.closeAggregate();
+    mZipsScanned++;
 
     return true;
 }
@@ -331,33 +410,89 @@ void ResManager::searchPath(const char* path)
 {
     AssertFatal(path != NULL, "No path to dump?");
 
-    Vector < Platform::FileInfo > fileInfoVec;
-    Platform::dumpPath(path, fileInfoVec);
+    StringTableEntry dirPath = StringTable->insert(path);
+
+    // Take the listing from the index if nothing has been added, removed or
+    // renamed in the directory since
+    FileTime modifyTime, prefModifyTime;
+    bool haveTime = mNewIndex && Platform::getDirectoryTimes(path, &modifyTime, &prefModifyTime);
+    const ResourceIndex::Directory* cached = NULL;
+    if (haveTime && mCachedIndex)
+    {
+        cached = mCachedIndex->findDirectory(dirPath);
+        if (cached && !mCachedIndex->isDirectoryCurrent(cached, modifyTime, prefModifyTime))
+            cached = NULL;
+    }
+
+    Vector<ResourceIndex::FileEntry> files;
+    Vector<StringTableEntry> subDirectories;
+    if (cached)
+    {
+        for (U32 i = 0; i < cached->numFiles; i++)
+            files.push_back(mCachedIndex->mFiles[cached->firstFile + i]);
+        for (U32 i = 0; i < cached->numSubDirectories; i++)
+            subDirectories.push_back(mCachedIndex->mSubDirectories[cached->firstSubDirectory + i]);
+        mDirectoriesCached++;
+    }
+    else
+    {
+        Vector<Platform::FileInfo> fileInfoVec;
+        Platform::dumpPath(path, fileInfoVec, 0);
+        for (S32 i = 0; i < fileInfoVec.size(); i++)
+        {
+            files.increment();
+            files.last().name = StringTable->insert(fileInfoVec[i].pFileName);
+            files.last().size = fileInfoVec[i].fileSize;
+        }
+        Platform::dumpSubDirectories(path, subDirectories);
+        mDirectoriesScanned++;
+    }
 
-    for (U32 i = 0; i < fileInfoVec.size(); i++)
+    if (haveTime)
     {
-        Platform::FileInfo& rInfo = fileInfoVec[i];
+        mNewIndex->addDirectory(dirPath, modifyTime, prefModifyTime);
+        ResourceIndex::Directory& dir = mNewIndex->mDirectories.last();
+        dir.numFiles = files.size();
+        dir.numSubDirectories = subDirectories.size();
+        for (S32 i = 0; i < files.size(); i++)
+            mNewIndex->mFiles.push_back(files[i]);
+        for (S32 i = 0; i < subDirectories.size(); i++)
+            mNewIndex->mSubDirectories.push_back(subDirectories[i]);
+    }
 
+    for (S32 i = 0; i < files.size(); i++)
+    {
         // Create a resource for this file...
         //
-        ResourceObject* ro = createResource(rInfo.pFullPath, rInfo.pFileName);
+        ResourceObject* ro = createResource(dirPath, files[i].name);
         dictionary.pushBehind(ro, ResourceObject::File);
 
         ro->flags = ResourceObject::File;
         ro->fileOffset = 0;
-        ro->fileSize = rInfo.fileSize;
-        ro->compressedFileSize = rInfo.fileSize;
+        ro->fileSize = files[i].size;
+        ro->compressedFileSize = files[i].size;
 
         // see if it's a zip
         const char* extension = dStrrchr(ro->name, '.');
         if (extension && !dStricmp(extension, ".zip"))
         {
             // Copy the path and files names to the zips resource object
-            ro->zipName = rInfo.pFileName;
-            ro->zipPath = rInfo.pFullPath;
+            ro->zipName = files[i].name;
+            ro->zipPath = dirPath;
             scanZip(ro);
         }
     }
+
+    // The exclusion list may have changed since the index was written
+    for (S32 i = 0; i < subDirectories.size(); i++)
+    {
+        if (Platform::isExcludedDirectory(subDirectories[i]))
+            continue;
+
+        char child[1024];
+        dSprintf(child, sizeof(child), "%s/%s", path, subDirectories[i]);
+        searchPath(child);
+    }
 }
 
 
@@ -366,65 +501,26 @@ void ResManager::searchPath(const char* path)
 bool ResManager::setModZip(const char* path)
 {
     // Get the path and add .zip to the end of the dir
-    const char* ext = ".zip";
-    char* modPath = new char[dStrlen(path) + dStrlen(ext) + 1]; // make enough room.
-    dStrcpy(modPath, path);
-    dStrcat(modPath, ext);
-
-    // Now we have to go through the root and look for our zipped up mod
-    // this is unfortunately necessary because there is no means to get
-    // a individual files properties -- we can only do it in one
-    // big dump
-    Vector < Platform::FileInfo > pathInfo;
-    Platform::dumpPath(Platform::getWorkingDirectory(), pathInfo);
-    for (U32 i = 0; i < pathInfo.size(); i++)
-    {
-        Platform::FileInfo& file = pathInfo[i];
-
-        if (!dStricmp(file.pFileName, modPath))
-        {
-            // Setup the resource to the zip file itself
-            ResourceObject* zip = createResource(NULL, file.pFileName);
-            dictionary.pushBehind(zip, ResourceObject::File);
-            zip->flags = ResourceObject::File;
-            zip->fileOffset = 0;
-            zip->fileSize = file.fileSize;
-            zip->compressedFileSize = file.fileSize;
-            zip->zipName = file.pFileName;
-            zip->zipPath = NULL;
-
-            // Setup the resource for the zip contents
-            // ..now open the volume and add all its resources to the dictionary
-            ZipAggregate zipAggregate;
-            if (zipAggregate.openAggregate(zip->zipName) == false)
-            {
-                delete[] modPath;
-                return false;
-            }
-
-            ZipAggregate::iterator itr;
-            for (itr = zipAggregate.begin(); itr != zipAggregate.end(); itr++)
-            {
-                const ZipAggregate::FileEntry& rEntry = *itr;
-
-                ResourceObject* ro = createZipResource(rEntry.pPath, rEntry.pFileName, zip->zipPath, zip->zipName);
-
-                ro->flags = ResourceObject::VolumeBlock;
-                ro->fileSize = rEntry.fileSize;
-                ro->compressedFileSize = rEntry.compressedFileSize;
-                ro->fileOffset = rEntry.fileOffset;
-                dictionary.pushBehind(ro, ResourceObject::File);
-            }
-            zipAggregate.closeAggregate();
+    char modPath[1024];
+    dSprintf(modPath, sizeof(modPath), "%s.zip", path);
 
-            // Break from the loop since we got our one file
-            delete[] modPath;
-            return true;
-        }
-    }
+    // The zipped up mod has to sit in the working directory
+    if (!Platform::isFile(modPath))
+        return false;
 
-    delete[] modPath;
-    return false;
+    // Setup the resource to the zip file itself
+    S32 size = Platform::getFileSize(modPath);
+    ResourceObject* zip = createResource(NULL, StringTable->insert(modPath));
+    dictionary.pushBehind(zip, ResourceObject::File);
+    zip->flags = ResourceObject::File;
+    zip->fileOffset = 0;
+    zip->fileSize = size;
+    zip->compressedFileSize = size;
+    zip->zipName = zip->name;
+    zip->zipPath = NULL;
+
+    // Setup the resource for the zip contents
+    return scanZip(zip);
 }
 
 //------------------------------------------------------------------------------
@@ -448,6 +544,10 @@ void ResManager::initExcludedDirectories()
 
 void ResManager::setModPaths(U32 numPaths, const char** paths)
 {
+    // Unloaded resources get freed below, so nothing can be in flight.
+    for (S32 i = 0; i < mPreloads.size(); i++)
+        waitForPreload(mPreloads[i]);
+
     // detach all the files.
     for (ResourceObject* pwalk = resourceList.nextResource; pwalk;
         pwalk = pwalk->nextResource)
@@ -458,24 +558,34 @@ void ResManager::setModPaths(U32 numPaths, const char** paths)
     // Set up exclusions.
     initExcludedDirectories();
 
+    // Reuse whatever listings are still good from the last run.
+    U32 startTime = Platform::getRealMilliseconds();
+    ResourceIndex cachedIndex, newIndex;
+    bool useIndex = smIndexFile && smIndexFile[0];
+    if (useIndex)
+    {
+        if (cachedIndex.read(smIndexFile))
+            mCachedIndex = &cachedIndex;
+        mNewIndex = &newIndex;
+    }
+    mDirectoriesCached = mDirectoriesScanned = 0;
+    mZipsCached = mZipsScanned = 0;
+
     // Make sure invalid paths are not processed
     Vector<const char*> validPaths;
 
     // Determine if the mod paths are valid
     for (U32 i = 0; i < numPaths; i++)
     {
-        if (!Platform::isSubDirectory(Platform::getWorkingDirectory(), paths[i]) || Platform::isExcludedDirectory(paths[i]))
+        // Load zip first so that local files override
+        bool isZip = setModZip(paths[i]);
+        if (!isZip && (!Platform::isSubDirectory(Platform::getWorkingDirectory(), paths[i]) || Platform::isExcludedDirectory(paths[i])))
         {
-            if (!setModZip(paths[i]))
-            {
-                Con::errorf("setModPaths: invalid mod path directory name: '%s'", paths[i]);
-                continue;
-            }
+            Con::errorf("setModPaths: invalid mod path directory name: '%s'", paths[i]);
+            continue;
         }
         pathLen += (dStrlen(paths[i]) + 1);
 
-        // Load zip first so that local files override
-        setModZip(paths[i]);
         searchPath(paths[i]);
 
         // Copy this path to the validPaths list
@@ -484,6 +594,20 @@ void ResManager::setModPaths(U32 numPaths, const char** paths)
 
     Platform::clearExcludedDirectories();
 
+    // Only write the index back if something had to be listed again, or if
+    // something listed last time is gone.
+    if (useIndex && (mDirectoriesScanned || mZipsScanned || !mCachedIndex ||
+        newIndex.mDirectories.size() != mCachedIndex->mDirectories.size() ||
+        newIndex.mZips.size() != mCachedIndex->mZips.size()))
+        newIndex.write(smIndexFile);
+    mCachedIndex = NULL;
+    mNewIndex = NULL;
+
+    Con::printf("Resource scan: %d ms, %d directories (%d listed), %d zips (%d opened)",
+        Platform::getRealMilliseconds() - startTime,
+        mDirectoriesCached + mDirectoriesScanned, mDirectoriesScanned,
+        mZipsCached + mZipsScanned, mZipsScanned);
+
     if (!pathLen)
         return;
 
@@ -631,7 +755,7 @@ const char* ResManager::getBasePath()
 
 //------------------------------------------------------------------------------
 
-void ResManager::registerExtension(const char* name, RESOURCE_CREATE_FN create_fn)
+void ResManager::registerExtension(const char* name, RESOURCE_CREATE_FN create_fn, bool threadSafe)
 {
     AssertFatal(!getCreateFunction(name),
         "ResourceManager::registerExtension: file extension already registered.");
@@ -643,13 +767,14 @@ void ResManager::registerExtension(const char* name, RESOURCE_CREATE_FN create_f
     RegisteredExtension* add = new RegisteredExtension;
     add->mExtension = StringTable->insert(extension);
     add->mCreateFn = create_fn;
+    add->mThreadSafe = threadSafe;
     add->next = registeredList;
     registeredList = add;
 }
 
 //------------------------------------------------------------------------------
 
-RESOURCE_CREATE_FN ResManager::getCreateFunction(const char* name)
+RESOURCE_CREATE_FN ResManager::getCreateFunction(const char* name, bool* threadSafe)
 {
     const char* s = dStrrchr(name, '.');
     if (!s)
@@ -659,7 +784,11 @@ RESOURCE_CREATE_FN ResManager::getCreateFunction(const char* name)
     while (itr)
     {
         if (dStricmp(s, itr->mExtension) == 0)
+        {
+            if (threadSafe)
+                *threadSafe = itr->mThreadSafe;
             return (itr->mCreateFn);
+        }
         itr = itr->next;
     }
     return (NULL);
@@ -744,6 +873,10 @@ ResourceObject* ResManager::load(const char* fileName, bool computeCRC)
     if (!obj)
         return NULL;
 
+    // if it's being preloaded, take it over rather than loading it twice
+    if (obj->mPreload)
+        finishPreloadJob(obj->mPreload);
+
     // if no one has a lock on this, but it's loaded and it needs to
     // be CRC'd, delete it and reload it.
     if (!obj->lockCount && computeCRC && obj->mInstance)
@@ -793,7 +926,10 @@ ResourceInstance* ResManager::loadInstance(ResourceObject* obj, bool computeCRC)
             computeCRC = true;
     }
 
-    if (computeCRC)
+    MappedStream* mapped = dynamic_cast<MappedStream*>(stream);
+    if (computeCRC && mapped)
+        obj->crc = calculateCRC(mapped->getData(), mapped->getStreamSize(), InvalidCRC);
+    else if (computeCRC)
         obj->crc = calculateCRCStream(stream, InvalidCRC);
     else
         obj->crc = InvalidCRC;
@@ -841,6 +977,17 @@ Stream* ResManager::openStream(ResourceObject* obj)
     // if disk file
     if (obj->flags & (ResourceObject::File))
     {
+        // Big files are read straight out of a mapping instead
+        if (smMapFiles && obj->fileSize >= MinMappedSize)
+        {
+            MappedStream* mappedStream = MappedStream::open(buildPath(obj->path, obj->name));
+            if (mappedStream)
+            {
+                obj->fileSize = mappedStream->getStreamSize();
+                return mappedStream;
+            }
+        }
+
         diskStream = new FileStream;
         if (!diskStream->open(buildPath(obj->path, obj->name), FileStream::Read))
         {
@@ -871,6 +1018,25 @@ Stream* ResManager::openStream(ResourceObject* obj)
             return NULL;
         }
 
+        // Map the entry's data if it's big enough to be worth it.  Stored
+        // entries are then read with no copying at all, and deflated ones
+        // inflate straight from the mapping.
+        MappedStream* mappedStream = NULL;
+        if (smMapFiles)
+        {
+            U32 dataSize = zlfHeader.m_header.compressionMethod == ZipLocalFileHeader::Stored ?
+                obj->fileSize : obj->compressedFileSize;
+            if (dataSize >= MinMappedSize)
+                mappedStream = MappedStream::open(buildPath(obj->zipPath, obj->zipName),
+                    diskStream->getPosition(), dataSize);
+        }
+
+        if (mappedStream && zlfHeader.m_header.compressionMethod == ZipLocalFileHeader::Stored)
+        {
+            delete diskStream;
+            return mappedStream;
+        }
+
         if (zlfHeader.m_header.compressionMethod == ZipLocalFileHeader::Stored
             || obj->fileSize == 0)
         {
@@ -886,7 +1052,13 @@ Stream* ResManager::openStream(ResourceObject* obj)
                 ZipLocalFileHeader::Deflated)
             {
                 ZipSubRStream* zipStream = new ZipSubRStream;
-                zipStream->attachStream(diskStream);
+                if (mappedStream)
+                {
+                    delete diskStream;
+                    zipStream->attachStream(mappedStream);
+                }
+                else
+                    zipStream->attachStream(diskStream);
                 zipStream->setUncompressedSize(obj->fileSize);
                 return zipStream;
             }
@@ -894,6 +1066,7 @@ Stream* ResManager::openStream(ResourceObject* obj)
             {
                 AssertFatal(false, avar("ResourceManager::loadStream: '%s' Compressed inappropriately in the zip! (%s/%s)",
                     obj->name, obj->zipPath, obj->zipName));
+                delete mappedStream;
                 diskStream->close();
                 return NULL;
             }
@@ -1248,6 +1421,9 @@ ResourceObject* ResManager::reload(const char* fileName, bool computeCRC)
     // Check the crc to see if it needs reloading
     if (obj)
     {
+        if (obj->mPreload)
+            finishPreloadJob(obj->mPreload);
+
         bool reload = true;
 
         // If we have a valid crc check against the new crc
@@ -1337,3 +1513,619 @@ ResourceObject* ResManager::getNextResource()
     return NULL;  // end of traversal
 }
 
+
+//------------------------------------------------------------------------------
+// Background preloading
+//------------------------------------------------------------------------------
+
+/// One resource of a ResourcePreload on its way through the workers.
+struct ResourcePreloadJob
+{
+    enum State
+    {
+        Queued,     ///< In mPreloadQueue
+        Working,    ///< Being read by some thread
+        Done,       ///< In mPreloadFinished
+    };
+
+    ResourcePreload* owner;
+    ResourceObject* obj;
+    Stream* stream;             ///< Opened on the main thread, closed once read (or parsed, if mapped)
+    RESOURCE_CREATE_FN createFn;
+    bool threadSafe;
+    bool computeCRC;
+    bool onWorker;              ///< Read by a worker rather than the main thread
+    State state;
+
+    U8* buffer;
+    U32 size;
+    U32 crc;
+    ResourceInstance* instance;
+    U32 workTime;
+};
+
+ResourcePreload::ResourcePreload()
+{
+    mId = 0;
+    mNumRequested = 0;
+    mNumPending = 0;
+    mNumLoaded = 0;
+    mNumFailed = 0;
+    mCallback = NULL;
+    mUserData = NULL;
+    mNotified = false;
+    mStartTime = mFinishTime = 0;
+    mWorkerTime = mMainTime = mWaitTime = 0;
+}
+
+//------------------------------------------------------------------------------
+
+void ResManager::startPreloadThreads(U32 numThreads)
+{
+    for (U32 i = 0; i < numThreads; i++)
+        mPreloadThreads.push_back(new Thread(preloadWorkerMain, this));
+}
+
+void ResManager::stopPreloadThreads()
+{
+    Mutex::lockMutex(mPreloadMutex);
+    mPreloadExiting = true;
+    Mutex::unlockMutex(mPreloadMutex);
+
+    for (S32 i = 0; i < mPreloadThreads.size(); i++)
+        Semaphore::releaseSemaphore(mPreloadWorkSemaphore);
+
+    // Thread's destructor joins
+    for (S32 i = 0; i < mPreloadThreads.size(); i++)
+        delete mPreloadThreads[i];
+    mPreloadThreads.clear();
+
+    mPreloadExiting = false;
+}
+
+void ResManager::preloadWorkerMain(void* arg)
+{
+    ResManager* mgr = reinterpret_cast<ResManager*>(arg);
+
+    while (true)
+    {
+        Semaphore::acquireSemaphore(mgr->mPreloadWorkSemaphore);
+
+        Mutex::lockMutex(mgr->mPreloadMutex);
+        if (mgr->mPreloadExiting)
+        {
+            Mutex::unlockMutex(mgr->mPreloadMutex);
+            return;
+        }
+
+        // The main thread may have taken the job over already
+        if (mgr->mPreloadQueue.empty())
+        {
+            Mutex::unlockMutex(mgr->mPreloadMutex);
+            continue;
+        }
+
+        ResourcePreloadJob* job = mgr->mPreloadQueue.front();
+        mgr->mPreloadQueue.pop_front();
+        job->state = ResourcePreloadJob::Working;
+        job->onWorker = true;
+        Mutex::unlockMutex(mgr->mPreloadMutex);
+
+        mgr->runPreloadJob(job);
+
+        Mutex::lockMutex(mgr->mPreloadMutex);
+        job->state = ResourcePreloadJob::Done;
+        mgr->mPreloadFinished.push_back(job);
+        Mutex::unlockMutex(mgr->mPreloadMutex);
+
+        Semaphore::releaseSemaphore(mgr->mPreloadDoneSemaphore);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void ResManager::runPreloadJob(ResourcePreloadJob* job)
+{
+    U32 start = Platform::getRealMilliseconds();
+
+    // Mapped files are already in memory, as far as the parser is concerned.
+    // Fault the pages in here and keep the mapping rather than copying it.
+    MappedStream* mapped = dynamic_cast<MappedStream*>(job->stream);
+    if (mapped)
+    {
+        if (job->computeCRC)
+            job->crc = calculateCRC(mapped->getData(), mapped->getStreamSize(), InvalidCRC);
+        else
+            mapped->touchPages();
+
+        if (job->threadSafe)
+        {
+            job->instance = job->createFn(*mapped);
+            closeStream(mapped);
+            job->stream = NULL;
+        }
+
+        job->workTime = Platform::getRealMilliseconds() - start;
+        return;
+    }
+
+    if (job->size)
+    {
+        job->buffer = new U8[job->size];
+        if (!job->stream->read(job->size, job->buffer))
+        {
+            delete[] job->buffer;
+            job->buffer = NULL;
+        }
+    }
+    closeStream(job->stream);
+    job->stream = NULL;
+
+    if (job->buffer)
+    {
+        // The CRC table was built on the main thread by preload()
+        if (job->computeCRC)
+            job->crc = calculateCRC(job->buffer, job->size, InvalidCRC);
+
+        if (job->threadSafe)
+        {
+            MemStream stream(job->size, job->buffer, true, false);
+            job->instance = job->createFn(stream);
+
+            delete[] job->buffer;
+            job->buffer = NULL;
+        }
+    }
+
+    job->workTime = Platform::getRealMilliseconds() - start;
+}
+
+void ResManager::installPreloadJob(ResourcePreloadJob* job)
+{
+    ResourcePreload* preload = job->owner;
+    ResourceObject* obj = job->obj;
+
+    U32 start = Platform::getRealMilliseconds();
+    if (job->stream)
+    {
+        // Still mapped from runPreloadJob()
+        job->instance = job->createFn(*job->stream);
+        closeStream(job->stream);
+        job->stream = NULL;
+    }
+    else if (job->buffer)
+    {
+        MemStream stream(job->size, job->buffer, true, false);
+        job->instance = job->createFn(stream);
+
+        delete[] job->buffer;
+        job->buffer = NULL;
+    }
+    U32 parseTime = Platform::getRealMilliseconds() - start;
+
+    if (job->instance)
+    {
+        // Someone may have add()ed an instance in the meantime
+        if (obj->mInstance)
+            delete job->instance;
+        else
+        {
+            obj->mInstance = job->instance;
+            obj->crc = job->crc;
+            job->instance->mSourceResource = obj;
+        }
+    }
+
+    if (job->onWorker)
+        preload->mWorkerTime += job->workTime;
+    else
+        preload->mMainTime += job->workTime;
+    preload->mMainTime += parseTime;
+
+    if (obj->mInstance)
+        preload->mNumLoaded++;
+    else
+        preload->mNumFailed++;
+
+    obj->mPreload = NULL;
+    delete job;
+
+    if (--preload->mNumPending == 0)
+        preload->mFinishTime = Platform::getRealMilliseconds();
+}
+
+void ResManager::finishPreloadJob(ResourcePreloadJob* job)
+{
+    PROFILE_START(ResManager_finishPreloadJob);
+
+    Mutex::lockMutex(mPreloadMutex);
+    if (job->state == ResourcePreloadJob::Queued)
+    {
+        // Nobody has it yet; cheaper to do it here than to wait
+        for (S32 i = 0; i < mPreloadQueue.size(); i++)
+        {
+            if (mPreloadQueue[i] == job)
+            {
+                mPreloadQueue.erase(i);
+                break;
+            }
+        }
+        job->state = ResourcePreloadJob::Working;
+        Mutex::unlockMutex(mPreloadMutex);
+
+        runPreloadJob(job);
+    }
+    else
+    {
+        U32 start = Platform::getRealMilliseconds();
+        while (job->state != ResourcePreloadJob::Done)
+        {
+            Mutex::unlockMutex(mPreloadMutex);
+            Semaphore::acquireSemaphore(mPreloadDoneSemaphore);
+            Mutex::lockMutex(mPreloadMutex);
+        }
+
+        for (S32 i = 0; i < mPreloadFinished.size(); i++)
+        {
+            if (mPreloadFinished[i] == job)
+            {
+                mPreloadFinished.erase(i);
+                break;
+            }
+        }
+        Mutex::unlockMutex(mPreloadMutex);
+
+        job->owner->mWaitTime += Platform::getRealMilliseconds() - start;
+    }
+
+    installPreloadJob(job);
+
+    PROFILE_END();
+}
+
+//------------------------------------------------------------------------------
+
+ResourcePreload* ResManager::preload(U32 count, const char** fileNames, RESOURCE_PRELOAD_FN callback,
+    void* userData, bool computeCRC)
+{
+    PROFILE_START(ResManager_preload);
+
+    // Pick up thread count changes once nothing is in flight
+    U32 numThreads = getMax(smPreloadThreads, 0);
+    if (mPreloads.empty() && U32(mPreloadThreads.size()) != numThreads)
+    {
+        stopPreloadThreads();
+        startPreloadThreads(numThreads);
+    }
+
+    // The workers CRC files, make sure the lookup table is built here first.
+    calculateCRC(NULL, 0, 0);
+
+    ResourcePreload* preload = new ResourcePreload;
+    preload->mId = mNextPreloadId++;
+    preload->mNumRequested = count;
+    preload->mCallback = callback;
+    preload->mUserData = userData;
+    preload->mStartTime = Platform::getRealMilliseconds();
+    mPreloads.push_back(preload);
+
+    // Keep the batch open until everything is queued
+    preload->mNumPending = 1;
+
+    for (U32 i = 0; i < count; i++)
+    {
+        ResourceObject* obj = find(fileNames[i]);
+        if (!obj)
+        {
+            preload->mNumFailed++;
+            continue;
+        }
+
+        // Listed twice, or already in someone else's batch
+        if (obj->mPreload)
+            finishPreloadJob(obj->mPreload);
+
+        obj->lockCount++;
+        obj->unlink();      // remove from purge list
+        preload->mObjects.push_back(obj);
+
+        if (obj->mInstance)
+        {
+            preload->mNumLoaded++;
+            continue;
+        }
+
+        bool threadSafe = false;
+        RESOURCE_CREATE_FN createFunction = getCreateFunction(obj->name, &threadSafe);
+        if (!createFunction)
+        {
+            Con::errorf("ResManager::preload: NULL resource create function for '%s'.", obj->name);
+            preload->mNumFailed++;
+            continue;
+        }
+
+        // Opening touches the path buffers and the console, so it stays here.
+        Stream* stream = openStream(obj);
+        if (!stream)
+        {
+            preload->mNumFailed++;
+            continue;
+        }
+
+        ResourcePreloadJob* job = new ResourcePreloadJob;
+        job->owner = preload;
+        job->obj = obj;
+        job->stream = stream;
+        job->createFn = createFunction;
+        job->threadSafe = threadSafe;
+        job->computeCRC = computeCRC;
+        if (!computeCRC)
+        {
+            const char* x = dStrrchr(obj->name, '.');
+            job->computeCRC = x && dStrstr(alwaysCRCList, x);
+        }
+        job->onWorker = false;
+        job->state = ResourcePreloadJob::Queued;
+        job->buffer = NULL;
+        job->size = obj->fileSize;
+        job->crc = InvalidCRC;
+        job->instance = NULL;
+        job->workTime = 0;
+
+        obj->mPreload = job;
+        preload->mNumPending++;
+
+        if (mPreloadThreads.empty())
+            finishPreloadJob(job);
+        else
+        {
+            Mutex::lockMutex(mPreloadMutex);
+            mPreloadQueue.push_back(job);
+            Mutex::unlockMutex(mPreloadMutex);
+            Semaphore::releaseSemaphore(mPreloadWorkSemaphore);
+        }
+    }
+
+    if (--preload->mNumPending == 0)
+        preload->mFinishTime = Platform::getRealMilliseconds();
+
+    PROFILE_END();
+    return preload;
+}
+
+void ResManager::processPreloads()
+{
+    if (mPreloads.empty())
+        return;
+
+    PROFILE_START(ResManager_processPreloads);
+
+    Vector<ResourcePreloadJob*> finished;
+    Mutex::lockMutex(mPreloadMutex);
+    finished.merge(mPreloadFinished);
+    mPreloadFinished.clear();
+    Mutex::unlockMutex(mPreloadMutex);
+
+    for (S32 i = 0; i < finished.size(); i++)
+        installPreloadJob(finished[i]);
+
+    // Callbacks are free to release handles, so go by id
+    Vector<U32> done;
+    for (S32 i = 0; i < mPreloads.size(); i++)
+    {
+        if (mPreloads[i]->isDone() && !mPreloads[i]->mNotified)
+        {
+            mPreloads[i]->mNotified = true;
+            if (mPreloads[i]->mCallback)
+                done.push_back(mPreloads[i]->mId);
+        }
+    }
+
+    for (S32 i = 0; i < done.size(); i++)
+    {
+        ResourcePreload* preload = findPreload(done[i]);
+        if (preload)
+            preload->mCallback(preload, preload->mUserData);
+    }
+
+    PROFILE_END();
+}
+
+void ResManager::waitForPreload(ResourcePreload* preload)
+{
+    for (S32 i = 0; i < preload->mObjects.size() && preload->mNumPending; i++)
+    {
+        ResourceObject* obj = preload->mObjects[i];
+        if (obj->mPreload && obj->mPreload->owner == preload)
+            finishPreloadJob(obj->mPreload);
+    }
+}
+
+void ResManager::releasePreload(ResourcePreload* preload)
+{
+    waitForPreload(preload);
+
+    for (S32 i = 0; i < preload->mObjects.size(); i++)
+        unlock(preload->mObjects[i]);
+
+    for (S32 i = 0; i < mPreloads.size(); i++)
+    {
+        if (mPreloads[i] == preload)
+        {
+            mPreloads.erase(i);
+            break;
+        }
+    }
+    delete preload;
+}
+
+ResourcePreload* ResManager::findPreload(U32 id)
+{
+    for (S32 i = 0; i < mPreloads.size(); i++)
+        if (mPreloads[i]->mId == id)
+            return mPreloads[i];
+    return NULL;
+}
+
+void ResManager::printPreloadReport(ResourcePreload* preload, U32 totalTime)
+{
+    U32 wallTime = (preload->isDone() ? preload->mFinishTime : Platform::getRealMilliseconds()) - preload->mStartTime;
+
+    // What the workers did would otherwise have been done on the main thread,
+    // less however long the main thread ended up waiting on them anyway.
+    S32 saved = S32(preload->mWorkerTime) - S32(preload->mWaitTime);
+
+    Con::printf("Resource preload %d: %d requested, %d loaded, %d failed, %d pending",
+        preload->mId, preload->mNumRequested, preload->mNumLoaded, preload->mNumFailed, preload->mNumPending);
+    Con::printf("   %d ms on %d worker(s), %d ms on the main thread, %d ms waiting on workers, %d ms from request to last install",
+        preload->mWorkerTime, mPreloadThreads.size(), preload->mMainTime, preload->mWaitTime, wallTime);
+    if (totalTime)
+        Con::printf("   load took %d ms, about %d ms without preloading (%d ms saved)",
+            totalTime, totalTime + saved, saved);
+    else
+        Con::printf("   %d ms of main thread time saved", saved);
+}
+
+//------------------------------------------------------------------------------
+
+static void preloadScriptCallback(ResourcePreload* preload, void* userData)
+{
+    Con::executef(2, (const char*)userData, Con::getIntArg(preload->getId()));
+}
+
+/// Start preloading, returns the handle id for script.
+static S32 startScriptPreload(const Vector<const char*>& files, const char* callback)
+{
+    RESOURCE_PRELOAD_FN fn = NULL;
+    void* userData = NULL;
+    if (callback && callback[0])
+    {
+        fn = preloadScriptCallback;
+        userData = (void*)StringTable->insert(callback);
+    }
+
+    ResourcePreload* preload = ResourceManager->preload(files.size(), files.address(), fn, userData);
+    return preload->getId();
+}
+
+ConsoleFunction(preloadResources, S32, 2, 3, "(string files, string callback=\"\")"
+    "Start loading a tab or newline separated list of resources in the background. "
+    "Returns a handle for the other preload functions. If given, callback(handle) is called once "
+    "everything is loaded.")
+{
+    char* list = new char[dStrlen(argv[1]) + 1];
+    dStrcpy(list, argv[1]);
+
+    Vector<const char*> files;
+    for (char* tok = dStrtok(list, "\t\n"); tok; tok = dStrtok(NULL, "\t\n"))
+        files.push_back(tok);
+
+    S32 id = startScriptPreload(files, argc > 2 ? argv[2] : NULL);
+    delete[] list;
+    return id;
+}
+
+ConsoleFunction(preloadMissionResources, S32, 2, 3, "(string missionFile, string callback=\"\")"
+    "Scan a mission file for resources it refers to and start loading them in the background. "
+    "Returns a handle for the other preload functions, or 0 if the mission refers to nothing loadable.")
+{
+    Stream* stream = ResourceManager->openStream(argv[1]);
+    if (!stream)
+    {
+        Con::errorf("preloadMissionResources: could not open '%s'.", argv[1]);
+        return 0;
+    }
+
+    U32 size = stream->getStreamSize();
+    char* script = new char[size + 1];
+    stream->read(size, script);
+    script[size] = 0;
+    ResourceManager->closeStream(stream);
+
+    // Relative names in the mission resolve against the mission file, the
+    // same way the console expands them when the mission is executed.
+    const char* missionFile = argv[1];
+    const char* modSlash = dStrchr(missionFile, '/');
+    const char* dirSlash = dStrrchr(missionFile, '/');
+
+    Vector<const char*> files;
+    char* walk = script;
+    while ((walk = dStrchr(walk, '"')) != NULL)
+    {
+        char* start = walk + 1;
+        char* end = dStrchr(start, '"');
+        if (!end)
+            break;
+        *end = 0;
+        walk = end + 1;
+
+        if (!ResourceManager->getCreateFunction(start))
+            continue;
+
+        const char* slash = NULL;
+        if (dStrncmp(start, "~/", 2) == 0)
+            slash = modSlash;
+        else if (dStrncmp(start, "./", 2) == 0)
+            slash = dirSlash;
+
+        const char* name = start;
+        if (slash)
+        {
+            char buf[1024];
+            U32 length = getMin(U32(slash - missionFile), U32(sizeof(buf) - 1));
+            dStrncpy(buf, missionFile, length);
+            dStrncpy(buf + length, start + 1, sizeof(buf) - length - 1);
+            buf[sizeof(buf) - 1] = 0;
+            name = StringTable->insert(buf);
+        }
+        else
+            name = StringTable->insert(start);
+
+        bool listed = false;
+        for (S32 i = 0; i < files.size() && !listed; i++)
+            listed = files[i] == name;
+        if (!listed)
+            files.push_back(name);
+    }
+    delete[] script;
+
+    if (files.empty())
+        return 0;
+    return startScriptPreload(files, argc > 2 ? argv[2] : NULL);
+}
+
+ConsoleFunction(isResourcePreloadDone, bool, 2, 2, "(int handle)"
+    "Returns true once everything in a preload has been loaded.")
+{
+    ResourcePreload* preload = ResourceManager->findPreload(dAtoi(argv[1]));
+    return !preload || preload->isDone();
+}
+
+ConsoleFunction(waitForResourcePreload, void, 2, 2, "(int handle)"
+    "Block until everything in a preload has been loaded.")
+{
+    ResourcePreload* preload = ResourceManager->findPreload(dAtoi(argv[1]));
+    if (preload)
+        ResourceManager->waitForPreload(preload);
+}
+
+ConsoleFunction(releaseResourcePreload, void, 2, 2, "(int handle)"
+    "Release a preload's hold on its resources. Anything not otherwise in use can then be purged.")
+{
+    ResourcePreload* preload = ResourceManager->findPreload(dAtoi(argv[1]));
+    if (preload)
+        ResourceManager->releasePreload(preload);
+}
+
+ConsoleFunction(resourcePreloadReport, void, 2, 3, "(int handle, int totalMs=0)"
+    "Print timing for a preload. If given the total time of the load it overlapped, "
+    "also estimates how long that load would have taken without it.")
+{
+    ResourcePreload* preload = ResourceManager->findPreload(dAtoi(argv[1]));
+    if (!preload)
+    {
+        Con::errorf("resourcePreloadReport: no preload %s.", argv[1]);
+        return;
+    }
+    ResourceManager->printPreloadReport(preload, argc > 2 ? dAtoi(argv[2]) : 0);
+}
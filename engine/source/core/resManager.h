@@ -33,10 +33,12 @@
 #endif
 
 class Stream;
+class Thread;
 class FileStream;
 class ZipSubRStream;
 class ResManager;
 class FindMatch;
+class ResourceIndex;
 
 extern ResManager* ResourceManager;
 
@@ -101,6 +103,12 @@ public:
 
 typedef ResourceInstance* (*RESOURCE_CREATE_FN)(Stream& stream);
 
+class ResourcePreload;
+struct ResourcePreloadJob;
+
+/// Called from ResManager::processPreloads() once every resource in a preload has finished.
+typedef void (*RESOURCE_PRELOAD_FN)(ResourcePreload* preload, void* userData);
+
 
 //------------------------------------------------------------------------------
 #define InvalidCRC 0xFFFFFFFF
@@ -156,6 +164,7 @@ public:
                                   ///  this may be NULL or garbage.
     S32 lockCount;                ///< Lock count; used to control load/unload of resource from memory.
     U32 crc;                      ///< CRC of resource.
+    ResourcePreloadJob* mPreload; ///< Background load in flight for this resource, if any.
 
     ResourceObject();
     ~ResourceObject() { unlink(); }
@@ -260,6 +269,64 @@ public:
 
 #define INVALID_ID ((U32)(~0))
 
+//------------------------------------------------------------------------------
+/// Handle to a batch of resources being loaded in the background.
+///
+/// Returned by ResManager::preload().  Every resource in the batch that was
+/// found is locked for the life of the handle, so finished resources stay in
+/// memory until the handle is given back with ResManager::releasePreload().
+///
+/// @code
+///    const char* files[] = { "marble/data/shapes/foo.dts", "marble/data/interiors/bar.dif" };
+///    ResourcePreload* preload = ResourceManager->preload(2, files);
+///
+///    // ... do other work, ResManager::processPreloads() installs finished resources ...
+///
+///    ResourceManager->waitForPreload(preload);
+///    ResourceManager->releasePreload(preload);
+/// @endcode
+///
+/// @see ResManager::preload
+class ResourcePreload
+{
+    friend class ResManager;
+
+    U32 mId;
+    Vector<ResourceObject*> mObjects;   ///< Locked objects, one per resource found
+
+    U32 mNumRequested;
+    U32 mNumPending;
+    U32 mNumLoaded;
+    U32 mNumFailed;
+
+    RESOURCE_PRELOAD_FN mCallback;
+    void* mUserData;
+    bool mNotified;    ///< Callback has been called
+
+    /// @name Timing
+    /// All in milliseconds.
+    /// @{
+
+    ///
+    U32 mStartTime;    ///< Real time the batch was requested.
+    U32 mFinishTime;   ///< Real time the last resource was installed.
+    U32 mWorkerTime;   ///< Read and parse time spent on the worker threads.
+    U32 mMainTime;     ///< Read and parse time spent on the main thread.
+    U32 mWaitTime;     ///< Time the main thread sat blocked on a worker.
+    /// @}
+
+    ResourcePreload();
+
+public:
+    U32 getId() const { return mId; }
+
+    bool isDone() const { return mNumPending == 0; }
+    U32 getNumRequested() const { return mNumRequested; }
+    U32 getNumPending() const { return mNumPending; }
+    U32 getNumLoaded() const { return mNumLoaded; }
+    U32 getNumFailed() const { return mNumFailed; }
+};
+
 //----------------------------------------------------------------------------
 /// Resource Dictionary.
 ///
@@ -361,13 +428,32 @@ private:
     /// Create a ResourceObject from the given file in a zip file.
     ResourceObject* createZipResource(StringTableEntry path, StringTableEntry file, StringTableEntry zipPath, StringTableEntry zipFle);
 
+    /// Add the resources in a directory and, recursively, its subdirectories.
     void searchPath(const char* pathStart);
     bool setModZip(const char* path);
 
+    /// Add a resource for a file entry of a zip.
+    void addZipEntry(ResourceObject* zipObject, StringTableEntry path, StringTableEntry file,
+        U32 fileSize, U32 compressedFileSize, U32 fileOffset);
+
+    /// @name Resource Index
+    /// Only set while setModPaths() is running.
+    /// @{
+
+    ///
+    ResourceIndex* mCachedIndex;    ///< Read from smIndexFile, NULL if there wasn't a usable one.
+    ResourceIndex* mNewIndex;       ///< Everything found this time, written back to smIndexFile.
+    U32 mDirectoriesCached;
+    U32 mDirectoriesScanned;
+    U32 mZipsCached;
+    U32 mZipsScanned;
+    /// @}
+
     struct RegisteredExtension
     {
         StringTableEntry     mExtension;
         RESOURCE_CREATE_FN   mCreateFn;
+        bool                 mThreadSafe;   ///< mCreateFn may run on a preload worker
         RegisteredExtension* next;
     };
 
@@ -378,9 +464,55 @@ private:
     RegisteredExtension* registeredList;
 
     static char* smExcludedDirectories;
+
+    /// @name Background Preloading
+    /// @{
+
+    ///
+    Vector<Thread*> mPreloadThreads;
+    void* mPreloadMutex;
+    void* mPreloadWorkSemaphore;
+    void* mPreloadDoneSemaphore;
+    bool  mPreloadExiting;
+
+    Vector<ResourcePreloadJob*> mPreloadQueue;      ///< Waiting for a worker.
+    Vector<ResourcePreloadJob*> mPreloadFinished;   ///< Done on a worker, waiting to be installed.
+    Vector<ResourcePreload*>    mPreloads;          ///< Handles that haven't been released.
+    U32 mNextPreloadId;
+
+    static void preloadWorkerMain(void* arg);
+    void startPreloadThreads(U32 numThreads);
+    void stopPreloadThreads();
+
+    /// Read (and, for thread safe types, construct) a job's resource.  Runs on
+    /// whichever thread got the job.
+    void runPreloadJob(ResourcePreloadJob* job);
+
+    /// Construct anything left to construct and hand the instance to its
+    /// ResourceObject.  Main thread only.
+    void installPreloadJob(ResourcePreloadJob* job);
+
+    /// Take a job back from the workers, waiting on it or running it here as
+    /// needed, and install it.
+    void finishPreloadJob(ResourcePreloadJob* job);
+    /// @}
+
     ResManager();
 public:
-    RESOURCE_CREATE_FN getCreateFunction(const char* name);
+    RESOURCE_CREATE_FN getCreateFunction(const char* name, bool* threadSafe = NULL);
+
+    /// Number of worker threads used for preloading.  Zero loads everything
+    /// inline in preload().
+    static S32 smPreloadThreads;
+
+    /// Whether openStream() may hand out MappedStreams for files and zip
+    /// entries of at least MinMappedSize bytes.
+    static bool smMapFiles;
+    enum { MinMappedSize = 16 * 1024 };
+
+    /// File setModPaths() keeps its directory and zip listings in, so the next
+    /// run only has to list what changed.  Empty to always scan everything.
+    static const char* smIndexFile;
 
     ~ResManager();
     /// @name Global Control
@@ -405,8 +537,12 @@ public:
     bool getMissingFileList(Vector<char*>& list);     ///< Gets which files are missing
     void clearMissingFileList();                       ///< Clears the missing file list
 
-    /// Tells the resource manager what to do with a resource that it loads
-    void registerExtension(const char* extension, RESOURCE_CREATE_FN create_fn);
+    /// Tells the resource manager what to do with a resource that it loads.
+    ///
+    /// Pass threadSafe if create_fn only touches the stream and the instance it
+    /// builds, so preloads can run it on a worker thread.  Anything else is
+    /// read in the background but constructed on the main thread.
+    void registerExtension(const char* extension, RESOURCE_CREATE_FN create_fn, bool threadSafe = false);
 
     S32 getSize(const char* filename);                 ///< Gets the size of the file
     const char* getFullPath(const char* filename, char* path, U32 pathLen);  ///< Gets the full path of the file
@@ -464,6 +600,27 @@ public:
     ResourceObject* reload(const char* fileName, bool computeCRC = false); ///< if the object is already loaded it will be reloaded
     void reloadResources();
 
+    /// @name Background Preloading
+    ///
+    /// preload() finds and opens the files on the calling thread, then hands the
+    /// reads (and construction, for thread safe types) to the worker threads.
+    /// Finished resources are installed on the main thread by processPreloads(),
+    /// or as soon as load() asks for one of them.
+    /// @{
+
+    /// Start loading a set of resources in the background.
+    ///
+    /// @param  callback  Called from processPreloads() once the whole batch is done.
+    ResourcePreload* preload(U32 count, const char** fileNames, RESOURCE_PRELOAD_FN callback = NULL,
+        void* userData = NULL, bool computeCRC = false);
+
+    void processPreloads();                            ///< Installs resources the workers have finished.
+    void waitForPreload(ResourcePreload* preload);     ///< Blocks until every resource in the batch is installed.
+    void releasePreload(ResourcePreload* preload);     ///< Drops the batch's locks and deletes the handle.
+    ResourcePreload* findPreload(U32 id);              ///< Looks up an unreleased handle by id.
+    void printPreloadReport(ResourcePreload* preload, U32 totalTime = 0); ///< Prints timing for a batch.
+    /// @}
+
 #ifdef TORQUE_DEBUG
     void dumpLoadedResources();                        ///< Dumps all loaded resources to the console.
 #endif
@@ -5,9 +5,14 @@
 
 #include "platform/platform.h"
 #include "core/stringTable.h"
+#include "platform/platformMutex.h"
+#include "platform/platformThread.h"
+#include "platform/platformAtomic.h"
+#include "console/console.h"
+#include "math/mMathFn.h"
 
 _StringTable* StringTable = NULL;
-const U32 _StringTable::csm_stInitSize = 29;
+const U32 _StringTable::csm_stInitSize = 32;
 
 //---------------------------------------------------------------
 //
@@ -17,20 +22,36 @@ const U32 _StringTable::csm_stInitSize = 29;
 
 namespace {
     bool sgInitTable = true;
-    U8   sgHashTable[256];
+    U8   sgTolowerTable[256];
 
+    // Filling this in twice from two threads is harmless, it's
+    // the same either way.
     void initTolowerTable()
     {
-        for (U32 i = 0; i < 256; i++) {
-            U8 c = dTolower(i);
-            sgHashTable[i] = c * c;
-        }
+        for (U32 i = 0; i < 256; i++)
+            sgTolowerTable[i] = dTolower(i);
 
         sgInitTable = false;
     }
 
+    /// Mixes the bits of a hash so that the low bits, which pick the
+    /// bucket, depend on every character.
+    inline U32 finishHash(U32 hash)
+    {
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6b;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
 } // namespace {}
 
+// FNV-1a over the lower case characters.  Names which only differ in their
+// last few characters, like "node12" and "node13", still land in
+// different buckets.
+
 U32 _StringTable::hashString(const char* str)
 {
     if (sgInitTable)
@@ -38,13 +59,13 @@ U32 _StringTable::hashString(const char* str)
 
     if (!str) return -1;
 
-    U32 ret = 0;
-    char c;
+    U32 ret = 2166136261u;
+    U8 c;
     while ((c = *str++) != 0) {
-        ret <<= 1;
-        ret ^= sgHashTable[c];
+        ret ^= sgTolowerTable[c];
+        ret *= 16777619u;
     }
-    return ret;
+    return finishHash(ret);
 }
 
 U32 _StringTable::hashStringn(const char* str, S32 len)
@@ -52,31 +73,34 @@ U32 _StringTable::hashStringn(const char* str, S32 len)
     if (sgInitTable)
         initTolowerTable();
 
-    U32 ret = 0;
-    char c;
-    while ((c = *str++) != 0 && len--) {
-        ret <<= 1;
-        ret ^= sgHashTable[c];
+    U32 ret = 2166136261u;
+    U8 c;
+    while (len-- > 0 && (c = *str++) != 0) {
+        ret ^= sgTolowerTable[c];
+        ret *= 16777619u;
     }
-    return ret;
+    return finishHash(ret);
 }
 
 //--------------------------------------
 _StringTable::_StringTable()
 {
-    buckets = (Node**)dMalloc(csm_stInitSize * sizeof(Node*));
-    for (U32 i = 0; i < csm_stInitSize; i++) {
-        buckets[i] = 0;
-    }
+    if (sgInitTable)
+        initTolowerTable();
 
-    numBuckets = csm_stInitSize;
+    buckets = allocBuckets(csm_stInitSize);
     itemCount = 0;
+    mMutex = Mutex::createMutex();
 }
 
 //--------------------------------------
 _StringTable::~_StringTable()
 {
     dFree(buckets);
+    for (S32 i = 0; i < mOldBuckets.size(); i++)
+        dFree(mOldBuckets[i]);
+
+    Mutex::destroyMutex(mMutex);
 }
 
 
@@ -96,33 +120,97 @@ void _StringTable::destroy()
     StringTable = NULL;
 }
 
+//--------------------------------------
+_StringTable::Buckets* _StringTable::allocBuckets(U32 count)
+{
+    AssertFatal(count && (count & (count - 1)) == 0, "_StringTable::allocBuckets: count must be a power of 2.");
+
+    Buckets* table = (Buckets*)dMalloc(sizeof(Buckets) + (count - 1) * sizeof(Node*));
+    table->mask = count - 1;
+    for (U32 i = 0; i < count; i++)
+        table->heads[i] = NULL;
+
+    return table;
+}
+
+//--------------------------------------
+void _StringTable::appendNode(Buckets* table, char* val, U32 hash)
+{
+    Node* node = (Node*)mempool.alloc(sizeof(Node));
+    node->val = val;
+    node->hash = hash;
+    node->next = NULL;
+
+    Node** walk = &table->heads[hash & table->mask];
+    while (*walk)
+        walk = &(*walk)->next;
+
+    // Readers may be walking this chain right now... the node
+    // has to be complete before they can reach it.
+    dAtomicStoreRelease(walk, node);
+}
 
 //--------------------------------------
-StringTableEntry _StringTable::insert(const char* val, const bool  caseSens)
+StringTableEntry _StringTable::find(const char* val, U32 key, const bool caseSens)
 {
-    Node** walk, * temp;
-    U32 key = hashString(val);
-    walk = &buckets[key % numBuckets];
-    while ((temp = *walk) != NULL) {
-        if (caseSens && !dStrcmp(temp->val, val))
-            return temp->val;
-        else if (!caseSens && !dStricmp(temp->val, val))
-            return temp->val;
-        walk = &(temp->next);
+    Buckets* table = dAtomicLoadAcquire(&buckets);
+    Node* walk = dAtomicLoadAcquire(&table->heads[key & table->mask]);
+    while (walk) {
+        if (walk->hash == key) {
+            if (caseSens && !dStrcmp(walk->val, val))
+                return walk->val;
+            else if (!caseSens && !dStricmp(walk->val, val))
+                return walk->val;
+        }
+        walk = dAtomicLoadAcquire(&walk->next);
     }
-    char* ret = 0;
-    if (!*walk) {
-        *walk = (Node*)mempool.alloc(sizeof(Node));
-        (*walk)->next = 0;
-        (*walk)->val = (char*)mempool.alloc(dStrlen(val) + 1);
-        dStrcpy((*walk)->val, val);
-        ret = (*walk)->val;
-        itemCount++;
+    return NULL;
+}
+
+//--------------------------------------
+StringTableEntry _StringTable::findn(const char* val, S32 len, U32 key, const bool caseSens)
+{
+    Buckets* table = dAtomicLoadAcquire(&buckets);
+    Node* walk = dAtomicLoadAcquire(&table->heads[key & table->mask]);
+    while (walk) {
+        if (walk->hash == key) {
+            if (caseSens && !dStrncmp(walk->val, val, len) && walk->val[len] == 0)
+                return walk->val;
+            else if (!caseSens && !dStrnicmp(walk->val, val, len) && walk->val[len] == 0)
+                return walk->val;
+        }
+        walk = dAtomicLoadAcquire(&walk->next);
     }
-    if (itemCount > 2 * numBuckets) {
-        resize(4 * numBuckets - 1);
+    return NULL;
+}
+
+//--------------------------------------
+StringTableEntry _StringTable::insert(const char* val, const bool  caseSens)
+{
+    U32 key = hashString(val);
+
+    // Most inserts are for strings we already have.
+    StringTableEntry ret = find(val, key, caseSens);
+    if (ret)
+        return ret;
+
+    MutexHandle handle;
+    handle.lock(mMutex);
+
+    // Someone else may have added it while we waited.
+    ret = find(val, key, caseSens);
+    if (ret)
+        return ret;
+
+    char* str = (char*)mempool.alloc(dStrlen(val) + 1);
+    dStrcpy(str, val);
+    appendNode(buckets, str, key);
+    itemCount++;
+
+    if (itemCount > 2 * (buckets->mask + 1)) {
+        rehash(4 * (buckets->mask + 1));
     }
-    return ret;
+    return str;
 }
 
 //--------------------------------------
@@ -138,69 +226,184 @@ StringTableEntry _StringTable::insertn(const char* src, S32 len, const bool  cas
 //--------------------------------------
 StringTableEntry _StringTable::lookup(const char* val, const bool  caseSens)
 {
-    Node** walk, * temp;
-    U32 key = hashString(val);
-    walk = &buckets[key % numBuckets];
-    while ((temp = *walk) != NULL) {
-        if (caseSens && !dStrcmp(temp->val, val))
-            return temp->val;
-        else if (!caseSens && !dStricmp(temp->val, val))
-            return temp->val;
-        walk = &(temp->next);
-    }
-    return NULL;
+    return find(val, hashString(val), caseSens);
 }
 
 //--------------------------------------
 StringTableEntry _StringTable::lookupn(const char* val, S32 len, const bool  caseSens)
 {
-    Node** walk, * temp;
-    U32 key = hashStringn(val, len);
-    walk = &buckets[key % numBuckets];
-    while ((temp = *walk) != NULL) {
-        if (caseSens && !dStrncmp(temp->val, val, len) && temp->val[len] == 0)
-            return temp->val;
-        else if (!caseSens && !dStrnicmp(temp->val, val, len) && temp->val[len] == 0)
-            return temp->val;
-        walk = &(temp->next);
-    }
-    return NULL;
+    return findn(val, len, hashStringn(val, len), caseSens);
 }
 
 //--------------------------------------
 void _StringTable::resize(const U32 newSize)
 {
-    Node* head = NULL, * walk, * temp;
-    U32 i;
-    // reverse individual bucket lists
-    // we do this because new strings are added at the end of bucket
-    // lists so that case sens strings are always after their
-    // corresponding case insens strings
-
-    for (i = 0; i < numBuckets; i++) {
-        walk = buckets[i];
-        while (walk)
-        {
-            temp = walk->next;
-            walk->next = head;
-            head = walk;
-            walk = temp;
+    MutexHandle handle;
+    handle.lock(mMutex);
+
+    U32 count = csm_stInitSize;
+    while (count < newSize)
+        count <<= 1;
+
+    if (count != buckets->mask + 1)
+        rehash(count);
+}
+
+//--------------------------------------
+void _StringTable::rehash(U32 count)
+{
+    // Readers may still be walking the old chains, so we leave them
+    // alone and link new nodes for the same strings.  Walking each old
+    // chain in order keeps case sensitive strings after their case
+    // insensitive matches.
+    Buckets* table = allocBuckets(count);
+    for (U32 i = 0; i <= buckets->mask; i++) {
+        for (Node* walk = buckets->heads[i]; walk; walk = walk->next)
+            appendNode(table, walk->val, walk->hash);
+    }
+
+    mOldBuckets.push_back(buckets);
+    dAtomicStoreRelease(&buckets, table);
+}
+
+//--------------------------------------
+void _StringTable::getBucketStats(U32* numBuckets, U32* usedBuckets, U32* longestChain)
+{
+    MutexHandle handle;
+    handle.lock(mMutex);
+
+    *numBuckets = buckets->mask + 1;
+    *usedBuckets = 0;
+    *longestChain = 0;
+
+    for (U32 i = 0; i <= buckets->mask; i++) {
+        U32 length = 0;
+        for (Node* walk = buckets->heads[i]; walk; walk = walk->next)
+            length++;
+
+        if (length)
+            (*usedBuckets)++;
+        *longestChain = getMax(*longestChain, length);
+    }
+}
+
+//--------------------------------------
+// Benchmark
+//--------------------------------------
+
+namespace {
+
+    struct StringTableBenchData
+    {
+        Vector<const char*>* names;
+        U32 iterations;
+        U32 misses;
+    };
+
+    void stringTableBenchThread(void* arg)
+    {
+        StringTableBenchData* data = (StringTableBenchData*)arg;
+        const Vector<const char*>& names = *data->names;
+        for (U32 iter = 0; iter < data->iterations; iter++) {
+            for (S32 i = 0; i < names.size(); i++) {
+                if (StringTable->insert(names[i]) != StringTable->lookup(names[i]))
+                    data->misses++;
+            }
         }
     }
-    buckets = (Node**)dRealloc(buckets, newSize * sizeof(Node));
-    for (i = 0; i < newSize; i++) {
-        buckets[i] = 0;
+
+    // The hash this table used to have, for comparing distribution.
+    U32 oldHashString(const char* str)
+    {
+        U32 ret = 0;
+        U8 c;
+        while ((c = *str++) != 0) {
+            ret <<= 1;
+            ret ^= U8(sgTolowerTable[c] * sgTolowerTable[c]);
+        }
+        return ret;
     }
-    numBuckets = newSize;
-    walk = head;
-    while (walk) {
-        U32 key;
-        Node* temp = walk;
 
-        walk = walk->next;
-        key = hashString(temp->val);
-        temp->next = buckets[key % newSize];
-        buckets[key % newSize] = temp;
+} // namespace {}
+
+ConsoleFunction(benchStringTable, void, 1, 4, "benchStringTable([count = 100000], [threads = 4], [iterations = 10])\n"
+    "Interns count generated names that only differ by a number, then times "
+    "lookups and inserts of them from one thread and from several at once.  "
+    "The names are left in the table.")
+{
+    const U32 count = argc > 1 ? getMax(dAtoi(argv[1]), 1) : 100000;
+    const U32 numThreads = argc > 2 ? mClamp(dAtoi(argv[2]), 1, 32) : 4;
+    const U32 iterations = argc > 3 ? getMax(dAtoi(argv[3]), 1) : 10;
+
+    // Similar names are the worst case for a weak hash.
+    Vector<char*> buffers;
+    Vector<const char*> names;
+    buffers.setSize(count);
+    names.setSize(count);
+    for (U32 i = 0; i < count; i++) {
+        buffers[i] = new char[32];
+        dSprintf(buffers[i], 32, "benchNode%d_%d", i / 64, i % 64);
+        names[i] = buffers[i];
     }
-}
 
+    U32 start = Platform::getRealMilliseconds();
+    for (U32 i = 0; i < count; i++)
+        StringTable->insert(names[i]);
+    U32 insertMs = getMax(Platform::getRealMilliseconds() - start, U32(1));
+
+    start = Platform::getRealMilliseconds();
+    U32 misses = 0;
+    for (U32 iter = 0; iter < iterations; iter++) {
+        for (U32 i = 0; i < count; i++) {
+            if (!StringTable->lookup(names[i]))
+                misses++;
+        }
+    }
+    U32 lookupMs = getMax(Platform::getRealMilliseconds() - start, U32(1));
+
+    Vector<StringTableBenchData> data;
+    Vector<Thread*> threads;
+    data.setSize(numThreads);
+    start = Platform::getRealMilliseconds();
+    for (U32 t = 0; t < numThreads; t++) {
+        data[t].names = &names;
+        data[t].iterations = iterations;
+        data[t].misses = 0;
+        threads.push_back(new Thread(stringTableBenchThread, &data[t]));
+    }
+    for (U32 t = 0; t < numThreads; t++) {
+        threads[t]->join();
+        delete threads[t];
+        misses += data[t].misses;
+    }
+    U32 threadedMs = getMax(Platform::getRealMilliseconds() - start, U32(1));
+
+    U32 numBuckets, usedBuckets, longestChain;
+    StringTable->getBucketStats(&numBuckets, &usedBuckets, &longestChain);
+
+    // How the old hash would have spread the same names.
+    Vector<U32> oldChains;
+    oldChains.setSize(numBuckets);
+    dMemset(oldChains.address(), 0, numBuckets * sizeof(U32));
+    U32 oldUsed = 0, oldLongest = 0;
+    for (U32 i = 0; i < count; i++) {
+        U32& chain = oldChains[oldHashString(names[i]) % numBuckets];
+        if (!chain++)
+            oldUsed++;
+        oldLongest = getMax(oldLongest, chain);
+    }
+
+    Con::printf("benchStringTable - %d names, %d strings in the table, %d buckets", count, StringTable->getItemCount(), numBuckets);
+    Con::printf("   insert new:       %5d ms, %.0f/second", insertMs, F64(count) * 1000.0 / insertMs);
+    Con::printf("   lookup:           %5d ms, %.0f/second", lookupMs, F64(count) * iterations * 1000.0 / lookupMs);
+    Con::printf("   %2d threads:       %5d ms, %.0f insert+lookup/second", numThreads, threadedMs,
+        F64(count) * iterations * numThreads * 1000.0 / threadedMs);
+    Con::printf("   buckets used:     %d (longest chain %d), old hash %d (longest chain %d)",
+        usedBuckets, longestChain, oldUsed, oldLongest);
+
+    if (misses)
+        Con::errorf("benchStringTable - %d lookups didn't match their insert!", misses);
+
+    for (U32 i = 0; i < count; i++)
+        delete [] buffers[i];
+}
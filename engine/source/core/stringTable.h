@@ -12,6 +12,9 @@
 #ifndef _DATACHUNKER_H_
 #include "core/dataChunker.h"
 #endif
+#ifndef _TVECTOR_H_
+#include "core/tVector.h"
+#endif
 
 
 //--------------------------------------
@@ -56,6 +59,12 @@
 /// @note Be aware that the StringTable NEVER DEALLOCATES memory, so be careful when you
 ///       add strings to it. If you carelessly add many strings, you will end up wasting
 ///       space.
+///
+/// The table is safe to use from any thread.  Lookups, and inserts of strings which
+/// are already in the table, never lock.  Only adding a new string takes the table's
+/// mutex.  Nodes are never changed once they're linked into a bucket, so a growing
+/// table links copies of them into a new bucket array and leaves the old one to any
+/// readers still walking it.
 class _StringTable
 {
 private:
@@ -66,13 +75,37 @@ private:
     struct Node
     {
         char* val;
+        U32   hash;
         Node* next;
     };
 
-    Node** buckets;
-    U32         numBuckets;
+    /// A bucket array.  Once published it is only ever added to.
+    struct Buckets
+    {
+        U32   mask;          ///< Number of buckets - 1, always a power of 2
+        Node* heads[1];
+    };
+
+    Buckets*    buckets;
     U32         itemCount;
-    DataChunker mempool;
+    DataChunker mempool;     ///< Nodes and strings, only touched under mMutex.
+    void*       mMutex;      ///< Serializes inserts.
+
+    /// Replaced bucket arrays, freed with the table.
+    Vector<Buckets*> mOldBuckets;
+
+    static Buckets* allocBuckets(U32 count);
+
+    /// Appends a node for val to the end of its bucket, so that case
+    /// sensitive strings stay after their case insensitive matches.
+    void appendNode(Buckets* table, char* val, U32 hash);
+
+    /// Moves to a new bucket array of count buckets.  mMutex must be held.
+    void rehash(U32 count);
+
+    /// Searches without locking.
+    StringTableEntry find(const char* val, U32 hash, bool caseSens);
+    StringTableEntry findn(const char* val, S32 len, U32 hash, bool caseSens);
 
 protected:
     static const U32 csm_stInitSize;
@@ -128,13 +161,21 @@ public:
     /// is called automatically by the StringTable when the table is
     /// full past a certain threshhold.
     ///
-    /// @param newSize   Number of new items to allocate space for.
+    /// @param newSize   Number of new items to allocate space for, rounded
+    ///                  up to a power of 2.
     void             resize(const U32 newSize);
 
-    /// Hash a string into a U32.
+    /// Returns the number of strings in the table.
+    U32 getItemCount() const { return itemCount; }
+
+    /// Fills in the number of buckets, how many of them are in use and the
+    /// length of the longest chain.
+    void getBucketStats(U32* numBuckets, U32* usedBuckets, U32* longestChain);
+
+    /// Hash a string into a U32.  Case is ignored.
     static U32 hashString(const char* in_pString);
 
-    /// Hash a string of given length into a U32.
+    /// Hash a string of given length into a U32.  Case is ignored.
     static U32 hashStringn(const char* in_pString, S32 len);
 };
 
@@ -67,7 +67,7 @@ private:
         Node* mNext;
         Pair mPair;
         Node() : mNext(0) {}
-        Node(Pair p, Node* n) : mPair(p), mNext(n) {}
+        Node(Pair p, Node* n) : mNext(n), mPair(p) {}
     };
 
     Node** mTable;                      ///< Hash table
@@ -333,7 +333,7 @@ inline F32 HashTable<Key, Value>::collisions() const
 template<typename Key, typename Value>
 typename HashTable<Key, Value>::Iterator HashTable<Key, Value>::insertUnique(const Key& key, const Value& x)
 {
-    if (mSize >= mTableSize)
+    if (mSize >= U32(mTableSize))
         _resize(mSize + 1);
     Node** table = &mTable[_index(key)];
     for (Node* itr = *table; itr; itr = itr->mNext)
@@ -351,7 +351,7 @@ typename HashTable<Key, Value>::Iterator HashTable<Key, Value>::insertUnique(con
 template<typename Key, typename Value>
 typename HashTable<Key, Value>::Iterator HashTable<Key, Value>::insertEqual(const Key& key, const Value& x)
 {
-    if (mSize >= mTableSize)
+    if (mSize >= U32(mTableSize))
         _resize(mSize + 1);
     // The new key is inserted at the head of any group of matching keys.
     Node** prev = &mTable[_index(key)];
@@ -403,7 +403,7 @@ void HashTable<Key, Value>::erase(Iterator node)
 template<typename Key, typename Value>
 typename HashTable<Key, Value>::Iterator HashTable<Key, Value>::findOrInsert(const Key& key)
 {
-    if (mSize >= mTableSize)
+    if (mSize >= U32(mTableSize))
         _resize(mSize + 1);
     Node** table = &mTable[_index(key)];
     for (Node* itr = *table; itr; itr = itr->mNext)
@@ -424,6 +424,16 @@ typename HashTable<Key, Value>::Iterator HashTable<Key, Value>::find(const Key&
     return Iterator(this, 0);
 }
 
+template<typename Key, typename Value>
+typename HashTable<Key, Value>::ConstIterator HashTable<Key, Value>::find(const Key& key) const
+{
+    if (mTableSize)
+        for (Node* itr = mTable[_index(key)]; itr; itr = itr->mNext)
+            if (KeyCmp::equals<Key>(itr->mPair.key, key))
+                return ConstIterator(this, itr);
+    return ConstIterator(this, 0);
+}
+
 template<typename Key, typename Value>
 S32 HashTable<Key, Value>::count(const Key& key)
 {
@@ -0,0 +1,122 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "core/threadPool.h"
+#include "platform/platformThread.h"
+#include "platform/platformMutex.h"
+#include "platform/platformSemaphore.h"
+
+//----------------------------------------------------------------------------
+
+ThreadPool::ThreadPool(U32 numThreads)
+{
+    mMutex = Mutex::createMutex();
+    mWorkSemaphore = Semaphore::createSemaphore(0);
+    mDoneSemaphore = Semaphore::createSemaphore(0);
+
+    mWorkFunc = NULL;
+    mWorkData = NULL;
+    mWorkCount = 0;
+    mNextIndex = 0;
+    mRemaining = 0;
+    mExiting = false;
+
+    for (U32 i = 0; i < numThreads; i++)
+        mThreads.push_back(new Thread(workerMain, this));
+}
+
+ThreadPool::~ThreadPool()
+{
+    Mutex::lockMutex(mMutex);
+    mExiting = true;
+    Mutex::unlockMutex(mMutex);
+
+    for (S32 i = 0; i < mThreads.size(); i++)
+        Semaphore::releaseSemaphore(mWorkSemaphore);
+
+    // Thread's destructor joins
+    for (S32 i = 0; i < mThreads.size(); i++)
+        delete mThreads[i];
+    mThreads.clear();
+
+    Semaphore::destroySemaphore(mDoneSemaphore);
+    Semaphore::destroySemaphore(mWorkSemaphore);
+    Mutex::destroyMutex(mMutex);
+}
+
+void ThreadPool::workerMain(void* arg)
+{
+    ThreadPool* pool = reinterpret_cast<ThreadPool*>(arg);
+
+    while (true)
+    {
+        Semaphore::acquireSemaphore(pool->mWorkSemaphore);
+
+        Mutex::lockMutex(pool->mMutex);
+        bool exiting = pool->mExiting;
+        Mutex::unlockMutex(pool->mMutex);
+
+        if (exiting)
+            return;
+
+        pool->drainWork();
+    }
+}
+
+void ThreadPool::drainWork()
+{
+    while (true)
+    {
+        Mutex::lockMutex(mMutex);
+        if (mNextIndex >= mWorkCount)
+        {
+            Mutex::unlockMutex(mMutex);
+            return;
+        }
+        U32 index = mNextIndex++;
+        WorkFunction func = mWorkFunc;
+        void* data = mWorkData;
+        Mutex::unlockMutex(mMutex);
+
+        func(data, index);
+
+        Mutex::lockMutex(mMutex);
+        bool finished = --mRemaining == 0;
+        Mutex::unlockMutex(mMutex);
+
+        if (finished)
+            Semaphore::releaseSemaphore(mDoneSemaphore);
+    }
+}
+
+void ThreadPool::parallelFor(WorkFunction func, void* data, U32 count)
+{
+    if (count == 0)
+        return;
+
+    if (mThreads.empty() || count == 1)
+    {
+        for (U32 i = 0; i < count; i++)
+            func(data, i);
+        return;
+    }
+
+    Mutex::lockMutex(mMutex);
+    mWorkFunc = func;
+    mWorkData = data;
+    mWorkCount = count;
+    mNextIndex = 0;
+    mRemaining = count;
+    Mutex::unlockMutex(mMutex);
+
+    // The calling thread takes one share of the work itself
+    U32 wake = getMin(count - 1, (U32)mThreads.size());
+    for (U32 i = 0; i < wake; i++)
+        Semaphore::releaseSemaphore(mWorkSemaphore);
+
+    drainWork();
+
+    Semaphore::acquireSemaphore(mDoneSemaphore);
+}
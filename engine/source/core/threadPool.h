@@ -0,0 +1,67 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/tVector.h"
+#endif
+
+class Thread;
+
+/// A fixed set of worker threads for fanning work out across cores.
+///
+/// Work is handed out as an index range; the calling thread takes part in
+/// the work as well, so a pool with zero workers simply runs everything
+/// inline.
+///
+/// @code
+///   static void doItem(void* data, U32 index)
+///   {
+///      ((Item*)data)[index].update();
+///   }
+///
+///   pool->parallelFor(doItem, items, itemCount);
+/// @endcode
+class ThreadPool
+{
+public:
+    typedef void (*WorkFunction)(void* data, U32 index);
+
+private:
+    Vector<Thread*> mThreads;
+
+    void* mMutex;
+    void* mWorkSemaphore;
+    void* mDoneSemaphore;
+
+    WorkFunction mWorkFunc;
+    void* mWorkData;
+    U32 mWorkCount;
+    U32 mNextIndex;
+    U32 mRemaining;
+    bool mExiting;
+
+    static void workerMain(void* arg);
+
+    /// Run work items until none are left.
+    void drainWork();
+
+public:
+    ThreadPool(U32 numThreads);
+    ~ThreadPool();
+
+    U32 getNumThreads() const { return mThreads.size(); }
+
+    /// Calls func(data, i) for every i in [0, count) and returns once all of
+    /// them have finished.  Calls may happen in any order and on any thread.
+    void parallelFor(WorkFunction func, void* data, U32 count);
+};
+
+#endif // _THREADPOOL_H_
@@ -20,6 +20,8 @@ public:
 
     int main(int argc, const char** argv);
 
+    S32 getTimeUntilTick();
+
     void processPacketReceiveEvent(PacketReceiveEvent* event);
     void processMouseMoveEvent(MouseMoveEvent* event);
     void processInputEvent(InputEvent* event);
@@ -865,6 +865,8 @@ void GameInit()
     */
     Con::addVariable("$pref::TS::autoDetail", TypeF32, &DetailManager::smDetailScale);
     Con::addVariable("$pref::visibleDistanceMod", TypeF32, &SceneGraph::smVisibleDistanceMod);
+    Con::addVariable("$Scope::useSnapshot", TypeBool, &SceneGraph::smUseScopeSnapshot);
+    Con::addVariable("$Scope::cellSize", TypeF32, &SceneGraph::smScopeCellSize);
 
     // updated every frame
     Con::addVariable("cameraFov", TypeF32, &sConsoleCameraFov);
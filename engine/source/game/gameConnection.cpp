@@ -1343,7 +1343,7 @@ GameConnection::GamePacketNotify::GamePacketNotify()
 
 NetConnection::PacketNotify* GameConnection::allocNotify()
 {
-    return new GamePacketNotify;
+    return new (allocNotifyMemory(sizeof(GamePacketNotify))) GamePacketNotify;
 }
 
 void GameConnection::packetReceived(PacketNotify* note)
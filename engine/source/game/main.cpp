@@ -23,6 +23,7 @@
 #include "sim/actionMap.h"
 #include "core/dnet.h"
 #include "game/game.h"
+#include "game/gameProcess.h"
 #include "core/bitStream.h"
 #include "console/telnetConsole.h"
 #include "console/telnetDebugger.h"
@@ -33,6 +34,7 @@
 #include "interior/interiorInstance.h"
 #include "interior/interiorMapRes.h"
 #include "ts/tsShapeInstance.h"
+#include "game/marble/marble.h"
 #ifdef TORQUE_TERRAIN
 #include "terrain/terrData.h"
 #include "terrain/terrRender.h"
@@ -161,11 +163,11 @@ static bool initLibraries()
     ResManager::create();
 
     // Register known file types here
-    ResourceManager->registerExtension(".jpg", constructBitmapJPEG);
+    ResourceManager->registerExtension(".jpg", constructBitmapJPEG, true);
     ResourceManager->registerExtension(".png", constructBitmapPNG);
     ResourceManager->registerExtension(".gif", constructBitmapGIF);
-    ResourceManager->registerExtension(".dbm", constructBitmapDBM);
-    ResourceManager->registerExtension(".bmp", constructBitmapBMP);
+    ResourceManager->registerExtension(".dbm", constructBitmapDBM, true);
+    ResourceManager->registerExtension(".bmp", constructBitmapBMP, true);
     ResourceManager->registerExtension(".jng", constructBitmapMNG);
     //   ResourceManager->registerExtension(".gft", constructFont);
 #ifdef TORQUE_TERRAIN
@@ -217,6 +219,7 @@ static void shutdownLibraries()
 
     RedBook::destroy();
     TSShapeInstance::destroy();
+    Marble::shutdownPhysics();
     InteriorInstance::destroy();
 
     //TextureManager::preDestroy();
@@ -586,9 +589,15 @@ int DemoGame::main(int argc, const char** argv)
         PROFILE_START(TelDebuggerProcessMain);
         TelDebugger->process();
         PROFILE_END();
+        PROFILE_START(ResourcePreloadMain);
+        ResourceManager->processPreloads();
+        PROFILE_END();
         PROFILE_START(TimeManagerProcessMain);
         TimeManager::process(); // guaranteed to produce an event
         PROFILE_END();
+        PROFILE_START(NetFlushMain);
+        Net::flushSends();   // send this frame's packets
+        PROFILE_END();
         PROFILE_END();
     }
     shutdownGame();
@@ -744,6 +753,18 @@ void DemoGame::processConsoleEvent(ConsoleEvent* event)
 }
 
 /// Process a time event and update all sub-processes
+S32 DemoGame::getTimeUntilTick()
+{
+    if (gGamePaused || gTimeAdvance || gTimeScale <= 0.0f)
+        return -1;
+
+    // The server ticks each time its time crosses a multiple of TickMs,
+    // and its time moves at timeScale times real time.
+    SimTime lastTime = getCurrentServerProcessList()->getLastTime();
+    SimTime untilTick = TickMs - (lastTime & TickMask);
+    return S32(mCeil(untilTick / gTimeScale));
+}
+
 void DemoGame::processTimeEvent(TimeEvent* event)
 {
     PROFILE_START(ProcessTimeEvent);
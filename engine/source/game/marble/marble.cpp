@@ -19,8 +19,6 @@
 
 const float gMarbleCompressDists[7] = {5.0f, 11.0f, 23.0f, 47.0f, 96.0f, 195.0f, 500.0f};
 
-Point3F gMarbleMotionDir = Point3F(0, 0, 0);
-
 static U32 sTriggerItemMask = ItemObjectType | TriggerObjectType;
 static U32 sCameraCollisionMask = InteriorObjectType | StaticShapeObjectType;
 
@@ -30,9 +28,8 @@ IMPLEMENT_CO_NETOBJECT_V1(Marble);
 
 U32 Marble::smEndPadId = 0;
 SimObjectPtr<StaticShape> Marble::smEndPad = NULL;
-Vector<PathedInterior*> Marble::smPathItrVec;
-Vector<Marble*> Marble::marbles;
-ConcretePolyList Marble::polyList;
+bool Marble::smParallelPhysics = false;
+S32 Marble::smPhysicsThreads = 3;
 
 #ifdef MB_PHYSICS_SWITCHABLE
 bool Marble::smTrapLaunch = false;
@@ -141,6 +138,16 @@ Marble::Marble()
     mCameraInit = false;
     mNetSmoothPos = Point3F(0, 0, 0);
 
+    mMarbleAxisSet = false;
+    mWorkGravityDir = Point3F(0, 0, -1);
+    mMarbleSideDir = Point3F(1, 0, 0);
+    mMarbleMotionDir = Point3F(0, 1, 0);
+
+    mTickMove = &NullMove;
+    mTickStartPos = Point3F(0, 0, 0);
+    mTickContactPct = 0.0f;
+    mTickSlipAmount = 0.0f;
+
     mRadsLeftToCenter = 0.0f;
     mCenteringCamera = false;
 
@@ -184,6 +191,9 @@ void Marble::consoleInit()
 #ifdef MB_PHYSICS_SWITCHABLE
     Con::addVariable("Pref::Marble::EnableTrapLaunch", TypeBool, &Marble::smTrapLaunch);
 #endif
+
+    Con::addVariable("Marble::parallelPhysics", TypeBool, &Marble::smParallelPhysics);
+    Con::addVariable("Marble::physicsThreads", TypeS32, &Marble::smPhysicsThreads);
 }
 
 //----------------------------------------------------------------------------
@@ -208,6 +218,16 @@ Marble::EndPadEffect::EndPadEffect()
     // Empty
 }
 
+Marble::CollisionWorkingSet::CollisionWorkingSet()
+{
+    box.min.set(0, 0, 0);
+    box.max.set(0, 0, 0);
+    mask = 0;
+    revalidate = false;
+    rebuild = true;
+    parallelStep = false;
+}
+
 Marble::PowerUpState::PowerUpState()
 {
     emitter = NULL;
@@ -1171,14 +1191,18 @@ bool Marble::updatePadState()
         float in_rRadius;
         in_rRadius = (box.max - boxCenter).len();
         SphereF sphere(boxCenter, in_rRadius);
+        // The pad polys replace whatever the collision working set held,
+        // so force the next findObjectsAndPolys to rebuild it.
+        ConcretePolyList& polyList = mCollision.polyList;
+        mCollision.invalidate();
         polyList.clear();
-        mPadPtr->buildPolyList(&Marble::polyList, box, sphere);
+        mPadPtr->buildPolyList(&polyList, box, sphere);
         if (!polyList.mPolyList.empty())
         {
             int i = 0;
-            for (i = 0; i < Marble::polyList.mPolyList.size(); i++) 
+            for (i = 0; i < polyList.mPolyList.size(); i++) 
             {
-                auto& poly = Marble::polyList.mPolyList[i];
+                auto& poly = polyList.mPolyList[i];
 
                 if (mDot(poly.plane, upDir * -10) < 0.0)
                 {
@@ -1187,7 +1211,7 @@ bool Marble::updatePadState()
                         break;
                 }
             }
-            if (i >= Marble::polyList.mPolyList.size()) 
+            if (i >= polyList.mPolyList.size()) 
             {
                 this->mOnPad = false;
                 result = false;
@@ -1991,6 +2015,13 @@ void Marble::setPowerUpId(U32 id, bool reset)
 }
 
 void Marble::processTick(const Move* move)
+{
+    preparePhysicsTick(move);
+    advancePhysics(mTickMove, TickMs);
+    finishPhysicsTick();
+}
+
+void Marble::preparePhysicsTick(const Move* move)
 {
     Parent::processTick(move);
 
@@ -2050,13 +2081,16 @@ void Marble::processTick(const Move* move)
     processMoveTriggers(newMove);
     processCameraMove(newMove);
 
-    Point3F startPos(mPosition.x, mPosition.y, mPosition.z);
-
-    advancePhysics(newMove, TickMs);
+    mTickMove = newMove;
+    mTickStartPos.set(mPosition.x, mPosition.y, mPosition.z);
+}
 
+void Marble::finishPhysicsTick()
+{
+    const Move* newMove = mTickMove;
     Point3F endPos(mPosition.x, mPosition.y, mPosition.z);
 
-    processItemsAndTriggers(startPos, endPos);
+    processItemsAndTriggers(mTickStartPos, endPos);
     updatePowerups();
 
     if (mPadPtr)
@@ -30,11 +30,6 @@
 #include <game/staticShape.h>
 #endif
 
-extern Point3F gMarbleMotionDir;
-extern bool gMarbleAxisSet;
-extern Point3F gWorkGravityDir;
-extern Point3F gMarbleSideDir;
-
 // These might be useful later
 //#include <cmath>
 //#define CheckNAN(c) { if(isnan(c)) __debugbreak(); }
@@ -46,6 +41,7 @@ extern Point3F gMarbleSideDir;
 //#define CheckNANAngp(c) { CheckNAN(c->axis.x) CheckNAN(c->axis.y) CheckNAN(c->axis.z) CheckNAN(c->angle) }
 
 class MarbleData;
+class ThreadPool;
 
 class Marble : public ShapeBase
 {
@@ -82,8 +78,7 @@ private:
         PowerUpMask = Parent::NextFreeMask << 2,
         GravityMask = Parent::NextFreeMask << 3,
         GravitySnapMask = Parent::NextFreeMask << 4,
-        OOBMask = Parent::NextFreeMask << 5,
-        NextFreeMask = Parent::NextFreeMask << 6
+        OOBMask = Parent::NextFreeMask << 5
     };
 
     struct Contact
@@ -143,6 +138,42 @@ private:
         NetObject* object;
     };
 
+    struct QueuedCollision
+    {
+        ShapeBase* object;
+        VectorF vector;
+        U32 surfaceId;
+    };
+
+    struct CollisionWorkingSet
+    {
+        struct CachedObject
+        {
+            SceneObject* object;
+            MatrixF transform;
+            Box3F worldBox;
+            bool animated;
+        };
+
+        Box3F box;
+        U32 mask;
+        bool revalidate;
+        bool rebuild;
+        SimpleQueryList queryList;
+        Vector<CachedObject> objects;
+        ConcretePolyList polyList;
+        Vector<Marble*> marbles;
+        Vector<Marble::MaterialCollision> materialCollisions;
+        Vector<Marble::QueuedCollision> queuedCollisions;
+        bool parallelStep;
+
+        CollisionWorkingSet();
+        void invalidate();
+        bool objectsUnchanged() const;
+        void cacheObjects();
+        static bool isAnimated(SceneObject* obj);
+    };
+
     struct PowerUpState
     {
         bool active;
@@ -215,6 +246,16 @@ private:
     Point3F mShadowPoints[33];
     bool mShadowGenerated;
     MatInstance* mStencilMaterial;
+    Marble::CollisionWorkingSet mCollision;
+    Vector<PathedInterior*> mPathItrVec;
+    bool mMarbleAxisSet;
+    Point3F mWorkGravityDir;
+    Point3F mMarbleSideDir;
+    Point3F mMarbleMotionDir;
+    const Move* mTickMove;
+    Point3F mTickStartPos;
+    F32 mTickContactPct;
+    F32 mTickSlipAmount;
 
 public:
     DECLARE_CONOBJECT(Marble);
@@ -297,6 +338,9 @@ public:
     void processItemsAndTriggers(const Point3F& startPos, const Point3F& endPos);
     void setPowerUpId(U32 id, bool reset);
     virtual void processTick(const Move* move);
+    void preparePhysicsTick(const Move* move);
+    void finishPhysicsTick();
+    const Move* getTickMove() const { return mTickMove; }
 
     // Marble Physics
     Point3D getVelocityD() const;
@@ -311,10 +355,19 @@ public:
     void velocityCancel(bool surfaceSlide, bool noBounce, bool& bouncedYet, bool& stoppedPaths, Vector<PathedInterior*>& pitrVec);
     Point3D getExternalForces(const Move* move, F64 timeStep);
     void advancePhysics(const Move* move, U32 timeDelta);
+    void stepPhysics(const Move* move, U32 timeDelta);
+    void commitPhysics(U32 timeDelta);
+    void getPhysicsBox(U32 timeDelta, Box3F& box);
+    void getIndependenceBox(Box3F& box);
+    bool touchesOnlyStatic(const Box3F& box);
+    static void stepPhysicsBatch(const Vector<Marble*>& batch);
+    static void shutdownPhysics();
 
     // Marble Collision
     void clearObjectsAndPolys();
     void findObjectsAndPolys(U32 collisionMask, const Box3F& testBox, bool testPIs);
+    void queueMarbleCollision(ShapeBase* obj, const VectorF& vec, U32 surfaceId);
+    void flushMarbleCollisions();
     bool testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radius, U32 collisionMask, bool testPIs);
     void findContacts(U32 contactMask, const Point3D* inPos, const F32* inRad);
     void computeFirstPlatformIntersect(F64& dt, Vector<PathedInterior*>& pitrVec);
@@ -334,9 +387,8 @@ public:
 
     static U32 smEndPadId;
     static SimObjectPtr<StaticShape> smEndPad;
-    static Vector<PathedInterior*> smPathItrVec;
-    static Vector<Marble*> marbles;
-    static ConcretePolyList polyList;
+    static bool smParallelPhysics;
+    static S32 smPhysicsThreads;
 
 #ifdef MB_PHYSICS_SWITCHABLE
     static bool smTrapLaunch;
@@ -346,9 +398,14 @@ private:
     virtual void setTransform(const MatrixF& mat);
     void renderShadowVolumes(SceneState* state);
 
+    static ThreadPool* smPhysicsPool;
+    static void* smContainerMutex;
+    static void stepPhysicsWork(void* data, U32 index);
+
     // Marble Collision
     bool pointWithinPoly(const ConcretePolyList::Poly& poly, const Point3F& point);
     bool pointWithinPolyZ(const ConcretePolyList::Poly& poly, const Point3F& point, const Point3F& upDir);
+    void buildObjectsAndPolys(const SphereF& sphere, bool testPIs);
 };
 
 class MarbleData : public ShapeBaseData
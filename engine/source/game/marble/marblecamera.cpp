@@ -311,9 +311,9 @@ void Marble::resetPlatformsForCamera()
     float backDelta = gClientProcessList.getLastDelta();
 #endif
 
-    for (S32 i = 0; i < smPathItrVec.size(); i++)
+    for (S32 i = 0; i < mPathItrVec.size(); i++)
     {
-        PathedInterior* pathedInterior = smPathItrVec[i];
+        PathedInterior* pathedInterior = mPathItrVec[i];
 
         pathedInterior->popTickState();
         pathedInterior->interpolateTick(backDelta);
@@ -346,7 +346,7 @@ void Marble::getOOBCamera(MatrixF* mat)
 
 void Marble::setPlatformsForCamera(const Point3F& marblePos, const Point3F& startCam, const Point3F& endCam)
 {
-    smPathItrVec.clear();
+    mPathItrVec.clear();
 
     Box3F camBox = mObjBox;
     camBox.min = marblePos + camBox.min;
@@ -376,7 +376,7 @@ void Marble::setPlatformsForCamera(const Point3F& marblePos, const Point3F& star
             i->pushTickState();
             i->interpolateTick(delta);
             i->setTransform(i->getRenderTransform());
-            smPathItrVec.push_back(i);
+            mPathItrVec.push_back(i);
         }
     }
 }
@@ -7,19 +7,102 @@
 
 #include "materials/material.h"
 #include "math/mathUtils.h"
+#include "platform/platformMutex.h"
 
 //----------------------------------------------------------------------------
 
-static Box3F sgLastCollisionBox;
-static U32 sgLastCollisionMask;
-static bool sgResetFindObjects;
-static U32 sgCountCalls;
+void Marble::CollisionWorkingSet::invalidate()
+{
+    rebuild = true;
+    box.min.set(0, 0, 0);
+    box.max.set(0, 0, 0);
+}
+
+bool Marble::CollisionWorkingSet::objectsUnchanged() const
+{
+    // queryList holds a fresh container query over the cached box; the
+    // polys are still good if it found exactly the objects we built from
+    // and none of them have moved or animated since.
+    if (queryList.mList.size() != objects.size())
+        return false;
+
+    for (S32 i = 0; i < objects.size(); i++)
+    {
+        const CachedObject& cached = objects[i];
+        SceneObject* obj = queryList.mList[i];
+        if (obj != cached.object)
+            return false;
+
+        // Marbles are tested live and never contribute polys
+        if ((obj->getTypeMask() & PlayerObjectType) != 0)
+            continue;
+
+        const Box3F& worldBox = obj->getWorldBox();
+        if (worldBox.min != cached.worldBox.min || worldBox.max != cached.worldBox.max)
+            return false;
+
+        if (dMemcmp(&obj->getTransform(), &cached.transform, sizeof(MatrixF)) != 0)
+            return false;
+
+        // An animating shape (a trap door falling open) changes its collision
+        // in place, so it's rebuilt every tick, and once more after it stops.
+        if (cached.animated || isAnimated(obj))
+            return false;
+    }
+
+    return true;
+}
+
+bool Marble::CollisionWorkingSet::isAnimated(SceneObject* obj)
+{
+    if ((obj->getTypeMask() & ShapeBaseObjectType) == 0)
+        return false;
+    return static_cast<ShapeBase*>(obj)->hasScriptThreads();
+}
+
+void Marble::CollisionWorkingSet::cacheObjects()
+{
+    objects.setSize(queryList.mList.size());
+    for (S32 i = 0; i < queryList.mList.size(); i++)
+    {
+        SceneObject* obj = queryList.mList[i];
+        objects[i].object = obj;
+        objects[i].transform = obj->getTransform();
+        objects[i].worldBox = obj->getWorldBox();
+        objects[i].animated = isAnimated(obj);
+    }
+}
+
+void Marble::queueMarbleCollision(ShapeBase* obj, const VectorF& vec, U32 surfaceId)
+{
+    if (!mCollision.parallelStep)
+    {
+        queueCollision(obj, vec, surfaceId);
+        return;
+    }
+
+    // The collision timeout free list is shared between objects, so hold
+    // the collision until the physics step is committed.
+    mCollision.queuedCollisions.increment();
+    QueuedCollision& queued = mCollision.queuedCollisions.last();
+    queued.object = obj;
+    queued.vector = vec;
+    queued.surfaceId = surfaceId;
+}
+
+void Marble::flushMarbleCollisions()
+{
+    for (S32 i = 0; i < mCollision.queuedCollisions.size(); i++)
+    {
+        const QueuedCollision& queued = mCollision.queuedCollisions[i];
+        queueCollision(queued.object, queued.vector, queued.surfaceId);
+    }
+    mCollision.queuedCollisions.clear();
+}
 
 void Marble::clearObjectsAndPolys()
 {
-    sgResetFindObjects = true;
-	sgLastCollisionBox.min.set(0, 0, 0);
-	sgLastCollisionBox.max.set(0, 0, 0);
+    mCollision.invalidate();
 }
 
 bool Marble::pointWithinPoly(const ConcretePolyList::Poly& poly, const Point3F& point)
@@ -27,11 +110,12 @@ bool Marble::pointWithinPoly(const ConcretePolyList::Poly& poly, const Point3F&
     if (poly.vertexCount == 0)
         return true;
 
-    Point3F lastVert = Marble::polyList.mVertexList[Marble::polyList.mIndexList[poly.vertexStart + poly.vertexCount - 1]];
+    const ConcretePolyList& polyList = mCollision.polyList;
+    Point3F lastVert = polyList.mVertexList[polyList.mIndexList[poly.vertexStart + poly.vertexCount - 1]];
 
     for (int i = 0; i < poly.vertexCount; i++)
     {
-        Point3F& v = Marble::polyList.mVertexList[Marble::polyList.mIndexList[i + poly.vertexStart]];
+        const Point3F& v = polyList.mVertexList[polyList.mIndexList[i + poly.vertexStart]];
         PlaneF p(v + poly.plane, v, lastVert);
         lastVert = v;
         if (p.distToPlane(point) < 0.0f)
@@ -45,11 +129,12 @@ bool Marble::pointWithinPolyZ(const ConcretePolyList::Poly& poly, const Point3F&
     if (poly.vertexCount == 0)
         return true;
 
-    Point3F lastVert = Marble::polyList.mVertexList[Marble::polyList.mIndexList[poly.vertexStart + poly.vertexCount - 1]];
+    const ConcretePolyList& polyList = mCollision.polyList;
+    Point3F lastVert = polyList.mVertexList[polyList.mIndexList[poly.vertexStart + poly.vertexCount - 1]];
     
     for (int i = 0; i < poly.vertexCount; i++)
     {
-        Point3F& v = Marble::polyList.mVertexList[Marble::polyList.mIndexList[i + poly.vertexStart]];
+        const Point3F& v = polyList.mVertexList[polyList.mIndexList[i + poly.vertexStart]];
         PlaneF p(v + upDir, v, lastVert);
         lastVert = v;
         if (p.distToPlane(point) < -0.003f)
@@ -58,48 +143,88 @@ bool Marble::pointWithinPolyZ(const ConcretePolyList::Poly& poly, const Point3F&
     return true;
 }
 
+void Marble::buildObjectsAndPolys(const SphereF& sphere, bool testPIs)
+{
+    CollisionWorkingSet& ws = mCollision;
+
+    ws.polyList.clear();
+    ws.marbles.clear();
+
+    for (S32 i = 0; i < ws.queryList.mList.size(); i++)
+    {
+        SceneObject* obj = ws.queryList.mList[i];
+
+        if ((obj->getTypeMask() & PlayerObjectType) == 0)
+        {
+            if (testPIs || !dynamic_cast<PathedInterior*>(obj))
+                obj->buildPolyList(&ws.polyList, ws.box, sphere);
+        } else if (obj != this)
+        {
+            ws.marbles.push_back(reinterpret_cast<Marble*>(obj));
+        }
+    }
+
+    ws.cacheObjects();
+}
+
 void Marble::findObjectsAndPolys(U32 collisionMask, const Box3F& testBox, bool testPIs)
 {
-    if (collisionMask != sgLastCollisionMask || !sgLastCollisionBox.isContained(testBox) || sgResetFindObjects || !smPathItrVec.empty())
+    CollisionWorkingSet& ws = mCollision;
+
+    bool movingPlatforms = !mPathItrVec.empty();
+    bool contained = collisionMask == ws.mask && ws.box.isContained(testBox);
+
+    if (contained && !ws.rebuild && !movingPlatforms)
     {
-        ++sgCountCalls;
-		if (sgResetFindObjects || !smPathItrVec.empty())
-		{
-			sgLastCollisionBox.min = testBox.min - 0.5f;
-			sgLastCollisionBox.max = testBox.max + 0.5f;
-		} else
-		{
-			sgLastCollisionBox.min.setMin(testBox.min - 0.5f);
-		    sgLastCollisionBox.max.setMax(testBox.max + 0.5f);
-		}
+        if (!ws.revalidate)
+            return;
+
+        // Start of a new tick.  Re-run the (cheap) container query over the
+        // box we already have polys for and keep them if nothing nearby moved.
+        MutexHandle handle;
+        if (ws.parallelStep)
+            handle.lock(smContainerMutex);
+
+        ws.revalidate = false;
+        ws.queryList.mList.clear();
+        mContainer->findObjects(ws.box, collisionMask, SimpleQueryList::insertionCallback, &ws.queryList);
+        if (ws.objectsUnchanged())
+            return;
+
+        Point3D pos = (ws.box.max + ws.box.min) * 0.5f;
+        Point3F test = ws.box.max - ws.box.min;
+        SphereF sphere(pos, test.len() * 0.5f);
+        buildObjectsAndPolys(sphere, testPIs);
+        return;
+    }
 
-        sgLastCollisionMask = collisionMask;
-        sgResetFindObjects = false;
+    // Container queries and buildPolyList use shared scratch state, so
+    // marbles being stepped in parallel take turns here.
+    MutexHandle handle;
+    if (ws.parallelStep)
+        handle.lock(smContainerMutex);
 
-		Point3D pos = (sgLastCollisionBox.max + sgLastCollisionBox.min) * 0.5f;
-		Point3F test = sgLastCollisionBox.max - sgLastCollisionBox.min;
-		SphereF sphere(pos, test.len() * 0.5f);
-		
-		static SimpleQueryList sql;
-		sql.mList.clear();
-		mContainer->findObjects(sgLastCollisionBox, collisionMask, SimpleQueryList::insertionCallback, &sql);
-		polyList.clear();
-		marbles.clear();
-
-		for (S32 i = 0; i < sql.mList.size(); i++)
-		{
-		    SceneObject* obj = sql.mList[i];
-
-		    if ((sql.mList[i]->getTypeMask() & PlayerObjectType) == 0)
-		    {
-				if (testPIs || !dynamic_cast<PathedInterior*>(obj))
-				    obj->buildPolyList(&polyList, sgLastCollisionBox, sphere);
-		    } else if (obj != this)
-		    {
-		        marbles.push_back(reinterpret_cast<Marble*>(obj));
-		    }
-		}
+    if (ws.rebuild || ws.revalidate || movingPlatforms)
+    {
+        ws.box.min = testBox.min - 0.5f;
+        ws.box.max = testBox.max + 0.5f;
+    } else
+    {
+        ws.box.min.setMin(testBox.min - 0.5f);
+        ws.box.max.setMax(testBox.max + 0.5f);
     }
+
+    ws.mask = collisionMask;
+    ws.rebuild = false;
+    ws.revalidate = false;
+
+    Point3D pos = (ws.box.max + ws.box.min) * 0.5f;
+    Point3F test = ws.box.max - ws.box.min;
+    SphereF sphere(pos, test.len() * 0.5f);
+
+    ws.queryList.mList.clear();
+    mContainer->findObjects(ws.box, collisionMask, SimpleQueryList::insertionCallback, &ws.queryList);
+    buildObjectsAndPolys(sphere, testPIs);
 }
 
 bool Marble::testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radius, U32 collisionMask, bool testPIs)
@@ -113,6 +238,9 @@ bool Marble::testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radi
 	Point3D deltaPosition = velocity * deltaT;
 	Point3D finalPosition = position + deltaPosition;
 
+	ConcretePolyList& polyList = mCollision.polyList;
+	Vector<Marble*>& marbles = mCollision.marbles;
+
 	// If there is a collision mask
 	if (collisionMask != 0)
 	{
@@ -452,7 +580,7 @@ bool Marble::testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radi
             if ((contactPoly->object->getTypeMask() & ShapeBaseObjectType) != 0)
             {
                 Point3F objVelocity = contactPoly->object->getVelocity();
-                queueCollision((ShapeBase*)contactPoly->object, mVelocity - objVelocity, contactPoly->material);
+                queueMarbleCollision((ShapeBase*)contactPoly->object, mVelocity - objVelocity, contactPoly->material);
             }
         }
 
@@ -491,7 +619,9 @@ void Marble::findContacts(U32 contactMask, const Point3D* inPos, const F32* inRa
 {
     mContacts.clear();
 
-    static Vector<Marble::MaterialCollision> materialCollisions;
+    ConcretePolyList& polyList = mCollision.polyList;
+    Vector<Marble*>& marbles = mCollision.marbles;
+    Vector<Marble::MaterialCollision>& materialCollisions = mCollision.materialCollisions;
     materialCollisions.clear();
 
     F32 rad;
@@ -559,7 +689,7 @@ void Marble::findContacts(U32 contactMask, const Point3D* inPos, const F32* inRa
 				marbleContact->restitution = 1.0f;
 				marbleContact->force = 0.0f;
 
-				queueCollision(otherMarble, mVelocity - otherMarble->getVelocity(), 0);
+				queueMarbleCollision(otherMarble, mVelocity - otherMarble->getVelocity(), 0);
 			}
         }
     }
@@ -693,7 +823,7 @@ void Marble::findContacts(U32 contactMask, const Point3D* inPos, const F32* inRa
 					coll.object = NULL;
 					materialCollisions.push_back(coll);
 					Point3F offset(0, 0, 0);
-					queueCollision(reinterpret_cast<ShapeBase*>(gb), offset, materialId);
+					queueMarbleCollision(reinterpret_cast<ShapeBase*>(gb), offset, materialId);
 				}
 			}
 		}
@@ -751,6 +881,8 @@ void Marble::computeFirstPlatformIntersect(F64& dt, Vector<PathedInterior*>& pit
 
                     Point3F diff = itBox.max - boxCenter;
                     SphereF sphere(boxCenter, diff.len());
+                    ConcretePolyList& polyList = mCollision.polyList;
+                    mCollision.invalidate();
                     polyList.clear();
                     it->buildPolyList(&polyList, itBox, sphere);
 
@@ -764,12 +896,10 @@ void Marble::computeFirstPlatformIntersect(F64& dt, Vector<PathedInterior*>& pit
 
 void Marble::resetObjectsAndPolys(U32 collisionMask, const Box3F& testBox)
 {
-    sgLastCollisionBox.min.set(0, 0, 0);
-    sgLastCollisionBox.max.set(0, 0, 0);
-
-    sgResetFindObjects = true;
-    sgCountCalls = 0;
+    // Keep the working set from the last tick, but have the next query check
+    // that nothing inside it has moved before trusting the cached polys.
+    mCollision.revalidate = true;
 
-    if (smPathItrVec.empty())
+    if (mPathItrVec.empty())
         findObjectsAndPolys(collisionMask, testBox, false);
 }
@@ -5,6 +5,10 @@
 
 #include "marble.h"
 #include "sfx/sfxSystem.h"
+#include "core/threadPool.h"
+#include "platform/platformMutex.h"
+#include "platform/profiler.h"
+#include "sim/processList.h"
 
 //----------------------------------------------------------------------------
 
@@ -22,12 +26,11 @@ static U32 sContactMask = StaticObjectType |
                           StaticShapeObjectType |
                           PlayerObjectType;
 
-bool gMarbleAxisSet = false;
-Point3F gWorkGravityDir;
-Point3F gMarbleSideDir;
-
 #define SurfaceDotThreshold 0.0001
 
+ThreadPool* Marble::smPhysicsPool = NULL;
+void* Marble::smContainerMutex = NULL;
+
 Point3D Marble::getVelocityD() const
 {
     return mVelocity;
@@ -55,8 +58,8 @@ void Marble::applyImpulse(const Point3F& pos, const Point3F& vec)
 
 void Marble::clearMarbleAxis()
 {
-    gMarbleAxisSet = false;
-    mGravityFrame.mulP(Point3F(0.0f, 0.0f, -1.0f), &gWorkGravityDir);
+    mMarbleAxisSet = false;
+    mGravityFrame.mulP(Point3F(0.0f, 0.0f, -1.0f), &mWorkGravityDir);
 }
 
 void Marble::applyContactForces(const Move* move, bool isCentered, Point3D& aControl, const Point3D& desiredOmega, F64 timeStep, Point3D& A, Point3D& a, F32& slipAmount)
@@ -158,7 +161,7 @@ void Marble::applyContactForces(const Move* move, bool isCentered, Point3D& aCon
 
         if (!slipping)
         {
-            Point3D R = -gWorkGravityDir * mRadius;
+            Point3D R = -mWorkGravityDir * mRadius;
             Point3D aadd = mCross(R, A) / R.lenSquared();
 
             if (isCentered)
@@ -200,7 +203,7 @@ void Marble::applyContactForces(const Move* move, bool isCentered, Point3D& aCon
 
 void Marble::getMarbleAxis(Point3D& sideDir, Point3D& motionDir, Point3D& upDir)
 {
-    if (!gMarbleAxisSet)
+    if (!mMarbleAxisSet)
     {
         MatrixF camMat;
         mGravityFrame.setMatrix(&camMat);
@@ -215,21 +218,21 @@ void Marble::getMarbleAxis(Point3D& sideDir, Point3D& motionDir, Point3D& upDir)
         camMat.mul(zRot);
         camMat.mul(xRot);
 
-        gMarbleMotionDir.x = camMat[1];
-        gMarbleMotionDir.y = camMat[5];
-        gMarbleMotionDir.z = camMat[9];
+        mMarbleMotionDir.x = camMat[1];
+        mMarbleMotionDir.y = camMat[5];
+        mMarbleMotionDir.z = camMat[9];
 
-        mCross(gMarbleMotionDir, -gWorkGravityDir, gMarbleSideDir);
-        m_point3F_normalize(&gMarbleSideDir.x);
+        mCross(mMarbleMotionDir, -mWorkGravityDir, mMarbleSideDir);
+        m_point3F_normalize(&mMarbleSideDir.x);
         
-        mCross(-gWorkGravityDir, gMarbleSideDir, gMarbleMotionDir);
+        mCross(-mWorkGravityDir, mMarbleSideDir, mMarbleMotionDir);
         
-        gMarbleAxisSet = true;
+        mMarbleAxisSet = true;
     }
 
-    sideDir = gMarbleSideDir;
-    motionDir = gMarbleMotionDir;
-    upDir = -gWorkGravityDir;
+    sideDir = mMarbleSideDir;
+    motionDir = mMarbleMotionDir;
+    upDir = -mWorkGravityDir;
 }
 
 const Point3F& Marble::getMotionDir()
@@ -239,7 +242,7 @@ const Point3F& Marble::getMotionDir()
     Point3D up;
     Marble::getMarbleAxis(side, motion, up);
 
-    return gMarbleMotionDir;
+    return mMarbleMotionDir;
 }
 
 bool Marble::computeMoveForces(Point3D& aControl, Point3D& desiredOmega, const Move* move)
@@ -247,7 +250,7 @@ bool Marble::computeMoveForces(Point3D& aControl, Point3D& desiredOmega, const M
     aControl.set(0, 0, 0);
     desiredOmega.set(0, 0, 0);
 
-    Point3F invGrav = -gWorkGravityDir;
+    Point3F invGrav = -mWorkGravityDir;
 
     Point3D r = invGrav * mRadius;
 
@@ -481,10 +484,14 @@ Point3D Marble::getExternalForces(const Move* move, F64 timeStep)
     if ((mMode & MoveMode) == 0)
         return mVelocity * -16.0;
 
-    Point3D ret = gWorkGravityDir * mDataBlock->gravity * mPowerUpParams.gravityMod;
+    Point3D ret = mWorkGravityDir * mDataBlock->gravity * mPowerUpParams.gravityMod;
 
     Box3F marbleBox(mPosition - mDataBlock->maxForceRadius, mPosition + mDataBlock->maxForceRadius);
 
+    MutexHandle handle;
+    if (mCollision.parallelStep)
+        handle.lock(smContainerMutex);
+
     SimpleQueryList sql;
     mContainer->findObjects(marbleBox, ForceObjectType, SimpleQueryList::insertionCallback, &sql);
 
@@ -497,6 +504,9 @@ Point3D Marble::getExternalForces(const Move* move, F64 timeStep)
         if (obj != this)
             obj->getForce(position, &force);
     }
+
+    if (mCollision.parallelStep)
+        handle.unlock();
     
     ret += force / getMass();
 
@@ -548,24 +558,36 @@ Point3D Marble::getExternalForces(const Move* move, F64 timeStep)
     return ret;
 }
 
-void Marble::advancePhysics(const Move* move, U32 timeDelta)
+void Marble::getPhysicsBox(U32 timeDelta, Box3F& box)
 {
-    dMemcpy(&delta.posVec, &mPosition, sizeof(delta.posVec));
-
-    smPathItrVec.clear();
-
     F32 dt = timeDelta / 1000.0;
 
-    Box3F extrudedMarble = this->mWorldBox;
+    box = this->mWorldBox;
 
     Point3F velocityExpansion = (mVelocity * dt) * 1.100000023841858;
     Point3F absVelocityExpansion = velocityExpansion.abs();
 
-    extrudedMarble.min += (velocityExpansion - absVelocityExpansion) * 0.5f;
-    extrudedMarble.max += (velocityExpansion + absVelocityExpansion) * 0.5f;
+    box.min += (velocityExpansion - absVelocityExpansion) * 0.5f;
+    box.max += (velocityExpansion + absVelocityExpansion) * 0.5f;
+
+    box.min -= dt * 25.0;
+    box.max += dt * 25.0;
+}
 
-    extrudedMarble.min -= dt * 25.0;
-    extrudedMarble.max += dt * 25.0;
+void Marble::advancePhysics(const Move* move, U32 timeDelta)
+{
+    stepPhysics(move, timeDelta);
+    commitPhysics(timeDelta);
+}
+
+void Marble::stepPhysics(const Move* move, U32 timeDelta)
+{
+    dMemcpy(&delta.posVec, &mPosition, sizeof(delta.posVec));
+
+    mPathItrVec.clear();
+
+    Box3F extrudedMarble;
+    getPhysicsBox(timeDelta, extrudedMarble);
 
     for (PathedInterior* obj = PathedInterior::getPathedInteriors(this); ; obj = obj->getNext())
     {
@@ -576,7 +598,7 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
         {
             obj->pushTickState();
             obj->computeNextPathStep(timeDelta);
-            smPathItrVec.push_back(obj);
+            mPathItrVec.push_back(obj);
         }
     }
 
@@ -611,7 +633,7 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
         findContacts(sContactMask, NULL, NULL);
 
         bool stoppedPaths = false;
-        velocityCancel(isCentered, false, bouncedYet, stoppedPaths, smPathItrVec);
+        velocityCancel(isCentered, false, bouncedYet, stoppedPaths, mPathItrVec);
         Point3D A = getExternalForces(move, timeStep);
 
         Point3D a(0, 0, 0);
@@ -629,10 +651,10 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
 #endif
         }
 
-        velocityCancel(isCentered, true, bouncedYet, stoppedPaths, smPathItrVec);
+        velocityCancel(isCentered, true, bouncedYet, stoppedPaths, mPathItrVec);
 
         F64 moveTime = timeStep;
-        computeFirstPlatformIntersect(moveTime, smPathItrVec);
+        computeFirstPlatformIntersect(moveTime, mPathItrVec);
         testMove(mVelocity, mPosition, moveTime, mRadius, sCollisionMask, false);
         //mPosition += mVelocity * moveTime;
 
@@ -664,9 +686,9 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
 
         timeStep = (startTime - timeRemaining) * 1000.0;
 
-        for (S32 i = 0; i < smPathItrVec.size(); i++)
+        for (S32 i = 0; i < mPathItrVec.size(); i++)
         {
-            PathedInterior* pint = smPathItrVec[i];
+            PathedInterior* pint = mPathItrVec[i];
             pint->resetTickState(false);
             pint->advance(timeStep);
         }
@@ -678,15 +700,21 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
     } while (it <= 10);
 #endif
 
-    for (S32 i = 0; i < smPathItrVec.size(); i++)
-        smPathItrVec[i]->popTickState();
+    for (S32 i = 0; i < mPathItrVec.size(); i++)
+        mPathItrVec[i]->popTickState();
+
+    mTickContactPct = contactTime * 1000.0 / timeDelta;
+    mTickSlipAmount = slipAmount;
+}
 
-    F32 contactPct = contactTime * 1000.0 / timeDelta;
+void Marble::commitPhysics(U32 timeDelta)
+{
+    flushMarbleCollisions();
 
-    Con::setFloatVariable("testCount", contactPct);
+    Con::setFloatVariable("testCount", mTickContactPct);
     Con::setFloatVariable("marblePitch", mMouseY);
 
-    updateRollSound(contactPct, slipAmount);
+    updateRollSound(mTickContactPct, mTickSlipAmount);
 
     dMemcpy(&delta.pos, &mPosition, sizeof(Point3D));
 
@@ -695,6 +723,199 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
     setPosition(mPosition, false);
 }
 
+//----------------------------------------------------------------------------
+
+void Marble::stepPhysicsWork(void* data, U32 index)
+{
+    Marble* marble = reinterpret_cast<Marble**>(data)[index];
+    marble->stepPhysics(marble->mTickMove, TickMs);
+}
+
+void Marble::getIndependenceBox(Box3F& box)
+{
+    getPhysicsBox(TickMs, box);
+
+    // The collision test boxes grow half a unit past the physics box,
+    // and a cached working set may cover more than that.
+    box.min -= 0.5f;
+    box.max += 0.5f;
+    if (mCollision.mask != 0)
+    {
+        box.min.setMin(mCollision.box.min);
+        box.max.setMax(mCollision.box.max);
+    }
+}
+
+bool Marble::touchesOnlyStatic(const Box3F& box)
+{
+    for (PathedInterior* pitr = PathedInterior::getPathedInteriors(this); pitr; pitr = pitr->getNext())
+    {
+        if (box.isOverlapped(pitr->getExtrudedBox()))
+            return false;
+    }
+
+    SimpleQueryList sql;
+    mContainer->findObjects(box, PlayerObjectType, SimpleQueryList::insertionCallback, &sql);
+    for (S32 i = 0; i < sql.mList.size(); i++)
+    {
+        if (sql.mList[i] != this)
+            return false;
+    }
+
+    return true;
+}
+
+void Marble::stepPhysicsBatch(const Vector<Marble*>& batch)
+{
+    // Only for marbles that passed touchesOnlyStatic() after
+    // preparePhysicsTick(), and whose boxes don't overlap each other.  Stepping only reads shared state (container
+    // queries are serialized through smContainerMutex) and queued collisions
+    // are held back, so the caller must commitPhysics() each marble after.
+    if (smPhysicsPool && smPhysicsPool->getNumThreads() != (U32)getMax(smPhysicsThreads, 0))
+    {
+        delete smPhysicsPool;
+        smPhysicsPool = NULL;
+    }
+    if (!smPhysicsPool)
+        smPhysicsPool = new ThreadPool(getMax(smPhysicsThreads, 0));
+    if (!smContainerMutex)
+        smContainerMutex = Mutex::createMutex();
+
+    for (S32 i = 0; i < batch.size(); i++)
+        batch[i]->mCollision.parallelStep = true;
+
+    smPhysicsPool->parallelFor(stepPhysicsWork, batch.address(), batch.size());
+
+    for (S32 i = 0; i < batch.size(); i++)
+        batch[i]->mCollision.parallelStep = false;
+}
+
+void Marble::shutdownPhysics()
+{
+    delete smPhysicsPool;
+    smPhysicsPool = NULL;
+
+    if (smContainerMutex)
+    {
+        Mutex::destroyMutex(smContainerMutex);
+        smContainerMutex = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+// ProcessList marble runs, see ProcessList::advanceObjects()
+bool ProcessList::advanceMarbleRun(ProcessObject& list)
+{
+    if (!Marble::smParallelPhysics)
+        return false;
+
+    // Collect the run of marbles at the front of the list.  Only a
+    // contiguous run is batched so that every other object still sees
+    // the marbles exactly as it would when ticking serially.
+    Vector<SimObjectPtr<Marble> > run;
+    for (ProcessObject* pobj = list.mProcessLink.next; pobj != &list; pobj = pobj->mProcessLink.next)
+    {
+        Marble* marble = dynamic_cast<Marble*>(getGameBase(pobj));
+        if (!marble)
+            break;
+        run.push_back(marble);
+    }
+
+    if (run.size() < 2)
+        return false;
+
+    PROFILE_START(AdvanceMarbleRun);
+
+    for (S32 i = 0; i < run.size(); i++)
+    {
+        Marble* marble = run[i];
+        marble->plUnlink();
+        marble->plLinkBefore(&mHead);
+    }
+
+    // Marbles are ticked in process order.  A marble whose box, built after
+    // preparePhysicsTick() has applied its impulses, touches nothing but
+    // static geometry and no other pending marble waits to be stepped with
+    // the others; anything else flushes the pending marbles first and then
+    // finishes its own tick alone.  The steps, commits and callbacks all
+    // happen in process order; only preparePhysicsTick() of a pending marble
+    // runs ahead of the steps of the marbles pending before it.
+    Vector<Move*> moves;
+    Vector<GameConnection*> cons;
+    Vector<Box3F> boxes;
+    Vector<S32> pending;
+    moves.setSize(run.size());
+    cons.setSize(run.size());
+    boxes.setSize(run.size());
+
+    for (S32 i = 0; i < run.size(); i++)
+    {
+        if (!takeMarbleMove(run[i], moves[i], cons[i]))
+            continue;
+
+        run[i]->preparePhysicsTick(moves[i]);
+        if (run[i].isNull())
+        {
+            endMarbleMove(run[i], moves[i], cons[i]);
+            continue;
+        }
+
+        run[i]->getIndependenceBox(boxes[i]);
+        bool independent = run[i]->touchesOnlyStatic(boxes[i]);
+        for (S32 j = 0; j < pending.size() && independent; j++)
+            independent = !boxes[i].isOverlapped(boxes[pending[j]]);
+
+        if (independent)
+        {
+            pending.push_back(i);
+            continue;
+        }
+
+        finishMarbleRun(run, pending, moves, cons);
+
+        if (!run[i].isNull())
+            run[i]->advancePhysics(run[i]->getTickMove(), TickMs);
+        if (!run[i].isNull())
+            run[i]->finishPhysicsTick();
+        endMarbleMove(run[i], moves[i], cons[i]);
+    }
+
+    finishMarbleRun(run, pending, moves, cons);
+
+    PROFILE_END();
+    return true;
+}
+
+void ProcessList::finishMarbleRun(Vector<SimObjectPtr<Marble> >& run, Vector<S32>& pending,
+                                  Vector<Move*>& moves, Vector<GameConnection*>& cons)
+{
+    if (pending.empty())
+        return;
+
+    // Script run by a later marble's preparePhysicsTick() may have
+    // deleted one of these.
+    Vector<Marble*> batch;
+    for (S32 i = 0; i < pending.size(); i++)
+    {
+        if (!run[pending[i]].isNull())
+            batch.push_back(run[pending[i]]);
+    }
+
+    Marble::stepPhysicsBatch(batch);
+
+    for (S32 i = 0; i < pending.size(); i++)
+    {
+        SimObjectPtr<Marble>& marble = run[pending[i]];
+        if (!marble.isNull())
+            marble->commitPhysics(TickMs);
+        if (!marble.isNull())
+            marble->finishPhysicsTick();
+        endMarbleMove(marble, moves[pending[i]], cons[pending[i]]);
+    }
+
+    pending.clear();
+}
+
 ConsoleMethod(Marble, setVelocityRot, bool, 3, 3, "(vel)")
 {
     Point3F rot;
@@ -2289,6 +2289,14 @@ void ShapeBase::playThreadDelayed(const ThreadCmd& cmd)
     mThreadCmd = cmd;
 }
 
+bool ShapeBase::hasScriptThreads() const
+{
+    for (U32 i = 0; i < MaxScriptThreads; i++)
+        if (mScriptThread[i].thread)
+            return true;
+    return false;
+}
+
 bool ShapeBase::setThreadDir(U32 slot, bool forward)
 {
     Thread& st = mScriptThread[slot];
@@ -2534,6 +2542,7 @@ void ShapeBase::prepBatchRender(SceneState* state, S32 mountedImageIndex)
             GFX->setWorldMatrix(mat);
 
             image.shapeInstance->animate();
+            image.shapeInstance->queueAnimate();
             image.shapeInstance->render();
         }
 
@@ -2553,6 +2562,7 @@ void ShapeBase::prepBatchRender(SceneState* state, S32 mountedImageIndex)
         bool serverobj = this->isServerObject();
 
         mShapeInstance->animate();
+        mShapeInstance->queueAnimate();
         mShapeInstance->render();
     }
 
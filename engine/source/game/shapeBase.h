@@ -1181,6 +1181,10 @@ public:
 
     void playThreadDelayed(const ThreadCmd& cmd);
 
+    /// True if any script thread has a sequence, in which case the shape's
+    /// collision can change without it moving.
+    bool hasScriptThreads() const;
+
     /// Toggle the thread as reversed or normal (For example, sidestep-right reversed is sidestep-left)
     /// @param   slot   Mount slot ID
     /// @param   forward   True if the animation is to be played normally
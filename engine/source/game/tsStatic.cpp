@@ -243,6 +243,7 @@ void TSStatic::renderObject(SceneState* state)
     GFX->setWorldMatrix(mat);
 
     mShapeInstance->animate();
+    mShapeInstance->queueAnimate();
     mShapeInstance->render();
 
     getCurrentClientSceneGraph()->getLightManager()->sgResetLights();
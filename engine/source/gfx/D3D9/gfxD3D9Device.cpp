@@ -456,6 +456,9 @@ void GFXD3D9Device::reacquireDefaultPoolResources()
 
    if(mTextureManager)
       mTextureManager->resurrect();
+
+   // Dynamic buffers were recreated empty.
+   mResetCount++;
 }
 
 //-----------------------------------------------------------------------------
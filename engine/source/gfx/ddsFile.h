@@ -50,7 +50,7 @@ struct DDSFile
         {
             // Free our mips!
             for (S32 i = 0; i < mMips.size(); i++)
-                delete[] mMips[i];
+                delete[] (U8*)mMips[i];
         }
 
         Vector<void*> mMips;
@@ -38,7 +38,7 @@ public:
     virtual void describeSelf(char* buffer, U32 sizeOfBuffer)
     {
         // We've got nothing
-        buffer[0] = NULL;
+        buffer[0] = '\0';
     }
 };
 
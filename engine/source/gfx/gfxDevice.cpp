@@ -71,6 +71,8 @@ GFXDevice::GFXDevice()
     mViewMatrix.identity();
     mProjectionMatrix.identity();
 
+    mResetCount = 0;
+
     for (int i = 0; i < WORLD_STACK_MAX; i++)
         mWorldMatrix[i].identity();
 
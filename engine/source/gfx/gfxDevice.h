@@ -240,6 +240,10 @@ protected:
     /// have operations performed on it.
     bool mInitialized;
 
+    /// Bumped whenever the device is reset and dynamic buffers come back
+    /// with undefined contents.
+    U32 mResetCount;
+
     /// This is called before this, or any other device, is deleted in the global destroy()
     /// method. It allows the device to clean up anything while everything is still valid.
     virtual void preDestroy() = 0;
@@ -257,6 +261,10 @@ public:
     /// initialize - create window, device, etc
     virtual void init(const GFXVideoMode& mode/*, PlatformWindow *window = NULL*/) = 0;
 
+    /// Number of device resets so far. Anything which fills a dynamic buffer
+    /// once and reuses it must refill it when this changes.
+    U32 getResetCount() const { return mResetCount; }
+
     virtual void activate() = 0;
     virtual void deactivate() = 0;
 
@@ -27,7 +27,7 @@ public:
     virtual void describeSelf(char* buffer, U32 sizeOfBuffer)
     {
         // We got nothing
-        buffer[0] = NULL;
+        buffer[0] = '\0';
     }
 };
 
@@ -1224,6 +1224,10 @@ void Interior::purgeLODData()
     mHullSurfaceIndices.clear();
     mCoordBinIndices.clear();
     mConvexHullEmitStrings.clear();
+    mHullBVH.nodes.clear();
+    mHullBVH.hullIndices.clear();
+    mCollisionFans.clear();
+    mCollisionFanIndices.clear();
     for (U32 i = 0; i < NumCoordBins * NumCoordBins; i++)
     {
         mCoordBins[i].binStart = 0;
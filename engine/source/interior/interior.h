@@ -248,8 +248,17 @@ public:
     bool buildLightPolyList(U32* lightSurfaces, U32* numLightSurfaces,
         const Box3F&, const MatrixF&, const Point3F&);
 
-    bool getIntersectingHulls(const Box3F&, U16* hulls, U32* numHulls);
-    bool getIntersectingVehicleHulls(const Box3F&, U16* hulls, U32* numHulls);
+    /// Find the hulls whose bounds overlap a box in interior space.  If
+    /// boxTests is given, the number of node and hull bounds tested is
+    /// added to it.
+    bool getIntersectingHulls(const Box3F&, U16* hulls, U32* numHulls, U32* boxTests = NULL);
+    bool getIntersectingVehicleHulls(const Box3F&, U16* hulls, U32* numHulls, U32* boxTests = NULL);
+
+    /// Same as getIntersectingHulls, but through the coord bins stored in the
+    /// file rather than the hull BVH.  Only kept around for comparison.
+    bool getBinnedHulls(const Box3F&, U16* hulls, U32* numHulls, U32* boxTests = NULL);
+
+    U32 getNumConvexHulls() const { return mConvexHulls.size(); }
 
 protected:
     bool castRay_r(const U16, const U16, const Point3F&, const Point3F&, RayInfo*);
@@ -583,6 +592,42 @@ protected:
         U32   binCount;
     };
 
+    /// A hull surface as buildPolyList feeds it to a poly list: the
+    /// surface's collision fan (or null surface's winding) as point indices
+    /// in mCollisionFanIndices.  One per entry in mHullSurfaceIndices.
+    struct CollisionFan {
+        U32   indexStart;
+        U32   material;
+        U16   planeIndex;
+        U16   indexCount;
+    };
+
+    /// Node of a bounding volume hierarchy over a hull list.  A leaf holds
+    /// hullCount entries of the BVH's hull index list from start.  An inner
+    /// node has hullCount 0; its first child directly follows it and its
+    /// second is at start.
+    struct HullBVHNode {
+        Box3F box;
+        U32   start;
+        U16   hullCount;
+    };
+
+    struct HullBVH {
+        Vector<HullBVHNode> nodes;
+        Vector<U16>         hullIndices;
+    };
+
+    enum HullBVHConstants {
+        HullBVHLeafSize = 4,
+        HullBVHMaxDepth = 64
+    };
+
+    /// Build a BVH over hulls by splitting at the median hull center along
+    /// the widest axis.
+    static void buildHullBVH(const Vector<ConvexHull>& hulls, HullBVH& bvh);
+    static bool queryHullBVH(const HullBVH& bvh, const Vector<ConvexHull>& hulls,
+        const Box3F& query, U16* outHulls, U32* numHulls, U32* boxTests);
+
     struct RenderNode
     {
         bool  exterior;
@@ -766,6 +811,9 @@ private:
     CoordBin                mCoordBins[NumCoordBins * NumCoordBins];
     Vector<U16>             mCoordBinIndices;
     U32                     mCoordBinMode;
+    HullBVH                 mHullBVH;                     // Note: not persisted, built on load
+    Vector<CollisionFan>    mCollisionFans;               // Note: not persisted, built on load
+    Vector<U32>             mCollisionFanIndices;         // Note: not persisted, built on load
 
     Vector<ConvexHull>      mVehicleConvexHulls;
     Vector<U8>              mVehicleConvexHullEmitStrings;
@@ -781,6 +829,7 @@ private:
     Vector<PlaneF>          mVehiclePlanes;
     Vector<U32>             mVehicleWindings;
     Vector<TriFan>          mVehicleWindingIndices;
+    HullBVH                 mVehicleHullBVH;              // Note: not persisted, built on load
 
     VectorPtr<InteriorSimpleMesh*> mStaticMeshes;
 
@@ -828,6 +877,7 @@ private:
 
 public:
     void collisionFanFromSurface(const Surface&, U32* fan, U32* numIndices) const;
+    void buildCollisionFans();
 private:
     void fullWindingFromSurface(const Surface&, U32* fan, U32* numIndices) const;
     bool projectClipAndBoundFan(U32 fanIndex, F64* pResult);
@@ -294,6 +294,45 @@ void Interior::fullWindingFromSurface(const Surface& rSurface, U32* fanIndices,
 }
 
 
+void Interior::buildCollisionFans()
+{
+    // Flatten the collision fan of every hull surface (or the winding of
+    // every null surface) into one table, so buildPolyList doesn't have to
+    // rework them on every query.
+    mCollisionFans.setSize(mHullSurfaceIndices.size());
+    mCollisionFanIndices.clear();
+
+    for (S32 i = 0; i < mHullSurfaceIndices.size(); i++)
+    {
+        CollisionFan& fan = mCollisionFans[i];
+        fan.indexStart = mCollisionFanIndices.size();
+
+        U32 surfaceIndex = mHullSurfaceIndices[i];
+        if (isNullSurfaceIndex(surfaceIndex))
+        {
+            const NullSurface& rSurface = mNullSurfaces[getNullSurfaceIndex(surfaceIndex)];
+            fan.material = 0;
+            fan.planeIndex = rSurface.planeIndex;
+            for (U32 k = 0; k < rSurface.windingCount; k++)
+                mCollisionFanIndices.push_back(mWindings[rSurface.windingStart + k]);
+        }
+        else
+        {
+            const Surface& rSurface = mSurfaces[surfaceIndex];
+            U32 fanVerts[32];
+            U32 numVerts;
+            collisionFanFromSurface(rSurface, fanVerts, &numVerts);
+
+            fan.material = rSurface.textureIndex;
+            fan.planeIndex = rSurface.planeIndex;
+            for (U32 k = 0; k < numVerts; k++)
+                mCollisionFanIndices.push_back(fanVerts[k]);
+        }
+
+        fan.indexCount = mCollisionFanIndices.size() - fan.indexStart;
+    }
+}
+
 bool Interior::castRay_r(const U16      node,
     const U16      planeIndex,
     const Point3F& s,
@@ -767,6 +806,8 @@ bool Interior::buildPolyList(AbstractPolyList* list,
     center *= 0.5f;
     toItr.setColumn(3, center); // (0,0,0) now goes where box center used to...
 
+    U32 numAccepted = 0;
+    U32 numFanIndices = 0;
     for (S32 i = 0; i < numHulls; i++)
     {
         const ConvexHull& hull = mConvexHulls[hulls[i]];
@@ -775,44 +816,70 @@ bool Interior::buildPolyList(AbstractPolyList* list,
             // oriented bounding boxes don't intersect...
             continue;
 
+        hulls[numAccepted++] = hulls[i];
         for (S32 j = 0; j < hull.surfaceCount; j++)
+            numFanIndices += mCollisionFans[j + hull.surfaceStart].indexCount;
+    }
+
+    if (numFanIndices == 0)
+    {
+        FrameAllocator::setWaterMark(waterMark);
+        return !list->isEmpty();
+    }
+
+    // Neighbouring fans share most of their points, so give each interior
+    // point one list point, however many fans use it, and hand them all to
+    // the list at once.
+    U32 hashSize = getNextPow2(numFanIndices * 2);
+    U32* hashKeys = (U32*)FrameAllocator::alloc(hashSize * sizeof(U32));
+    U32* hashSlots = (U32*)FrameAllocator::alloc(hashSize * sizeof(U32));
+    Point3F* points = (Point3F*)FrameAllocator::alloc(numFanIndices * sizeof(Point3F));
+    U32* fanSlots = (U32*)FrameAllocator::alloc(numFanIndices * sizeof(U32));
+    dMemset(hashKeys, 0xFF, hashSize * sizeof(U32));
+
+    U32 numPoints = 0;
+    U32 numSlots = 0;
+    for (U32 i = 0; i < numAccepted; i++)
+    {
+        const ConvexHull& hull = mConvexHulls[hulls[i]];
+        const CollisionFan* fan = &mCollisionFans[hull.surfaceStart];
+        for (S32 j = 0; j < hull.surfaceCount; j++, fan++)
         {
-            U32 surfaceIndex = mHullSurfaceIndices[j + hull.surfaceStart];
-            if (isNullSurfaceIndex(surfaceIndex))
+            const U32* fanIndices = &mCollisionFanIndices[fan->indexStart];
+            for (U32 k = 0; k < fan->indexCount; k++)
             {
-                // Is a NULL surface
-                const Interior::NullSurface& rSurface = mNullSurfaces[getNullSurfaceIndex(surfaceIndex)];
-                U32 array[32];
+                U32 pointIndex = fanIndices[k];
+                U32 h = (pointIndex * 2654435761U) & (hashSize - 1);
+                while (hashKeys[h] != pointIndex && hashKeys[h] != 0xFFFFFFFF)
+                    h = (h + 1) & (hashSize - 1);
 
-                list->begin(0, rSurface.planeIndex);
-                for (U32 k = 0; k < rSurface.windingCount; k++)
+                if (hashKeys[h] == 0xFFFFFFFF)
                 {
-                    array[k] = list->addPoint(mPoints[mWindings[rSurface.windingStart + k]].point);
-                    list->vertex(array[k]);
+                    hashKeys[h] = pointIndex;
+                    hashSlots[h] = numPoints;
+                    points[numPoints++] = mPoints[pointIndex].point;
                 }
-
-                list->plane(getFlippedPlane(rSurface.planeIndex));
-                list->end();
+                fanSlots[numSlots++] = hashSlots[h];
             }
-            else
-            {
-                const Interior::Surface& rSurface = mSurfaces[surfaceIndex];
-                U32 array[32];
-                U32 fanVerts[32];
-                U32 numVerts;
+        }
+    }
 
-                collisionFanFromSurface(rSurface, fanVerts, &numVerts);
+    U32* ids = (U32*)FrameAllocator::alloc(numPoints * sizeof(U32));
+    list->addPoints(points, numPoints, ids);
 
-                // MarbleBlast: Texture index is needed for friction information
-                list->begin(rSurface.textureIndex, rSurface.planeIndex);
-                for (U32 k = 0; k < numVerts; k++)
-                {
-                    array[k] = list->addPoint(mPoints[fanVerts[k]].point);
-                    list->vertex(array[k]);
-                }
-                list->plane(getFlippedPlane(rSurface.planeIndex));
-                list->end();
-            }
+    numSlots = 0;
+    for (U32 i = 0; i < numAccepted; i++)
+    {
+        const ConvexHull& hull = mConvexHulls[hulls[i]];
+        const CollisionFan* fan = &mCollisionFans[hull.surfaceStart];
+        for (S32 j = 0; j < hull.surfaceCount; j++, fan++)
+        {
+            // MarbleBlast: Texture index is needed for friction information
+            list->begin(fan->material, fan->planeIndex);
+            for (U32 k = 0; k < fan->indexCount; k++)
+                list->vertex(ids[fanSlots[numSlots++]]);
+            list->plane(getFlippedPlane(fan->planeIndex));
+            list->end();
         }
     }
 
@@ -1190,7 +1257,215 @@ bool Interior::scanZones(const Box3F& box,
 }
 
 
-bool Interior::getIntersectingHulls(const Box3F& query, U16* hulls, U32* numHulls)
+//--------------------------------------------------------------------------
+namespace {
+
+    struct HullBVHBuild
+    {
+        Vector<Box3F>   boxes;
+        Vector<Point3F> centers;
+    };
+
+    // Partially sort indices so that the nth has the center it would have
+    // if they were fully sorted along axis, with none greater before it and
+    // none less after it.
+    void selectHullCenter(const HullBVHBuild& build, U16* indices, S32 count, S32 nth, U32 axis)
+    {
+        S32 lo = 0;
+        S32 hi = count - 1;
+        while (lo < hi)
+        {
+            F32 pivot = build.centers[indices[(lo + hi) / 2]][axis];
+            S32 i = lo;
+            S32 j = hi;
+            while (i <= j)
+            {
+                while (build.centers[indices[i]][axis] < pivot)
+                    i++;
+                while (build.centers[indices[j]][axis] > pivot)
+                    j--;
+                if (i <= j)
+                {
+                    U16 temp = indices[i];
+                    indices[i] = indices[j];
+                    indices[j] = temp;
+                    i++;
+                    j--;
+                }
+            }
+
+            if (nth <= j)
+                hi = j;
+            else if (nth >= i)
+                lo = i;
+            else
+                break;
+        }
+    }
+
+} // namespace {}
+
+void Interior::buildHullBVH(const Vector<ConvexHull>& hulls, HullBVH& bvh)
+{
+    bvh.nodes.clear();
+    bvh.hullIndices.setSize(hulls.size());
+    if (hulls.empty())
+        return;
+
+    AssertFatal(hulls.size() <= 65536, "Interior::buildHullBVH: too many hulls for U16 indices");
+
+    HullBVHBuild build;
+    build.boxes.setSize(hulls.size());
+    build.centers.setSize(hulls.size());
+    for (S32 i = 0; i < hulls.size(); i++)
+    {
+        const ConvexHull& hull = hulls[i];
+        build.boxes[i] = Box3F(hull.minX, hull.minY, hull.minZ, hull.maxX, hull.maxY, hull.maxZ);
+        build.boxes[i].getCenter(&build.centers[i]);
+        bvh.hullIndices[i] = i;
+    }
+
+    // Work through the tree depth first, so a node's first child always
+    // directly follows it.  Each entry is a range of hull indices and the
+    // node to patch with the range's node index (or -1 if it's the first
+    // child).
+    struct Pending
+    {
+        U32 start;
+        U32 count;
+        S32 parent;
+    };
+    Pending stack[HullBVHMaxDepth];
+    U32 stackSize = 0;
+
+    stack[stackSize].start = 0;
+    stack[stackSize].count = hulls.size();
+    stack[stackSize].parent = -1;
+    stackSize++;
+
+    while (stackSize)
+    {
+        Pending pending = stack[--stackSize];
+
+        U32 nodeIndex = bvh.nodes.size();
+        bvh.nodes.increment();
+        if (pending.parent != -1)
+            bvh.nodes[pending.parent].start = nodeIndex;
+
+        HullBVHNode& node = bvh.nodes[nodeIndex];
+        U16* indices = bvh.hullIndices.address() + pending.start;
+
+        Box3F centerBox;
+        node.box = build.boxes[indices[0]];
+        centerBox.min = centerBox.max = build.centers[indices[0]];
+        for (U32 i = 1; i < pending.count; i++)
+        {
+            node.box.min.setMin(build.boxes[indices[i]].min);
+            node.box.max.setMax(build.boxes[indices[i]].max);
+            centerBox.min.setMin(build.centers[indices[i]]);
+            centerBox.max.setMax(build.centers[indices[i]]);
+        }
+
+        U32 axis = 0;
+        Point3F extent = centerBox.max - centerBox.min;
+        if (extent.y > extent[axis])
+            axis = 1;
+        if (extent.z > extent[axis])
+            axis = 2;
+
+        // Small ranges, and ranges that can't be told apart, become leaves.
+        // The depth limit can't really be hit with median splits, but the
+        // stack has to end somewhere.
+        if (pending.count <= HullBVHLeafSize || extent[axis] == 0.0f || stackSize + 2 > HullBVHMaxDepth)
+        {
+            node.start = pending.start;
+            node.hullCount = pending.count;
+            continue;
+        }
+
+        U32 half = pending.count / 2;
+        selectHullCenter(build, indices, pending.count, half, axis);
+
+        node.start = 0;
+        node.hullCount = 0;
+
+        // Second child goes on the stack first, so the first is built next.
+        stack[stackSize].start = pending.start + half;
+        stack[stackSize].count = pending.count - half;
+        stack[stackSize].parent = nodeIndex;
+        stackSize++;
+
+        stack[stackSize].start = pending.start;
+        stack[stackSize].count = half;
+        stack[stackSize].parent = -1;
+        stackSize++;
+    }
+}
+
+bool Interior::queryHullBVH(const HullBVH& bvh, const Vector<ConvexHull>& hulls,
+    const Box3F& query, U16* outHulls, U32* numHulls, U32* boxTests)
+{
+    if (bvh.nodes.empty())
+        return *numHulls != 0;
+
+    U32 stack[HullBVHMaxDepth];
+    U32 stackSize = 0;
+    U32 tests = 0;
+
+    stack[stackSize++] = 0;
+    while (stackSize)
+    {
+        U32 nodeIndex = stack[--stackSize];
+        const HullBVHNode& node = bvh.nodes[nodeIndex];
+
+        tests++;
+        if (!query.isOverlapped(node.box))
+            continue;
+
+        if (node.hullCount == 0)
+        {
+            AssertFatal(stackSize + 2 <= HullBVHMaxDepth, "Interior::queryHullBVH: stack overflow");
+            stack[stackSize++] = node.start;
+            stack[stackSize++] = nodeIndex + 1;
+            continue;
+        }
+
+        for (U32 i = 0; i < node.hullCount; i++)
+        {
+            U16 hullIndex = bvh.hullIndices[node.start + i];
+            const ConvexHull& rHull = hulls[hullIndex];
+
+            tests++;
+            Box3F qb(rHull.minX, rHull.minY, rHull.minZ, rHull.maxX, rHull.maxY, rHull.maxZ);
+            if (query.isOverlapped(qb))
+            {
+                outHulls[*numHulls] = hullIndex;
+                (*numHulls)++;
+            }
+        }
+    }
+
+    if (boxTests)
+        *boxTests += tests;
+
+    return *numHulls != 0;
+}
+
+bool Interior::getIntersectingHulls(const Box3F& query, U16* hulls, U32* numHulls, U32* boxTests)
+{
+    AssertFatal(*numHulls == 0, "Error, some stuff in the hull vector already!");
+
+    return queryHullBVH(mHullBVH, mConvexHulls, query, hulls, numHulls, boxTests);
+}
+
+bool Interior::getIntersectingVehicleHulls(const Box3F& query, U16* hulls, U32* numHulls, U32* boxTests)
+{
+    AssertFatal(*numHulls == 0, "Error, some stuff in the hull vector already!");
+
+    return queryHullBVH(mVehicleHullBVH, mVehicleConvexHulls, query, hulls, numHulls, boxTests);
+}
+
+bool Interior::getBinnedHulls(const Box3F& query, U16* hulls, U32* numHulls, U32* boxTests)
 {
     AssertFatal(*numHulls == 0, "Error, some stuff in the hull vector already!");
 
@@ -1247,6 +1522,8 @@ bool Interior::getIntersectingHulls(const Box3F& query, U16* hulls, U32* numHull
                     continue;
                 rHull.searchTag = mSearchTag;
 
+                if (boxTests)
+                    (*boxTests)++;
                 Box3F qb(rHull.minX, rHull.minY, rHull.minZ, rHull.maxX, rHull.maxY, rHull.maxZ);
                 if (query.isOverlapped(qb))
                 {
@@ -1261,24 +1538,6 @@ bool Interior::getIntersectingHulls(const Box3F& query, U16* hulls, U32* numHull
 }
 
 
-bool Interior::getIntersectingVehicleHulls(const Box3F& query, U16* hulls, U32* numHulls)
-{
-    AssertFatal(*numHulls == 0, "Error, some stuff in the hull vector already!");
-
-    for (U16 i = 0; i < mVehicleConvexHulls.size(); i++)
-    {
-        ConvexHull& rHull = mVehicleConvexHulls[i];
-        Box3F qb(rHull.minX, rHull.minY, rHull.minZ, rHull.maxX, rHull.maxY, rHull.maxZ);
-        if (query.isOverlapped(qb))
-        {
-            hulls[*numHulls] = i;
-            (*numHulls)++;
-        }
-    }
-
-    return *numHulls != 0;
-}
-
 //--------------------------------------------------------------------------
 Box3F InteriorConvex::getBoundingBox() const
 {
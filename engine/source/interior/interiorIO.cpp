@@ -846,6 +846,11 @@ bool Interior::read(Stream& stream)
     truncateZoneTree();
     buildSurfaceZones();
 
+    // The coord bins only split up XY, which does badly on tall or
+    // sprawling interiors, so queries go through a hull BVH instead.
+    buildHullBVH(mConvexHulls, mHullBVH);
+    buildCollisionFans();
+
     return(stream.getStatus() == Stream::Ok);
 }
 
@@ -1265,6 +1270,8 @@ bool Interior::readVehicleCollision(Stream& stream)
         stream.read(&mVehicleWindingIndices[i].windingCount);
     }
 
+    buildHullBVH(mVehicleConvexHulls, mVehicleHullBVH);
+
     return true;
 }
 
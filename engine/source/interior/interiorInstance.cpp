@@ -97,6 +97,102 @@ ConsoleFunction(isPointInside, bool, 2, 4, "(Point3F pos) or (float x, float y,
     return(lastValue);
 }
 
+static void findInteriorInstancesCallback(SceneObject* obj, void* key)
+{
+    // PathedInteriors are interior objects too
+    InteriorInstance* instance = dynamic_cast<InteriorInstance*>(obj);
+    if (instance)
+        reinterpret_cast<Vector<InteriorInstance*>*>(key)->push_back(instance);
+}
+
+ConsoleFunction(benchInteriorHulls, void, 1, 3, "([queries, boxSize]) Run random box queries against the hulls "
+    "of every interior in the mission, through the hull BVH and the old coord bins, and report bounds tested per query.")
+{
+    U32 queries = argc > 1 ? getMax(dAtoi(argv[1]), 1) : 10000;
+    F32 boxSize = argc > 2 ? getMax(F32(dAtof(argv[2])), 0.01f) : 2.0f;
+
+    Vector<InteriorInstance*> instances;
+    getCurrentServerContainer()->findObjects(InteriorObjectType, findInteriorInstancesCallback, &instances);
+
+    // Instances of the same resource share their interiors.
+    Vector<Interior*> interiors;
+    for (S32 i = 0; i < instances.size(); i++)
+    {
+        if (instances[i]->getNumDetailLevels() == 0)
+            continue;
+
+        Interior* interior = instances[i]->getDetailLevel(0);
+        bool found = false;
+        for (S32 j = 0; j < interiors.size() && !found; j++)
+            found = interiors[j] == interior;
+        if (!found && interior->getNumConvexHulls())
+            interiors.push_back(interior);
+    }
+
+    if (interiors.empty())
+    {
+        Con::printf("benchInteriorHulls - no interiors with hulls loaded.");
+        return;
+    }
+
+    Con::printf("benchInteriorHulls - %d interiors, %d queries each, box size %g", interiors.size(), queries, boxSize);
+
+    MRandomLCG rand(1376312589);
+    Vector<U16> hulls;
+    Vector<Box3F> boxes;
+    boxes.setSize(queries);
+
+    U64 totalBinTests = 0, totalBVHTests = 0;
+    U32 totalBinMs = 0, totalBVHMs = 0;
+    for (S32 i = 0; i < interiors.size(); i++)
+    {
+        Interior* interior = interiors[i];
+        const Box3F& bounds = interior->getBoundingBox();
+        hulls.setSize(interior->getNumConvexHulls());
+
+        for (U32 q = 0; q < queries; q++)
+        {
+            Point3F center(rand.randF(bounds.min.x, bounds.max.x),
+                rand.randF(bounds.min.y, bounds.max.y),
+                rand.randF(bounds.min.z, bounds.max.z));
+            boxes[q].min = center - Point3F(boxSize, boxSize, boxSize) * 0.5f;
+            boxes[q].max = center + Point3F(boxSize, boxSize, boxSize) * 0.5f;
+        }
+
+        U32 binTests = 0, bvhTests = 0, binHits = 0, bvhHits = 0;
+
+        U32 start = Platform::getRealMilliseconds();
+        for (U32 q = 0; q < queries; q++)
+        {
+            U32 numHulls = 0;
+            interior->getBinnedHulls(boxes[q], hulls.address(), &numHulls, &binTests);
+            binHits += numHulls;
+        }
+        U32 binMs = Platform::getRealMilliseconds() - start;
+
+        start = Platform::getRealMilliseconds();
+        for (U32 q = 0; q < queries; q++)
+        {
+            U32 numHulls = 0;
+            interior->getIntersectingHulls(boxes[q], hulls.address(), &numHulls, &bvhTests);
+            bvhHits += numHulls;
+        }
+        U32 bvhMs = Platform::getRealMilliseconds() - start;
+
+        Con::printf("   %d hulls: bins %.1f tests/query (%d ms), bvh %.1f tests/query (%d ms), %.1f hits/query%s",
+            hulls.size(), F32(binTests) / queries, binMs, F32(bvhTests) / queries, bvhMs, F32(bvhHits) / queries,
+            binHits == bvhHits ? "" : " MISMATCH");
+
+        totalBinTests += binTests;
+        totalBVHTests += bvhTests;
+        totalBinMs += binMs;
+        totalBVHMs += bvhMs;
+    }
+
+    U32 totalQueries = queries * interiors.size();
+    Con::printf("   total: bins %.1f tests/query (%d ms), bvh %.1f tests/query (%d ms)",
+        F64(totalBinTests) / totalQueries, totalBinMs, F64(totalBVHTests) / totalQueries, totalBVHMs);
+}
 
 ConsoleFunctionGroupEnd(Interiors);
 
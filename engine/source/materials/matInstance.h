@@ -56,6 +56,9 @@ public:
     // Compares this MatInstance to mat
     virtual S32 compare(MatInstance* mat);
 
+    // The weight compare() orders by, for building render sort keys
+    U32 getSortWeight() const { return mSortWeight; }
+
     /// Create a material instance by reference to a Material.
     MatInstance( Material &mat );
     /// Create a material instance by name.
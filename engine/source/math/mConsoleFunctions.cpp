@@ -49,14 +49,14 @@ ConsoleFunction(mSolveQuartic, const char*, 6, 6, "(float a, float b, float c, f
     return retBuffer;
 }
 
-ConsoleFunction(mFloor, S32, 2, 2, "(float v) Round v down to the nearest whole number.")
+ConsoleFunctionTyped(mFloor, S32, 2, 2, "(float v) Round v down to the nearest whole number.")
 {
-    return (S32)mFloor(dAtof(argv[1]));
+    return (S32)mFloor(argv[1].getFloat());
 }
 
-ConsoleFunction(mCeil, S32, 2, 2, "(float v) Round v up to the nearest whole number.")
+ConsoleFunctionTyped(mCeil, S32, 2, 2, "(float v) Round v up to the nearest whole number.")
 {
-    return (S32)mCeil(dAtof(argv[1]));
+    return (S32)mCeil(argv[1].getFloat());
 }
 
 ConsoleFunction(mFloatLength, const char*, 3, 3, "(float v, int numDecimals)"
@@ -74,71 +74,71 @@ ConsoleFunction(mFloatLength, const char*, 3, 3, "(float v, int numDecimals)"
 }
 
 //------------------------------------------------------------------------------
-ConsoleFunction(mAbs, F32, 2, 2, "(float v) Returns the absolute value of the argument.")
+ConsoleFunctionTyped(mAbs, F32, 2, 2, "(float v) Returns the absolute value of the argument.")
 {
-    return(mFabs(dAtof(argv[1])));
+    return(mFabs(argv[1].getFloat()));
 }
 
-ConsoleFunction(mSqrt, F32, 2, 2, "(float v) Returns the square root of the argument.")
+ConsoleFunctionTyped(mSqrt, F32, 2, 2, "(float v) Returns the square root of the argument.")
 {
-    return(mSqrt(dAtof(argv[1])));
+    return(mSqrt(argv[1].getFloat()));
 }
 
-ConsoleFunction(mPow, F32, 3, 3, "(float b, float p) Returns the b raised to the pth power.")
+ConsoleFunctionTyped(mPow, F32, 3, 3, "(float b, float p) Returns the b raised to the pth power.")
 {
-    return(mPow(dAtof(argv[1]), dAtof(argv[2])));
+    return(mPow(argv[1].getFloat(), argv[2].getFloat()));
 }
 
-ConsoleFunction(mLog, F32, 2, 2, "(float v) Returns the natural logarithm of the argument.")
+ConsoleFunctionTyped(mLog, F32, 2, 2, "(float v) Returns the natural logarithm of the argument.")
 {
-    return(mLog(dAtof(argv[1])));
+    return(mLog(argv[1].getFloat()));
 }
 
-ConsoleFunction(mSin, F32, 2, 2, "(float th) Returns the sine of th, which is in radians.")
+ConsoleFunctionTyped(mSin, F32, 2, 2, "(float th) Returns the sine of th, which is in radians.")
 {
-    return(mSin(dAtof(argv[1])));
+    return(mSin(argv[1].getFloat()));
 }
 
-ConsoleFunction(mCos, F32, 2, 2, "(float th) Returns the cosine of th, which is in radians.")
+ConsoleFunctionTyped(mCos, F32, 2, 2, "(float th) Returns the cosine of th, which is in radians.")
 {
-    return(mCos(dAtof(argv[1])));
+    return(mCos(argv[1].getFloat()));
 }
 
-ConsoleFunction(mTan, F32, 2, 2, "(float th) Returns the tangent of th, which is in radians.")
+ConsoleFunctionTyped(mTan, F32, 2, 2, "(float th) Returns the tangent of th, which is in radians.")
 {
-    return(mTan(dAtof(argv[1])));
+    return(mTan(argv[1].getFloat()));
 }
 
-ConsoleFunction(mAsin, F32, 2, 2, "(float th) Returns the arc-sine of th, which is in radians.")
+ConsoleFunctionTyped(mAsin, F32, 2, 2, "(float th) Returns the arc-sine of th, which is in radians.")
 {
-    return(mAsin(dAtof(argv[1])));
+    return(mAsin(argv[1].getFloat()));
 }
 
-ConsoleFunction(mAcos, F32, 2, 2, "(float th) Returns the arc-cosine of th, which is in radians.")
+ConsoleFunctionTyped(mAcos, F32, 2, 2, "(float th) Returns the arc-cosine of th, which is in radians.")
 {
-    return(mAcos(dAtof(argv[1])));
+    return(mAcos(argv[1].getFloat()));
 }
 
-ConsoleFunction(mAtan, F32, 3, 3, "(float rise, float run) Returns the slope in radians (the arc-tangent) of a line with the given rise and run.")
+ConsoleFunctionTyped(mAtan, F32, 3, 3, "(float rise, float run) Returns the slope in radians (the arc-tangent) of a line with the given rise and run.")
 {
-    return(mAtan(dAtof(argv[1]), dAtof(argv[2])));
+    return(mAtan(argv[1].getFloat(), argv[2].getFloat()));
 }
 
-ConsoleFunction(mRadToDeg, F32, 2, 2, "(float radians) Converts a measure in radians to degrees.")
+ConsoleFunctionTyped(mRadToDeg, F32, 2, 2, "(float radians) Converts a measure in radians to degrees.")
 {
-    return(mRadToDeg(dAtof(argv[1])));
+    return(mRadToDeg(argv[1].getFloat()));
 }
 
-ConsoleFunction(mDegToRad, F32, 2, 2, "(float degrees) Convert a measure in degrees to radians.")
+ConsoleFunctionTyped(mDegToRad, F32, 2, 2, "(float degrees) Convert a measure in degrees to radians.")
 {
-    return(mDegToRad(dAtof(argv[1])));
+    return(mDegToRad(argv[1].getFloat()));
 }
 
-ConsoleFunction(mClamp, F32, 4, 4, "(float number, float min, float max) Clamp a value between two other values.")
+ConsoleFunctionTyped(mClamp, F32, 4, 4, "(float number, float min, float max) Clamp a value between two other values.")
 {
-    F32 value = dAtof(argv[1]);
-    F32 min = dAtof(argv[2]);
-    F32 max = dAtof(argv[3]);
+    F32 value = argv[1].getFloat();
+    F32 min = argv[2].getFloat();
+    F32 max = argv[3].getFloat();
     return mClampF(value, min, max);
 }
 
@@ -40,6 +40,11 @@ void GameInterface::refreshWindow()
 
 }
 
+S32 GameInterface::getTimeUntilTick()
+{
+    return -1;
+}
+
 static U32 sReentrantCount = 0;
 
 void GameInterface::processEvent(Event* event)
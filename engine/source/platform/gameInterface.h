@@ -30,6 +30,11 @@ public:
     virtual void refreshWindow();
 
     virtual void postEvent(Event& event);
+
+    /// Returns the milliseconds of real time until the game next needs a
+    /// TimeEvent to run a server tick, or -1 if it has no ticks to run.
+    /// Platforms which sleep between frames use this to wake up on time.
+    virtual S32 getTimeUntilTick();
     /// @}
 
     /// @name Event Handlers
@@ -386,8 +386,15 @@ public:
     static StringTableEntry getWorkingDirectory();
     static bool dumpPath(const char* in_pBasePath, Vector<FileInfo>& out_rFileVector, S32 recurseDepth = -1);
     static bool dumpDirectories(const char* path, Vector<StringTableEntry>& directoryVector, S32 depth = 1, bool noBasePath = false);
+    /// Lists the names of path's immediate subdirectories, leaving out excluded directories.
+    static bool dumpSubDirectories(const char* path, Vector<StringTableEntry>& subDirectories);
     static bool hasSubDirectory(const char* pPath);
     static bool getFileTimes(const char* filePath, FileTime* createTime, FileTime* modifyTime);
+    /// Gets the modify time of a directory.  Where a relative directory is
+    /// listed from both the pref dir and the working directory (Linux), the
+    /// pref dir copy's time goes in prefModifyTime, zero if there is none.
+    /// Elsewhere prefModifyTime is always zero.
+    static bool getDirectoryTimes(const char* path, FileTime* modifyTime, FileTime* prefModifyTime);
     static bool isFile(const char* pFilePath);
     static S32  getFileSize(const char* pFilePath);
     static bool isDirectory(const char* pDirPath);
@@ -741,6 +748,10 @@ struct Net
     static void closePort();
     static Error sendto(const NetAddress* address, const U8* buffer, S32 bufferSize);
 
+    /// Hands any packets sendto() has queued up to the OS.  Called once a
+    /// frame; platforms which send right away have nothing to do here.
+    static void flushSends();
+
     // Reliable net functions (TCP)
     // all incoming messages come in on the Connected* events
     static NetSocket openListenPort(U16 port);
@@ -0,0 +1,70 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _PLATFORMATOMIC_H_
+#define _PLATFORMATOMIC_H_
+
+#ifndef _TORQUE_TYPES_H_
+#include "platform/types.h"
+#endif
+
+#if defined(TORQUE_COMPILER_VISUALC)
+#include <intrin.h>
+#pragma intrinsic(_ReadWriteBarrier)
+#endif
+
+/// @name Lock-free publication
+///
+/// Helpers for handing data from one thread to another without a lock.
+/// The writer fills in the data and then stores a pointer or index to it
+/// with dAtomicStoreRelease().  A reader that sees the new value through
+/// dAtomicLoadAcquire() is guaranteed to also see everything the writer
+/// wrote before the store.
+///
+/// These only order memory.  They don't make read-modify-write safe, so
+/// each value must only have one writer at a time (or writers must hold a
+/// lock between them).
+///
+/// @{
+
+template <class T>
+inline T dAtomicLoadAcquire(const volatile T* ptr)
+{
+#if defined(TORQUE_COMPILER_GCC) && TORQUE_COMPILER_GCC >= 40700
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#elif defined(TORQUE_COMPILER_GCC)
+    T value = *ptr;
+    __sync_synchronize();
+    return value;
+#elif defined(TORQUE_COMPILER_VISUALC)
+    // Volatile loads acquire on x86 and x64, this just keeps
+    // the compiler from moving later loads ahead of it.
+    T value = *ptr;
+    _ReadWriteBarrier();
+    return value;
+#else
+    return *ptr;
+#endif
+}
+
+template <class T>
+inline void dAtomicStoreRelease(volatile T* ptr, T value)
+{
+#if defined(TORQUE_COMPILER_GCC) && TORQUE_COMPILER_GCC >= 40700
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#elif defined(TORQUE_COMPILER_GCC)
+    __sync_synchronize();
+    *ptr = value;
+#elif defined(TORQUE_COMPILER_VISUALC)
+    _ReadWriteBarrier();
+    *ptr = value;
+#else
+    *ptr = value;
+#endif
+}
+
+/// @}
+
+#endif // _PLATFORMATOMIC_H_
@@ -19,6 +19,7 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 
 #pragma message("todo: file io still needs some work...")
 
@@ -387,6 +388,51 @@ bool File::hasCapability(Capability cap) const
    return (0 != (U32(cap) & capability));
 }
 
+//-----------------------------------------------------------------------------
+// Map part of the file into memory.  The mapping holds its own reference to
+// the file, so it outlives close().
+//-----------------------------------------------------------------------------
+struct MacCarbFileMapping
+{
+   void *base;
+   size_t length;
+};
+
+void *File::map(U32 offset, U32 size, const U8 **data)
+{
+   AssertFatal(Closed != currentStatus, "File::map: file closed");
+   AssertFatal(NULL != handle, "File::map: invalid file handle");
+   AssertFatal(capability & U32(FileRead), "File::map: file not open for reading");
+
+   if (size == 0 || U64(offset) + size > getSize())
+      return NULL;
+
+   // mmap wants a page aligned offset
+   U32 pageSize = (U32) getpagesize();
+   U32 pageOffset = offset % pageSize;
+   size_t length = size + pageOffset;
+
+   void *base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileno((FILE*)handle), offset - pageOffset);
+   if (base == MAP_FAILED)
+      return NULL;
+
+   MacCarbFileMapping *mapping = new MacCarbFileMapping;
+   mapping->base = base;
+   mapping->length = length;
+
+   *data = (const U8 *) base + pageOffset;
+   return mapping;
+}
+
+void File::unmap(void *mapping)
+{
+   MacCarbFileMapping *m = reinterpret_cast<MacCarbFileMapping *>(mapping);
+   AssertFatal(m, "File::unmap: invalid mapping");
+
+   munmap(m->base, m->length);
+   delete m;
+}
+
 //-----------------------------------------------------------------------------
 S32 Platform::compareFileTimes(const FileTime &a, const FileTime &b)
 {
@@ -425,6 +471,13 @@ bool Platform::getFileTimes(const char *path, FileTime *createTime, FileTime *mo
    return true;
 }
 
+//-----------------------------------------------------------------------------
+bool Platform::getDirectoryTimes(const char *path, FileTime *modifyTime, FileTime *prefModifyTime)
+{
+   *prefModifyTime = 0;
+   return getFileTimes(path, NULL, modifyTime);
+}
+
 
 //-----------------------------------------------------------------------------
 bool Platform::createPath(const char *file)
@@ -811,6 +864,26 @@ bool Platform::dumpPath(const char *path, Vector<Platform::FileInfo>& fileVector
    return ret;
 }
 
+//-----------------------------------------------------------------------------
+bool Platform::dumpSubDirectories(const char *path, Vector<StringTableEntry> &subDirectories)
+{
+   DIR *dir = opendir(path);
+   if(!dir)
+      return false;
+   
+   dirent *entry;
+   while( entry = readdir(dir))
+   {
+      // filter out dirs we dont want.
+      if( !isGoodDirectory(entry) )
+         continue;
+      
+      subDirectories.push_back(StringTable->insert(entry->d_name));
+   }
+   closedir(dir);
+   return true;
+}
+
 //-----------------------------------------------------------------------------
 #if defined(TORQUE_DEBUG)
 ConsoleFunction(testHasSubdir,void,2,2,"tests platform::hasSubDirectory") {
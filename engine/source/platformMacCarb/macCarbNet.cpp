@@ -399,6 +399,10 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferS
    }
 }
 
+void Net::flushSends()
+{
+}
+
 void Net::process()
 {
    sockaddr sa;
@@ -423,6 +423,59 @@ bool File::hasCapability(Capability cap) const
     return (0 != (U32(cap) & capability));
 }
 
+//-----------------------------------------------------------------------------
+// Map part of the file into memory.  The section and view hold their own
+// references to the file, so they outlive close().
+//-----------------------------------------------------------------------------
+struct WinFileMapping
+{
+    HANDLE section;
+    void* base;
+};
+
+void* File::map(U32 offset, U32 size, const U8** data)
+{
+    AssertFatal(Closed != currentStatus, "File::map: file closed");
+    AssertFatal(INVALID_HANDLE_VALUE != (HANDLE)handle, "File::map: invalid file handle");
+    AssertFatal(capability & U32(FileRead), "File::map: file not open for reading");
+
+    if (size == 0 || U64(offset) + size > getSize())
+        return NULL;
+
+    // Views have to start on an allocation granularity boundary
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    U32 viewOffset = offset - offset % info.dwAllocationGranularity;
+
+    HANDLE section = CreateFileMapping((HANDLE)handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (section == NULL)
+        return NULL;
+
+    void* base = MapViewOfFile(section, FILE_MAP_READ, 0, viewOffset, size + (offset - viewOffset));
+    if (base == NULL)
+    {
+        CloseHandle(section);
+        return NULL;
+    }
+
+    WinFileMapping* mapping = new WinFileMapping;
+    mapping->section = section;
+    mapping->base = base;
+
+    *data = (const U8*)base + (offset - viewOffset);
+    return mapping;
+}
+
+void File::unmap(void* mapping)
+{
+    WinFileMapping* m = reinterpret_cast<WinFileMapping*>(mapping);
+    AssertFatal(m, "File::unmap: invalid mapping");
+
+    UnmapViewOfFile(m->base);
+    CloseHandle(m->section);
+    delete m;
+}
+
 S32 Platform::compareFileTimes(const FileTime& a, const FileTime& b)
 {
     if (a.v2 > b.v2)
@@ -540,6 +593,31 @@ bool Platform::getFileTimes(const char* filePath, FileTime* createTime, FileTime
     return true;
 }
 
+//--------------------------------------
+
+bool Platform::getDirectoryTimes(const char* path, FileTime* modifyTime, FileTime* prefModifyTime)
+{
+    // FindFirstFile() can't look up "." or a path with a trailing slash, so
+    // ask for the directory's attributes instead.
+#ifdef UNICODE
+    UTF16 dp[512];
+    convertUTF8toUTF16((UTF8*)path, dp, sizeof(dp));
+#else
+    const char* dp = path;
+#endif
+
+    dMemset(prefModifyTime, 0, sizeof(FileTime));
+
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesEx(dp, GetFileExInfoStandard, &data) ||
+        !(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        return false;
+
+    modifyTime->v1 = data.ftLastWriteTime.dwLowDateTime;
+    modifyTime->v2 = data.ftLastWriteTime.dwHighDateTime;
+    return true;
+}
+
 //--------------------------------------
 bool Platform::createPath(const char* file)
 {
@@ -625,6 +703,56 @@ bool Platform::dumpPath(const char* path, Vector<Platform::FileInfo>& fileVector
     return recurseDumpPath(path, "*", fileVector, recurseDepth);
 }
 
+bool Platform::dumpSubDirectories(const char* path, Vector<StringTableEntry>& subDirectories)
+{
+    char buf[1024];
+    WIN32_FIND_DATA findData;
+
+    dSprintf(buf, sizeof(buf), "%s/*", path);
+
+#ifdef UNICODE
+    UTF16 search[1024];
+    convertUTF8toUTF16((UTF8*)buf, search, sizeof(search));
+#else
+    char* search = buf;
+#endif
+
+    HANDLE handle = FindFirstFile(search, &findData);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    do
+    {
+#ifdef UNICODE
+        char fnbuf[1024];
+        convertUTF16toUTF8(findData.cFileName, (UTF8*)fnbuf, sizeof(fnbuf));
+#else
+        char* fnbuf = findData.cFileName;
+#endif
+
+        if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+            continue;
+
+        // make sure it is a directory
+        if (findData.dwFileAttributes & (FILE_ATTRIBUTE_OFFLINE | FILE_ATTRIBUTE_SYSTEM))
+            continue;
+
+        // skip . and .. directories
+        if (dStrcmp(fnbuf, ".") == 0 || dStrcmp(fnbuf, "..") == 0)
+            continue;
+
+        // Skip excluded directores
+        if (Platform::isExcludedDirectory(fnbuf))
+            continue;
+
+        subDirectories.push_back(StringTable->insert(fnbuf));
+
+    } while (FindNextFile(handle, &findData));
+
+    FindClose(handle);
+    return true;
+}
+
 
 //--------------------------------------
 StringTableEntry Platform::getWorkingDirectory()
@@ -500,6 +500,10 @@ Net::Error Net::sendto(const NetAddress* address, const U8* buffer, S32 bufferSi
     }
 }
 
+void Net::flushSends()
+{
+}
+
 void Net::process()
 {
     SOCKADDR sa;
@@ -75,7 +75,12 @@ bool Thread::join()
         return(false);
 
     WinThreadData* threadData = reinterpret_cast<WinThreadData*>(mData);
-    return(Semaphore::acquireSemaphore(threadData->mSemaphore));
+    bool ret = Semaphore::acquireSemaphore(threadData->mSemaphore);
+
+    // Leave it signalled, so the thread reads as finished and joining it
+    // again (the destructor does) doesn't block forever.
+    Semaphore::releaseSemaphore(threadData->mSemaphore);
+    return(ret);
 }
 
 void Thread::run(void* arg)
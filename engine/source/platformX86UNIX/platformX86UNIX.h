@@ -40,6 +40,12 @@ bool AcquireProcessMutex(const char *mutexName);
 // Convert a string to lowercase in place
 char *strtolwr(char* str);
 
+// Network
+// Waits up to us microseconds, returning early if a packet comes in.
+// Returns false straight away if there's no UDP port open, or if
+// threadOnly is set and the network thread isn't running.
+bool NetWaitForPackets(U32 us, bool threadOnly = false);
+
 void DisplayErrorAlert(const char* errMsg, bool showSDLError = true);
 
 // Just like strstr, except case insensitive
@@ -55,6 +55,7 @@
 #include <dirent.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -300,7 +301,7 @@ bool ModifyFile(const char * name, S32 modType)
 }
 
 //-----------------------------------------------------------------------------
-static bool RecurseDumpPath(const char *path, const char* relativePath, const char *pattern, Vector<Platform::FileInfo> &fileVector)
+static bool RecurseDumpPath(const char *path, const char* relativePath, const char *pattern, Vector<Platform::FileInfo> &fileVector, S32 depth)
 {
    char search[1024];
 
@@ -342,7 +343,10 @@ static bool RecurseDumpPath(const char *path, const char* relativePath, const ch
                relativePath, fEntry->d_name);
             childRelative = childRelativeBuf;
          }
-         RecurseDumpPath(child, childRelative, pattern, fileVector);
+         if (depth > 0)
+            RecurseDumpPath(child, childRelative, pattern, fileVector, depth - 1);
+         else if (depth == -1)
+            RecurseDumpPath(child, childRelative, pattern, fileVector, -1);
       }
       else
       {
@@ -751,6 +755,54 @@ bool File::hasCapability(Capability cap) const
     return (0 != (U32(cap) & capability));
 }
 
+//-----------------------------------------------------------------------------
+// Map part of the file into memory.  The mapping holds its own reference to
+// the file, so it outlives close().
+//-----------------------------------------------------------------------------
+struct x86UNIXFileMapping
+{
+   void *base;
+   size_t length;
+};
+
+void *File::map(U32 offset, U32 size, const U8 **data)
+{
+   AssertFatal(Closed != currentStatus, "File::map: file closed");
+   AssertFatal(NULL != handle, "File::map: invalid file handle");
+   AssertFatal(capability & U32(FileRead), "File::map: file not open for reading");
+
+   if (size == 0 || U64(offset) + size > getSize())
+      return NULL;
+
+   // mmap wants a page aligned offset
+   U32 pageSize = (U32) sysconf(_SC_PAGESIZE);
+   U32 pageOffset = offset % pageSize;
+   size_t length = size + pageOffset;
+
+   void *base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, *((int *)handle), offset - pageOffset);
+   if (base == MAP_FAILED)
+      return NULL;
+
+   // resources are read front to back
+   madvise(base, length, MADV_SEQUENTIAL);
+
+   x86UNIXFileMapping *mapping = new x86UNIXFileMapping;
+   mapping->base = base;
+   mapping->length = length;
+
+   *data = (const U8 *) base + pageOffset;
+   return mapping;
+}
+
+void File::unmap(void *mapping)
+{
+   x86UNIXFileMapping *m = reinterpret_cast<x86UNIXFileMapping *>(mapping);
+   AssertFatal(m, "File::unmap: invalid mapping");
+
+   munmap(m->base, m->length);
+   delete m;
+}
+
 //-----------------------------------------------------------------------------
 S32 Platform::compareFileTimes(const FileTime &a, const FileTime &b)
 {
@@ -809,6 +861,32 @@ bool Platform::getFileTimes(const char *filePath, FileTime *createTime, FileTime
    return GetFileTimes(pathName, createTime, modifyTime);
 }
 
+//-----------------------------------------------------------------------------
+bool Platform::getDirectoryTimes(const char *path, FileTime *modifyTime, FileTime *prefModifyTime)
+{
+   char pathName[MaxPath];
+   char cwd[MaxPath];
+   getcwd(cwd, MaxPath);
+   if (dStrstr(path, cwd) == path && path[dStrlen(cwd)] == '/')
+      path = path + dStrlen(cwd) + 1;
+
+   // dumpPath() lists both copies of a relative directory, so a change to
+   // either has to show up here.  Without redirection they're the same.
+   bool found = false;
+   *prefModifyTime = 0;
+   if (path[0] != '/' && path[0] != '\\' && dStrcmp(GetPrefDir(), cwd) != 0)
+   {
+      MungePath(pathName, MaxPath, path, GetPrefDir());
+      found = GetFileTimes(pathName, NULL, prefModifyTime);
+   }
+
+   *modifyTime = 0;
+   MungePath(pathName, MaxPath, path, cwd);
+   found |= GetFileTimes(pathName, NULL, modifyTime);
+
+   return found;
+}
+
 //-----------------------------------------------------------------------------
 bool Platform::createPath(const char *file)
 {
@@ -855,7 +933,7 @@ bool Platform::dumpPath(const char *path, Vector<Platform::FileInfo> &fileVector
    {
       char prefPathName[MaxPath];
       MungePath(prefPathName, MaxPath, path, GetPrefDir());
-      RecurseDumpPath(prefPathName, path, pattern, fileVector);
+      RecurseDumpPath(prefPathName, path, pattern, fileVector, depth);
    }
 
    // munge the requested path and dump it
@@ -863,7 +941,62 @@ bool Platform::dumpPath(const char *path, Vector<Platform::FileInfo> &fileVector
    char cwd[MaxPath];
    getcwd(cwd, MaxPath);
    MungePath(mungedPath, MaxPath, path, cwd);
-   return RecurseDumpPath(mungedPath, path, pattern, fileVector);
+   return RecurseDumpPath(mungedPath, path, pattern, fileVector, depth);
+}
+
+//-----------------------------------------------------------------------------
+static bool DumpSubDirectories(const char *path, Vector<StringTableEntry> &subDirectories)
+{
+   DIR *directory = opendir(path);
+   if (directory == NULL)
+      return false;
+
+   struct dirent *fEntry;
+   while ((fEntry = readdir(directory)) != NULL)
+   {
+      // skip . and .. directories
+      if (dStrcmp(fEntry->d_name, ".") == 0 || dStrcmp(fEntry->d_name, "..") == 0)
+         continue;
+
+      char filename[BUFSIZ+1];
+      struct stat fStat;
+      dSprintf(filename, sizeof(filename), "%s/%s", path, fEntry->d_name);
+      if (stat(filename, &fStat) == -1 || (fStat.st_mode & S_IFMT) != S_IFDIR)
+         continue;
+
+      if (Platform::isExcludedDirectory(fEntry->d_name))
+         continue;
+
+      // the pref dir and the game dir can both have it
+      StringTableEntry name = StringTable->insert(fEntry->d_name);
+      bool listed = false;
+      for (S32 i = 0; i < subDirectories.size() && !listed; i++)
+         listed = subDirectories[i] == name;
+      if (!listed)
+         subDirectories.push_back(name);
+   }
+
+   closedir(directory);
+   return true;
+}
+
+bool Platform::dumpSubDirectories(const char *path, Vector<StringTableEntry> &subDirectories)
+{
+   bool found = false;
+
+   // if it is not absolute, dump the pref dir first
+   if (path[0] != '/' && path[0] != '\\')
+   {
+      char prefPathName[MaxPath];
+      MungePath(prefPathName, MaxPath, path, GetPrefDir());
+      found = DumpSubDirectories(prefPathName, subDirectories);
+   }
+
+   char mungedPath[MaxPath];
+   char cwd[MaxPath];
+   getcwd(cwd, MaxPath);
+   MungePath(mungedPath, MaxPath, path, cwd);
+   return DumpSubDirectories(mungedPath, subDirectories) || found;
 }
 
 //-----------------------------------------------------------------------------
@@ -20,6 +20,12 @@
 #include <netinet/in.h>
 #include <errno.h>
 
+// recvmmsg() and sendmmsg() move a batch of datagrams per syscall.
+#if defined(__linux__)
+#include <sys/uio.h>
+#define UNIX_NET_BATCHED_IO
+#endif
+
 /* for PROTO_IPX */
 #if defined(__linux__)
 #include <net/if_ppp.h>
@@ -37,6 +43,10 @@
 #include "platform/gameInterface.h"
 #include "core/fileStream.h"
 #include "core/tVector.h"
+#include "platform/profiler.h"
+#include "platform/platformThread.h"
+#include "platform/platformAtomic.h"
+#include "math/mMathFn.h"
 
 static Net::Error getLastError();
 static S32 defaultPort = 28000;
@@ -93,6 +103,93 @@ enum {
    MaxConnections = 1024,
 };
 
+#ifdef UNIX_NET_BATCHED_IO
+
+enum {
+   /// The most datagrams moved by one recvmmsg() or sendmmsg().
+   NetBatchSize = 64,
+};
+
+/// Set from $pref::Net::BatchedIO when the port is opened.
+static bool sgBatchedIO = true;
+
+/// A preallocated ring of datagrams and the message headers which
+/// point the kernel at them.
+struct PacketBatch
+{
+   mmsghdr msgs[NetBatchSize];
+   iovec iov[NetBatchSize];
+   sockaddr_in addrs[NetBatchSize];
+
+   void init(U32 index, void *data)
+   {
+      iov[index].iov_base = data;
+      iov[index].iov_len = MaxPacketDataSize;
+      dMemset(&msgs[index], 0, sizeof(mmsghdr));
+      msgs[index].msg_hdr.msg_name = &addrs[index];
+      msgs[index].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      msgs[index].msg_hdr.msg_iov = &iov[index];
+      msgs[index].msg_hdr.msg_iovlen = 1;
+   }
+};
+
+/// Received datagrams land straight in the events we post.
+static PacketBatch sgRecvBatch;
+static PacketReceiveEvent sgRecvEvents[NetBatchSize];
+
+/// sendto() copies packets in here and flushSends() sends them all.
+static PacketBatch sgSendBatch;
+static U8 sgSendData[NetBatchSize][MaxPacketDataSize];
+static U32 sgSendCount = 0;
+
+static void initPacketBatches()
+{
+   for (U32 i = 0; i < NetBatchSize; i++)
+   {
+      sgRecvBatch.init(i, sgRecvEvents[i].data);
+      sgSendBatch.init(i, sgSendData[i]);
+   }
+}
+
+/// Reads up to count datagrams without blocking, returning how many
+/// came in or -1.
+static S32 recvBatch(int fd, PacketBatch &batch, U32 count)
+{
+   // The kernel overwrites the address lengths.
+   for (U32 i = 0; i < count; i++)
+      batch.msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+
+   S32 ret;
+   do
+      ret = recvmmsg(fd, batch.msgs, count, MSG_DONTWAIT, NULL);
+   while (ret == -1 && errno == EINTR);
+   return ret;
+}
+
+/// Sends the first count datagrams of the batch.  If the socket buffer
+/// fills up the rest are dropped, just as sendto() would have dropped
+/// them, and a datagram the kernel refuses is skipped.  Returns the
+/// number of syscalls made.
+static U32 sendBatch(int fd, PacketBatch &batch, U32 count)
+{
+   U32 sent = 0;
+   U32 calls = 0;
+   while (sent < count)
+   {
+      S32 ret = sendmmsg(fd, batch.msgs + sent, count - sent, 0);
+      calls++;
+      if (ret > 0)
+         sent += ret;
+      else if (ret == 0 || errno == EAGAIN || errno == EWOULDBLOCK)
+         break;
+      else if (errno != EINTR)
+         sent++;
+   }
+   return calls;
+}
+
+#endif
+
 S32 Poll(NetSocket fd, S32 eventMask, S32 timeoutMs)
 {
    pollfd pfd;
@@ -110,6 +207,9 @@ S32 Poll(NetSocket fd, S32 eventMask, S32 timeoutMs)
 
 bool Net::init()
 {
+#ifdef UNIX_NET_BATCHED_IO
+   initPacketBatches();
+#endif
    NetAsync::startAsync();
    return(true);
 }
@@ -317,8 +417,245 @@ Net::Error Net::sendtoSocket(NetSocket socket, const U8 *buffer, int bufferSize)
    return e;
 }
 
+/// Fills in the address and size of a received datagram's event, returning
+/// false if it should be dropped because it's empty or one we sent ourselves.
+static bool fillPacketEvent(const sockaddr *sa, PacketReceiveEvent &receiveEvent, S32 bytesRead)
+{
+   if(sa->sa_family == AF_INET)
+      IPSocketToNetAddress((const sockaddr_in *) sa, &receiveEvent.sourceAddress);
+   else if(sa->sa_family == AF_IPX)
+      IPXSocketToNetAddress((const sockaddr_ipx *) sa, &receiveEvent.sourceAddress);
+   else
+      return false;
+
+   NetAddress &na = receiveEvent.sourceAddress;
+   if(na.type == NetAddress::IPAddress &&
+      na.netNum[0] == 127 &&
+      na.netNum[1] == 0 &&
+      na.netNum[2] == 0 &&
+      na.netNum[3] == 1 &&
+      na.port == netPort)
+      return false;
+   if(bytesRead <= 0)
+      return false;
+   receiveEvent.size = PacketReceiveEventHeaderSize + bytesRead;
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+// Network thread
+//
+// With $pref::Net::Thread set, a thread blocks on the UDP socket and
+// queues packets as they come in on a single producer, single consumer
+// ring.  Net::process() just empties the ring, and the main loop can
+// sleep in NetWaitForPackets() until a packet turns up rather than for
+// a fixed millisecond.
+
+enum {
+   /// How far the network thread can get ahead of the main thread.
+   /// Past that, packets wait in the socket buffer.
+   NetRingSize = 256,
+};
+
+/// A received packet and the real time it came in.
+struct NetRingSlot
+{
+   U32 arrivalTime;
+   PacketReceiveEvent event;
+};
+
+static Thread *sgNetThread = NULL;
+static NetRingSlot *sgNetRing = NULL;
+
+/// Only the network thread moves the head and only the main thread moves
+/// the tail.  Both count up forever and are masked to index the ring.
+static volatile U32 sgNetRingHead = 0;
+static volatile U32 sgNetRingTail = 0;
+
+/// The network thread writes to the wake pipe whenever it queues packets,
+/// and quits when something is written to the quit pipe.
+static int sgNetWakePipe[2] = { -1, -1 };
+static int sgNetQuitPipe[2] = { -1, -1 };
+
+/// Time from arrival to Game->postEvent(), for netThreadStats().
+static U32 sgNetThreadPackets = 0;
+static U32 sgNetThreadTotalDelay = 0;
+static U32 sgNetThreadMaxDelay = 0;
+
+static void netThreadMain(void *)
+{
+   pollfd fds[2];
+   fds[0].fd = udpSocket;
+   fds[0].events = POLLIN;
+   fds[1].fd = sgNetQuitPipe[0];
+   fds[1].events = POLLIN;
+
+   U32 head = sgNetRingHead;
+   for(;;)
+   {
+      if(poll(fds, 2, -1) == -1)
+      {
+         if(errno == EINTR)
+            continue;
+         break;
+      }
+      if(fds[1].revents)
+         break;
+
+      // Take everything the socket has, as long as there's room.
+      U32 queued = 0;
+      while(head - dAtomicLoadAcquire(&sgNetRingTail) < NetRingSize)
+      {
+         NetRingSlot &slot = sgNetRing[head & (NetRingSize - 1)];
+         sockaddr sa;
+         socklen_t addrLen = sizeof(sa);
+         S32 bytesRead = recvfrom(udpSocket, slot.event.data, MaxPacketDataSize, MSG_DONTWAIT, &sa, &addrLen);
+         if(bytesRead == -1)
+            break;
+         if(!fillPacketEvent(&sa, slot.event, bytesRead))
+            continue;
+
+         slot.arrivalTime = Platform::getRealMilliseconds();
+         head++;
+         queued++;
+      }
+
+      if(queued)
+      {
+         dAtomicStoreRelease(&sgNetRingHead, head);
+         char wake = 0;
+         write(sgNetWakePipe[1], &wake, 1);
+      }
+      else if(head - sgNetRingTail >= NetRingSize)
+      {
+         // The main thread is behind; give it a moment rather
+         // than spinning on a readable socket.
+         Platform::sleep(1);
+      }
+   }
+}
+
+static void startNetThread()
+{
+   if(pipe(sgNetWakePipe) == -1)
+      return;
+   if(pipe(sgNetQuitPipe) == -1)
+   {
+      close(sgNetWakePipe[0]);
+      close(sgNetWakePipe[1]);
+      sgNetWakePipe[0] = sgNetWakePipe[1] = -1;
+      return;
+   }
+   Net::setBlocking(sgNetWakePipe[0], false);
+   Net::setBlocking(sgNetWakePipe[1], false);
+
+   sgNetRing = new NetRingSlot[NetRingSize];
+   sgNetRingHead = sgNetRingTail = 0;
+   sgNetThread = new Thread(netThreadMain, NULL);
+   Con::printf("UDP network thread started");
+}
+
+static void stopNetThread()
+{
+   if(!sgNetThread)
+      return;
+
+   char quit = 0;
+   write(sgNetQuitPipe[1], &quit, 1);
+
+   // The destructor joins.
+   delete sgNetThread;
+   sgNetThread = NULL;
+
+   for(U32 i = 0; i < 2; i++)
+   {
+      close(sgNetWakePipe[i]);
+      close(sgNetQuitPipe[i]);
+      sgNetWakePipe[i] = sgNetQuitPipe[i] = -1;
+   }
+
+   delete [] sgNetRing;
+   sgNetRing = NULL;
+}
+
+/// Posts every packet the network thread has queued.
+static void postQueuedPackets()
+{
+   U32 tail = sgNetRingTail;
+   const U32 head = dAtomicLoadAcquire(&sgNetRingHead);
+   const U32 now = Platform::getRealMilliseconds();
+   while(tail != head)
+   {
+      NetRingSlot &slot = sgNetRing[tail & (NetRingSize - 1)];
+
+      const U32 delay = now - slot.arrivalTime;
+      sgNetThreadPackets++;
+      sgNetThreadTotalDelay += delay;
+      sgNetThreadMaxDelay = getMax(sgNetThreadMaxDelay, delay);
+
+      Game->postEvent(slot.event);
+
+      // Hand the slot back.
+      tail++;
+      dAtomicStoreRelease(&sgNetRingTail, tail);
+   }
+}
+
+bool NetWaitForPackets(U32 us, bool threadOnly)
+{
+   pollfd pfd;
+   pfd.events = POLLIN;
+   if(sgNetThread)
+   {
+      if(dAtomicLoadAcquire(&sgNetRingHead) != sgNetRingTail)
+         return true;
+      pfd.fd = sgNetWakePipe[0];
+   }
+   else if(!threadOnly && udpSocket != InvalidSocket)
+      pfd.fd = udpSocket;
+   else
+      return false;
+
+#if defined(__linux__)
+   timespec timeout;
+   timeout.tv_sec = us / 1000000;
+   timeout.tv_nsec = (us % 1000000) * 1000;
+   S32 ret = ppoll(&pfd, 1, &timeout, NULL);
+#else
+   S32 ret = poll(&pfd, 1, (us + 999) / 1000);
+#endif
+
+   if(ret > 0 && sgNetThread)
+   {
+      char buf[64];
+      while(read(sgNetWakePipe[0], buf, sizeof(buf)) > 0)
+         ;
+   }
+   return true;
+}
+
+ConsoleFunction(netThreadStats, void, 1, 1, "netThreadStats() Prints how long packets waited between the "
+                "network thread receiving them and the main thread handling them, and resets the counts.")
+{
+   if(!sgNetThread)
+   {
+      Con::printf("The network thread is not running, set $pref::Net::Thread and reopen the port.");
+      return;
+   }
+
+   Con::printf("Network thread: %d packets, %.2f ms average delay, %d ms max delay", sgNetThreadPackets,
+               sgNetThreadPackets ? F32(sgNetThreadTotalDelay) / sgNetThreadPackets : 0.0f, sgNetThreadMaxDelay);
+   sgNetThreadPackets = 0;
+   sgNetThreadTotalDelay = 0;
+   sgNetThreadMaxDelay = 0;
+}
+
+//-----------------------------------------------------------------------------
+
 bool Net::openPort(S32 port)
 {
+   stopNetThread();
+
    if(udpSocket != InvalidSocket)
       close(udpSocket);
    if(ipxSocket != InvalidSocket)
@@ -372,11 +709,31 @@ bool Net::openPort(S32 port)
       }
    }
    netPort = port;
+
+#ifdef UNIX_NET_BATCHED_IO
+   // sendmmsg() came after recvmmsg(), so if the kernel
+   // has it then it has both.
+   sgBatchedIO = Con::getBoolVariable("$pref::Net::BatchedIO", true);
+   if(sgBatchedIO && udpSocket != InvalidSocket &&
+      sendmmsg(udpSocket, sgSendBatch.msgs, 0, 0) == -1 && errno == ENOSYS)
+   {
+      Con::printf("Batched UDP IO is not supported by this kernel");
+      sgBatchedIO = false;
+   }
+#endif
+
+   if(udpSocket != InvalidSocket && !Game->isJournalReading() &&
+      Con::getBoolVariable("$pref::Net::Thread", false))
+      startNetThread();
+
    return ipxSocket != InvalidSocket || udpSocket != InvalidSocket;
 }
 
 void Net::closePort()
 {
+   stopNetThread();
+   flushSends();
+
    if(ipxSocket != InvalidSocket)
       close(ipxSocket);
    if(udpSocket != InvalidSocket)
@@ -400,6 +757,24 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32 bufferSi
    }
    else
    {
+#ifdef UNIX_NET_BATCHED_IO
+      if(sgBatchedIO && udpSocket != InvalidSocket)
+      {
+         AssertFatal(bufferSize <= MaxPacketDataSize, "Net::sendto - packet is too big!");
+         if(sgSendCount == NetBatchSize)
+            flushSends();
+
+         netToIPSocketAddress(address, &sgSendBatch.addrs[sgSendCount]);
+         dMemcpy(sgSendData[sgSendCount], buffer, bufferSize);
+         sgSendBatch.iov[sgSendCount].iov_len = bufferSize;
+         sgSendCount++;
+         return NoError;
+      }
+
+      // Don't jump ahead of anything still queued.
+      flushSends();
+#endif
+
       sockaddr_in ipAddr;
       netToIPSocketAddress(address, &ipAddr);
       if(::sendto(udpSocket, (const char*)buffer, bufferSize, 0,
@@ -410,16 +785,64 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32 bufferSi
    }
 }
 
+void Net::flushSends()
+{
+#ifdef UNIX_NET_BATCHED_IO
+   if(sgSendCount == 0)
+      return;
+
+   PROFILE_START(NetFlushSends);
+   sendBatch(udpSocket, sgSendBatch, sgSendCount);
+   sgSendCount = 0;
+   PROFILE_END();
+#endif
+}
+
+/// Posts a datagram as a PacketReceiveEvent.
+static void postPacket(const sockaddr *sa, PacketReceiveEvent &receiveEvent, S32 bytesRead)
+{
+   if(fillPacketEvent(sa, receiveEvent, bytesRead))
+      Game->postEvent(receiveEvent);
+}
+
 void Net::process()
 {
    sockaddr sa;
+   bool readUDP = udpSocket != InvalidSocket;
+
+   if(readUDP && sgNetThread)
+   {
+      PROFILE_START(NetPostQueued);
+      postQueuedPackets();
+      PROFILE_END();
+      readUDP = false;
+   }
+
+#ifdef UNIX_NET_BATCHED_IO
+   if(readUDP && sgBatchedIO)
+   {
+      // Drain the socket a batch at a time, posting
+      // the events right out of the ring.
+      PROFILE_START(NetRecvBatched);
+      for(;;)
+      {
+         S32 count = recvBatch(udpSocket, sgRecvBatch, NetBatchSize);
+         for(S32 i = 0; i < count; i++)
+            postPacket((sockaddr *) &sgRecvBatch.addrs[i], sgRecvEvents[i], sgRecvBatch.msgs[i].msg_len);
+         if(count < NetBatchSize)
+            break;
+      }
+      PROFILE_END();
+      readUDP = false;
+   }
+#endif
 
    PacketReceiveEvent receiveEvent;
    for(;;)
    {
       U32 addrLen = sizeof(sa);
       S32 bytesRead = -1;
-      if(udpSocket != InvalidSocket)
+      if(readUDP)
          bytesRead = recvfrom(udpSocket, (char *) receiveEvent.data, MaxPacketDataSize, 0, &sa, &addrLen);
       if(bytesRead == -1 && ipxSocket != InvalidSocket)
       {
@@ -429,28 +852,13 @@ void Net::process()
       
       if(bytesRead == -1)
          break;
-      
-      if(sa.sa_family == AF_INET)
-         IPSocketToNetAddress((sockaddr_in *) &sa, &receiveEvent.sourceAddress);
-      else if(sa.sa_family == AF_IPX)
-         IPXSocketToNetAddress((sockaddr_ipx *) &sa, &receiveEvent.sourceAddress);
-      else
-         continue;
-         
-      NetAddress &na = receiveEvent.sourceAddress;
-      if(na.type == NetAddress::IPAddress &&
-         na.netNum[0] == 127 &&
-         na.netNum[1] == 0 &&
-         na.netNum[2] == 0 &&
-         na.netNum[3] == 1 &&
-         na.port == netPort)
-         continue;
-      if(bytesRead <= 0)
-         continue;
-      receiveEvent.size = PacketReceiveEventHeaderSize + bytesRead;
-      Game->postEvent(receiveEvent);
+
+      postPacket(&sa, receiveEvent, bytesRead);
    }
 
+   // Send anything we replied with right away.
+   flushSends();
+
    // process the polled sockets.  This blob of code performs functions
    // similar to WinsockProc in winNet.cc
 
@@ -906,3 +1314,118 @@ Net::Error getLastError()
    return Net::UnknownError;
 }
 
+
+//-----------------------------------------------------------------------------
+
+#ifdef UNIX_NET_BATCHED_IO
+
+/// Opens a non-blocking UDP socket on an ephemeral loopback port.
+static int openBenchSocket(sockaddr_in *addr)
+{
+   int fd = socket(AF_INET, SOCK_DGRAM, 0);
+   if(fd == InvalidSocket)
+      return InvalidSocket;
+
+   dMemset(addr, 0, sizeof(sockaddr_in));
+   addr->sin_family = AF_INET;
+   addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+   socklen_t len = sizeof(sockaddr_in);
+   if(::bind(fd, (sockaddr *) addr, sizeof(sockaddr_in)) == -1 ||
+      getsockname(fd, (sockaddr *) addr, &len) == -1 ||
+      Net::setBufferSize(fd, 1024 * 1024) != Net::NoError ||
+      Net::setBlocking(fd, false) != Net::NoError)
+   {
+      close(fd);
+      return InvalidSocket;
+   }
+   return fd;
+}
+
+ConsoleFunction(netBenchLoopback, void, 1, 3, "([packets=200000], [size=200]) Sends packets over loopback "
+                "one syscall per packet and then in batches, and reports packets/second and syscalls for each.")
+{
+   S32 numPackets = argc > 1 ? getMax(dAtoi(argv[1]), 1) : 200000;
+   S32 size = argc > 2 ? mClamp(dAtoi(argv[2]), 1, (S32)MaxPacketDataSize) : 200;
+
+   sockaddr_in txAddr, rxAddr;
+   int tx = openBenchSocket(&txAddr);
+   int rx = openBenchSocket(&rxAddr);
+   if(tx == InvalidSocket || rx == InvalidSocket)
+   {
+      Con::errorf("netBenchLoopback - unable to open the loopback sockets.");
+      if(tx != InvalidSocket)
+         close(tx);
+      if(rx != InvalidSocket)
+         close(rx);
+      return;
+   }
+
+   // The benchmark borrows the game's rings.
+   Net::flushSends();
+
+   U8 packet[MaxPacketDataSize];
+   U8 buffer[MaxPacketDataSize];
+   for(S32 i = 0; i < size; i++)
+      packet[i] = U8(i);
+
+   Con::printf("netBenchLoopback - %d packets of %d bytes", numPackets, size);
+
+   for(U32 pass = 0; pass < 2; pass++)
+   {
+      S32 sent = 0;
+      S32 received = 0;
+      U32 calls = 0;
+
+      U32 start = Platform::getRealMilliseconds();
+      while(sent < numPackets)
+      {
+         // Send a batch worth, then drain the receiver so
+         // the socket buffer never overflows.
+         U32 count = getMin(numPackets - sent, (S32)NetBatchSize);
+         if(pass == 0)
+         {
+            for(U32 i = 0; i < count; i++, calls++)
+               ::sendto(tx, packet, size, 0, (sockaddr *) &rxAddr, sizeof(sockaddr_in));
+
+            for(;;)
+            {
+               calls++;
+               if(recvfrom(rx, buffer, MaxPacketDataSize, 0, NULL, NULL) <= 0)
+                  break;
+               received++;
+            }
+         }
+         else
+         {
+            for(U32 i = 0; i < count; i++)
+            {
+               sgSendBatch.addrs[i] = rxAddr;
+               dMemcpy(sgSendData[i], packet, size);
+               sgSendBatch.iov[i].iov_len = size;
+            }
+            calls += sendBatch(tx, sgSendBatch, count);
+
+            for(;;)
+            {
+               calls++;
+               S32 got = recvBatch(rx, sgRecvBatch, NetBatchSize);
+               if(got <= 0)
+                  break;
+               received += got;
+               if(got < NetBatchSize)
+                  break;
+            }
+         }
+         sent += count;
+      }
+      U32 elapsed = getMax(Platform::getRealMilliseconds() - start, U32(1));
+
+      Con::printf("   %s: %d ms, %.0f packets/second, %.2f syscalls/packet, %d lost", pass ? "Batched" : "Single ",
+                  elapsed, F64(received) * 1000.0 / elapsed, F64(calls) / getMax(received, 1), sent - received);
+   }
+
+   close(tx);
+   close(rx);
+}
+
+#endif
@@ -18,9 +18,8 @@
 void * Semaphore::createSemaphore(U32 initialCount)
 {
 #if defined(__linux__)
-   sem_t *semaphore;
-   /* hell, I want an elite semaphore, OK?! - rjp */
-   semaphore = sem_open("/tmp/eliteQueue.31337", O_CREAT, 0664, initialCount);
+   sem_t *semaphore = new sem_t;
+   sem_init(semaphore, 0, initialCount);
    return(semaphore);
 #elif defined(__OpenBSD__)
    key_t mykey;
@@ -34,7 +33,8 @@ void Semaphore::destroySemaphore(void * semaphore)
 {
    AssertFatal(semaphore, "Semaphore::destroySemaphore: invalid semaphore");
 #if defined(__linux__)
-   sem_close((sem_t *)semaphore);
+   sem_destroy((sem_t *)semaphore);
+   delete (sem_t *)semaphore;
 #elif defined(__OpenBSD__)
    semctl((*(int *)semaphore), 0, IPC_RMID, 0);
 #endif
@@ -75,7 +75,7 @@ void Semaphore::releaseSemaphore(void * semaphore)
 {
    AssertFatal(semaphore, "Semaphore::releaseSemaphore: invalid semaphore");
 #if defined(__linux__)
-   sem_unlink("/tmp/eliteQueue.31337");
+   sem_post((sem_t *)semaphore);
 #elif defined(__OpenBSD__)
    struct sembuf sem_unlock = { 0, 1, IPC_NOWAIT};
    semop(*(int *)semaphore, &sem_unlock, 1);
@@ -77,7 +77,12 @@ bool Thread::join()
       return(false);
 
    x86UNIXThreadData * threadData = reinterpret_cast<x86UNIXThreadData*>(mData);
-   return(Semaphore::acquireSemaphore(threadData->mSemaphore));
+   bool ret = Semaphore::acquireSemaphore(threadData->mSemaphore);
+
+   // Leave it signalled, so the thread reads as finished and joining it
+   // again (the destructor does) doesn't block forever.
+   Semaphore::releaseSemaphore(threadData->mSemaphore);
+   return(ret);
 }
 
 void Thread::run(void* arg)
@@ -6,6 +6,7 @@
 
 
 #include "console/console.h"
+#include "console/consoleTypes.h"
 #include "core/fileStream.h"
 //#include "game/resource.h"
 #include "game/version.h"
@@ -22,6 +23,7 @@
 #include "platform/platformInput.h"
 #include "platform/platformVideo.h"
 #include "platform/profiler.h"
+#include "sim/processList.h"
 #include "platformX86UNIX/platformGL.h"
 #include "platformX86UNIX/x86UNIXOGLVideo.h"
 #include "platformX86UNIX/x86UNIXState.h"
@@ -412,6 +414,152 @@ static inline void Sleep(int secs, int nanoSecs)
    nanosleep(&sleeptime, NULL);
 }
 
+//------------------------------------------------------------------------------
+// Tick scheduler
+//
+// Without a window, TimeManager::process() only posts a TimeEvent once the
+// game's next server tick is due, and Platform::process() sleeps until then
+// or until a packet comes in.  So the server runs its ticks TickMs apart
+// instead of whenever a 1 ms sleep or a spin happens to line up.
+
+/// $pref::Server::TickScheduler
+static bool sgTickScheduler = true;
+
+/// Real time up to which TimeEvents have been posted, in microseconds.
+static U64 sgTickTimeUs = 0;
+
+/// When the next TimeEvent is due, or 0 if we don't know yet.
+static U64 sgTickDeadlineUs = 0;
+
+enum {
+   /// Time events are posted at least this often when the
+   /// game has no ticks to run, as they used to be.
+   UnscheduledMs = 6,
+
+   NumJitterBuckets = 8,
+};
+
+/// Upper bounds in microseconds of how late a tick started for each
+/// bucket of the histogram, the last catching everything else.
+static const U32 sgJitterBucketUs[NumJitterBuckets - 1] = {
+   250, 500, 1000, 2000, 4000, 8000, 16000
+};
+
+static U32 sgTickCount = 0;
+static U32 sgTickOverruns = 0;
+static U32 sgTicksBehind = 0;
+static U32 sgTickMaxLateUs = 0;
+static U32 sgTickMaxWorkUs = 0;
+static U32 sgTickJitter[NumJitterBuckets];
+
+static U64 getMonotonicMicroseconds()
+{
+   timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return U64(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
+static bool useTickScheduler()
+{
+   return sgTickScheduler && !x86UNIXState->windowCreated() && !Game->isJournalReading();
+}
+
+static U32 getTimeEventDueMs()
+{
+   S32 untilTick = Game->getTimeUntilTick();
+   return untilTick < 0 ? UnscheduledMs : getMax(untilTick, 1);
+}
+
+/// Posts a TimeEvent if one is due and keeps the stats.
+static void processScheduledTime()
+{
+   U64 now = getMonotonicMicroseconds();
+   if (sgTickTimeUs == 0)
+      sgTickTimeUs = now - U64(Platform::getRealMilliseconds() - lastTimeTick) * 1000;
+
+   U32 due = getTimeEventDueMs();
+   sgTickDeadlineUs = sgTickTimeUs + U64(due) * 1000;
+   if (now < sgTickDeadlineUs)
+      return;
+
+   TimeEvent event;
+   event.elapsedTime = U32((now - sgTickTimeUs) / 1000);
+
+   // Carry the leftover microseconds so we don't drift.
+   sgTickTimeUs += U64(event.elapsedTime) * 1000;
+   lastTimeTick = Platform::getRealMilliseconds();
+
+   bool ticking = Game->getTimeUntilTick() >= 0;
+   Game->postEvent(event);
+
+   if (ticking)
+   {
+      const U32 lateUs = U32(now - sgTickDeadlineUs);
+      const U32 workUs = U32(getMonotonicMicroseconds() - now);
+
+      U32 bucket = 0;
+      while (bucket < NumJitterBuckets - 1 && lateUs >= sgJitterBucketUs[bucket])
+         bucket++;
+
+      sgTickCount++;
+      sgTickJitter[bucket]++;
+      sgTickMaxLateUs = getMax(sgTickMaxLateUs, lateUs);
+      sgTickMaxWorkUs = getMax(sgTickMaxWorkUs, workUs);
+      if (workUs > TickMs * 1000)
+         sgTickOverruns++;
+      sgTicksBehind += (event.elapsedTime - due) / TickMs;
+   }
+
+   sgTickDeadlineUs = sgTickTimeUs + U64(getTimeEventDueMs()) * 1000;
+}
+
+/// Sleeps until the next TimeEvent is due, waking early for packets.
+static void waitForScheduledTime()
+{
+   U64 now = getMonotonicMicroseconds();
+   if (sgTickDeadlineUs <= now)
+      return;
+
+   if (!NetWaitForPackets(U32(sgTickDeadlineUs - now)))
+   {
+      // No port to listen on, just sleep.
+      timespec deadline;
+      deadline.tv_sec = sgTickDeadlineUs / 1000000;
+      deadline.tv_nsec = (sgTickDeadlineUs % 1000000) * 1000;
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR)
+         ;
+   }
+}
+
+ConsoleFunction( tickStats, void, 1, 1, "tickStats() Prints how late server ticks started, "
+   "how many overran TickMs, and a histogram of the lateness, then resets the counts." )
+{
+   if (!useTickScheduler())
+   {
+      Con::printf("The tick scheduler is not running.");
+      return;
+   }
+
+   Con::printf("%d ticks, %d overran %d ms, %d ticks behind, %.2f ms max late, %.2f ms max work",
+      sgTickCount, sgTickOverruns, TickMs, sgTicksBehind, sgTickMaxLateUs / 1000.0f, sgTickMaxWorkUs / 1000.0f);
+
+   for (U32 i = 0; i < NumJitterBuckets; i++)
+   {
+      const F32 percent = sgTickCount ? 100.0f * sgTickJitter[i] / sgTickCount : 0.0f;
+      if (i < NumJitterBuckets - 1)
+         Con::printf("   < %5.2f ms late: %8d (%5.1f%%)", sgJitterBucketUs[i] / 1000.0f, sgTickJitter[i], percent);
+      else
+         Con::printf("   >=%5.2f ms late: %8d (%5.1f%%)", sgJitterBucketUs[i - 1] / 1000.0f, sgTickJitter[i], percent);
+   }
+
+   sgTickCount = 0;
+   sgTickOverruns = 0;
+   sgTicksBehind = 0;
+   sgTickMaxLateUs = 0;
+   sgTickMaxWorkUs = 0;
+   dMemset(sgTickJitter, 0, sizeof(sgTickJitter));
+}
+
 #ifndef DEDICATED
 struct AlertWinState
 {
@@ -671,12 +819,21 @@ void Platform::process()
       // there are no players connected.
       // JMQ: recent kernels (such as RH 8.0 2.4.18) reduce the latency
       // to 2-4 ms on average.
-      if (!Game->isJournalReading() && (x86UNIXState->getDSleep() ||
-             Con::getIntVariable("Server::PlayerCount") -
-             Con::getIntVariable("Server::BotCount") <= 0))
+      // With the network thread running we always sleep, since a packet
+      // coming in wakes us right up.
+      if (useTickScheduler())
+      {
+         PROFILE_START(XUX_WaitForTick);
+         waitForScheduledTime();
+         PROFILE_END();
+      }
+      else if (!Game->isJournalReading())
       {
          PROFILE_START(XUX_Sleep);
-         Sleep(0, 1000000);
+         if (!NetWaitForPackets(1000, true) && (x86UNIXState->getDSleep() ||
+             Con::getIntVariable("Server::PlayerCount") -
+             Con::getIntVariable("Server::BotCount") <= 0))
+            Sleep(0, 1000000);
          PROFILE_END();
       }
    }
@@ -741,6 +898,8 @@ void Platform::init()
 
    StdConsole::create();
 
+   Con::addVariable( "pref::Server::TickScheduler", TypeBool, &sgTickScheduler );
+
 #ifndef DEDICATED
    // if we're not dedicated do more initialization
    if (!x86UNIXState->isDedicated())
@@ -942,6 +1101,13 @@ bool Platform::setLoginPassword( const char* password )
 //-------------------------------------------------------------------------------
 void TimeManager::process()
 {
+   if (useTickScheduler())
+   {
+      processScheduledTime();
+      return;
+   }
+   sgTickTimeUs = 0;
+
    U32 curTime = Platform::getRealMilliseconds();
    TimeEvent event;
    event.elapsedTime = curTime - lastTimeTick;
@@ -22,22 +22,11 @@ void RenderElemMgr::addElement(RenderInst* inst)
     mElementList.increment();
     MainSortElem& elem = mElementList.last();
     elem.inst = inst;
-    elem.key = elem.key2 = 0;
 
-    // sort by material
-    if (inst->matInst)
-    {
-        // TODO: might break under 64 bit
-        elem.key = static_cast<SimObjectId>(reinterpret_cast<size_t>(inst->matInst->getMaterial()));
-    }
-
-    // sort by vertex buffer
+    // sort by matInst, then material, then vertex buffer
+    elem.key = makeWeightKey(inst->matInst) | makeMaterialKey(inst->matInst);
     if (inst->vertBuff)
-    {
-        // TODO: might break under 64 bit
-        elem.key2 = static_cast<SimObjectId>(reinterpret_cast<size_t>(inst->vertBuff->getPointer()));
-    }
-
+        elem.key |= makePointerKey(inst->vertBuff->getPointer());
 }
 
 //-----------------------------------------------------------------------------
@@ -53,29 +42,77 @@ void RenderElemMgr::clear()
 //-----------------------------------------------------------------------------
 void RenderElemMgr::sort()
 {
-    dQsort(mElementList.address(), mElementList.size(), sizeof(MainSortElem), cmpKeyFunc);
+    radixSort(mElementList, mSortScratch);
 }
 
 //-----------------------------------------------------------------------------
-// QSort callback function
+// radixSort
 //-----------------------------------------------------------------------------
-S32 FN_CDECL RenderElemMgr::cmpKeyFunc(const void* p1, const void* p2)
+void RenderElemMgr::radixSort(Vector<MainSortElem>& list, Vector<MainSortElem>& scratch)
 {
-    const MainSortElem* mse1 = (const MainSortElem*)p1;
-    const MainSortElem* mse2 = (const MainSortElem*)p2;
+    const U32 count = list.size();
+    if (count < 2)
+        return;
 
-    // dynamic lights *MUST* be rendered after the base pass!
-    if (mse1->inst && mse1->inst->matInst &&
-        mse2->inst && mse2->inst->matInst)
+    // Small bins aren't worth clearing the histograms for.
+    if (count <= 32)
     {
-        S32 testA = mse1->inst->matInst->compare(mse2->inst->matInst);
-        if (testA != 0)
-            return testA;
+        MainSortElem* elems = list.address();
+        for (U32 i = 1; i < count; i++)
+        {
+            MainSortElem elem = elems[i];
+            S32 j = i - 1;
+            for (; j >= 0 && elems[j].key > elem.key; j--)
+                elems[j + 1] = elems[j];
+            elems[j + 1] = elem;
+        }
+        return;
     }
 
-    S32 test1 = S32(mse2->key) - S32(mse1->key);
+    // Count all eight bytes in one go.
+    U32 histogram[8][256];
+    dMemset(histogram, 0, sizeof(histogram));
+
+    const MainSortElem* elems = list.address();
+    for (U32 i = 0; i < count; i++)
+    {
+        U64 key = elems[i].key;
+        for (U32 b = 0; b < 8; b++)
+            histogram[b][(key >> (b * 8)) & 0xFF]++;
+    }
+
+    scratch.setSize(count);
+    MainSortElem* src = list.address();
+    MainSortElem* dst = scratch.address();
+
+    for (U32 b = 0; b < 8; b++)
+    {
+        U32* bucket = histogram[b];
+        const U32 shift = b * 8;
+
+        // Skip the byte if every key has the same value there, which
+        // is most of them in a typical bin.
+        if (bucket[(src[0].key >> shift) & 0xFF] == count)
+            continue;
+
+        U32 offset = 0;
+        for (U32 i = 0; i < 256; i++)
+        {
+            U32 num = bucket[i];
+            bucket[i] = offset;
+            offset += num;
+        }
+
+        for (U32 i = 0; i < count; i++)
+            dst[bucket[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+        MainSortElem* temp = src;
+        src = dst;
+        dst = temp;
+    }
 
-    return (test1 == 0) ? S32(mse2->key2) - S32(mse1->key2) : test1;
+    if (src != list.address())
+        dMemcpy(list.address(), src, count * sizeof(MainSortElem));
 }
 
 void RenderElemMgr::setupSGData( RenderInst *ri, SceneGraphData &data )
@@ -14,15 +14,34 @@
 class RenderElemMgr
 {
 public:
+    /// The bin is sorted on key alone, smallest first.  From the top bit down
+    /// the default key is:
+    ///    - 8 bits of MatInstance sort weight
+    ///    - 24 bits of material id
+    ///    - 32 bits of vertex buffer
+    /// Managers that want a different order build their own key in addElement().
     struct MainSortElem
     {
         RenderInst* inst;
-        U32 key;
-        U32 key2;
+        U64 key;
     };
 
+    /// @name Key packing
+    /// @{
+
+    static U64 makeWeightKey(MatInstance* matInst);
+    static U64 makeMaterialKey(MatInstance* matInst);
+    static U64 makePointerKey(const void* ptr);
+
+    /// @}
+
+    /// Stable radix sort of list on MainSortElem::key, using scratch
+    /// as the second buffer.  Keep scratch around to avoid allocating.
+    static void radixSort(Vector<MainSortElem>& list, Vector<MainSortElem>& scratch);
+
 protected:
     Vector< MainSortElem > mElementList;
+    Vector< MainSortElem > mSortScratch;
 
     virtual void setupSGData( RenderInst *ri, SceneGraphData &data );
     bool newPassNeeded(MatInstance* currMatInst, RenderInst* ri);
@@ -34,14 +53,41 @@ public:
     virtual void render() {};
     virtual void clear();
 
-    static S32 FN_CDECL cmpKeyFunc(const void* p1, const void* p2);
-
+    const Vector< MainSortElem >& getElementList() const { return mElementList; }
 };
 
-// The bin is sorted by (see RenderElemMgr::cmpKeyFunc)
-//    1.  MaterialInstance type (currently just MatInstance and sgMatInstance, sgMatInstance is last)
+//-----------------------------------------------------------------------------
+// Key packing
+//-----------------------------------------------------------------------------
+inline U64 RenderElemMgr::makeWeightKey(MatInstance* matInst)
+{
+    if (!matInst)
+        return 0;
+
+    U32 weight = matInst->getSortWeight();
+    return U64(weight > 0xFF ? 0xFF : weight) << 56;
+}
+
+inline U64 RenderElemMgr::makeMaterialKey(MatInstance* matInst)
+{
+    if (!matInst || !matInst->getMaterial())
+        return 0;
+
+    // Ids past 24 bits wrap, which only costs an extra state change.
+    return U64(matInst->getMaterial()->getId() & 0xFFFFFF) << 32;
+}
+
+inline U64 RenderElemMgr::makePointerKey(const void* ptr)
+{
+    // Fold the whole pointer into 32 bits, dropping the alignment bits.
+    U64 val = U64(reinterpret_cast<size_t>(ptr));
+    return U32(val >> 4) ^ U32(val >> 36);
+}
+
+// The bin is sorted by (see RenderElemMgr::addElement)
+//    1.  MaterialInstance sort weight
 //    2.  Material
-//    3.  Manager specific key (vertex buffer address by default)
+//    3.  Manager specific key (vertex buffer by default)
 // This function is called on each item of the bin and basically detects any changes in conditions 1 or 2
 inline bool RenderElemMgr::newPassNeeded(MatInstance* currMatInst, RenderInst* ri)
 {
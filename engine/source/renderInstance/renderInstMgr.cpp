@@ -286,16 +286,94 @@ void RenderInstManager::addInst(RenderInst* inst)
 
 
 //-----------------------------------------------------------------------------
-// QSort callback function
+// QSort callback function - the bin sort before the radix sort, only kept
+// around for benchRenderSort().
 //-----------------------------------------------------------------------------
-S32 FN_CDECL cmpKeyFunc(const void* p1, const void* p2)
+static S32 FN_CDECL cmpKeyFunc(const void* p1, const void* p2)
 {
     const RenderElemMgr::MainSortElem* mse1 = (const RenderElemMgr::MainSortElem*)p1;
     const RenderElemMgr::MainSortElem* mse2 = (const RenderElemMgr::MainSortElem*)p2;
 
-    S32 test1 = S32(mse1->key) - S32(mse2->key);
+    if (mse1->inst && mse1->inst->matInst &&
+        mse2->inst && mse2->inst->matInst)
+    {
+        S32 testA = mse1->inst->matInst->compare(mse2->inst->matInst);
+        if (testA != 0)
+            return testA;
+    }
 
-    return (test1 == 0) ? S32(mse1->key2) - S32(mse2->key2) : test1;
+    if (mse1->key == mse2->key)
+        return 0;
+    return (mse1->key < mse2->key) ? -1 : 1;
+}
+
+static U32 sgBenchSortIterations = 0;
+
+//-----------------------------------------------------------------------------
+// benchSort - times qsort against the radix sort on this frame's bins
+//-----------------------------------------------------------------------------
+void RenderInstManager::benchSort(U32 iterations)
+{
+    Vector<RenderElemMgr::MainSortElem> work;
+    Vector<RenderElemMgr::MainSortElem> sorted;
+    Vector<RenderElemMgr::MainSortElem> scratch;
+
+    U32 numBins = 0;
+    U32 numElems = 0;
+    U32 qsortMs = 0;
+    U32 radixMs = 0;
+    bool match = true;
+
+    for (U32 i = 0; i <= NumRenderBins; i++)
+    {
+        RenderElemMgr* bin = (i < NumRenderBins) ? mRenderBins[i] : mZOnlyBin;
+
+        // The object bins are never sorted.
+        if (!bin || dynamic_cast<RenderObjectMgr*>(bin))
+            continue;
+
+        const Vector<RenderElemMgr::MainSortElem>& list = bin->getElementList();
+        if (list.size() < 2)
+            continue;
+
+        numBins++;
+        numElems += list.size();
+
+        U32 start = Platform::getRealMilliseconds();
+        for (U32 j = 0; j < iterations; j++)
+        {
+            work = list;
+            dQsort(work.address(), work.size(), sizeof(RenderElemMgr::MainSortElem), cmpKeyFunc);
+        }
+        qsortMs += Platform::getRealMilliseconds() - start;
+        sorted = work;
+
+        start = Platform::getRealMilliseconds();
+        for (U32 j = 0; j < iterations; j++)
+        {
+            work = list;
+            RenderElemMgr::radixSort(work, scratch);
+        }
+        radixMs += Platform::getRealMilliseconds() - start;
+
+        for (S32 j = 0; j < work.size(); j++)
+        {
+            if (work[j].key != sorted[j].key)
+                match = false;
+        }
+    }
+
+    if (!numElems)
+    {
+        Con::printf("benchRenderSort: nothing to sort in this frame");
+        return;
+    }
+
+    Con::printf("benchRenderSort: %d elements in %d bins, %d iterations", numElems, numBins, iterations);
+    Con::printf("   qsort: %d ms", qsortMs);
+    Con::printf("   radix: %d ms", radixMs);
+    if (!match)
+        Con::errorf("benchRenderSort: sorts disagree on key order!");
 }
 
 //-----------------------------------------------------------------------------
@@ -305,6 +383,12 @@ void RenderInstManager::sort()
 {
     PROFILE_START(RIM_sort);
 
+    if (sgBenchSortIterations && mRenderBins.size())
+    {
+        benchSort(sgBenchSortIterations);
+        sgBenchSortIterations = 0;
+    }
+
     if (mRenderBins.size())
     {
         for (U32 i = 0; i < NumRenderBins; i++)
@@ -411,6 +495,13 @@ void RenderInstManager::renderToZBuff(GFXTarget* target)
 // initRenderInstManager - do this through script because there's no good place to
 // init after device creation in code.
 //-----------------------------------------------------------------------------
+ConsoleFunction(benchRenderSort, void, 1, 2, "benchRenderSort([iterations=1000])\n"
+                "Times sorting the render bins of the next frame with the old qsort and with "
+                "the radix sort.  Works with the NullDevice for a headless run.")
+{
+    sgBenchSortIterations = (argc > 1) ? getMax(dAtoi(argv[1]), 1) : 1000;
+}
+
 /*ConsoleFunction( initRenderInstManager, void, 1, 1, "initRenderInstManager")
 {
    gRenderInstManager.init();
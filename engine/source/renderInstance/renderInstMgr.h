@@ -205,6 +205,7 @@ public:
     void uninit();
     void clear();  // clear instances, matrices
     void sort();
+    void benchSort(U32 iterations);
     void render();
     void renderToZBuff(GFXTarget* target);
     void renderGlow();
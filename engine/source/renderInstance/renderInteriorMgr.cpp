@@ -36,32 +36,6 @@ void RenderInteriorMgr::setupSGData(RenderInst* ri, SceneGraphData& data)
     ri->miscTex = NULL;
 }
 
-//-----------------------------------------------------------------------------
-// addElement
-//-----------------------------------------------------------------------------
-void RenderInteriorMgr::addElement(RenderInst* inst)
-{
-    mElementList.increment();
-    MainSortElem& elem = mElementList.last();
-    elem.inst = inst;
-    elem.key = elem.key2 = 0;
-
-    // sort by material and matInst
-    if (inst->matInst)
-    {
-        // TODO: might break under 64 bit
-        elem.key = static_cast<U32>(reinterpret_cast<size_t>(inst->matInst->getMaterial()));
-    }
-
-    // sort by vertex buffer
-    if (inst->vertBuff)
-    {
-        // TODO: might break under 64 bit
-        elem.key2 = static_cast<U32>(reinterpret_cast<size_t>(inst->vertBuff->getPointer()));
-    }
-
-}
-
 //-----------------------------------------------------------------------------
 // render
 //-----------------------------------------------------------------------------
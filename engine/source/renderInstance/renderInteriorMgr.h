@@ -25,7 +25,6 @@ public:
     ~RenderInteriorMgr();
 
     virtual void render();
-    virtual void addElement(RenderInst* inst);
 };
 
 
@@ -8,8 +8,6 @@
 #include "materials/matInstance.h"
 #include "../../game/shaders/shdrConsts.h"
 
-#define HIGH_NUM ((U32(-1)/2) - 1)
-
 //**************************************************************************
 // RenderTranslucentMgr
 //**************************************************************************
@@ -35,26 +33,21 @@ void RenderTranslucentMgr::addElement(RenderInst* inst)
     mElementList.increment();
     MainSortElem& elem = mElementList.last();
     elem.inst = inst;
-    //   elem.key = elem.key2 = 0;
-
-    // sort by distance
-    //elem.key = HIGH_NUM - U64((gRenderInstManager.getCamPos() - inst->sortPoint).lenSquared() * 2500.0);
 
-    // sort by distance (the multiply is there to prevent us from losing information when converting to a U32)
+    // sort by distance, farthest first.  Positive floats order the
+    // same as their bits, so flip them to get the far ones up front.
     F32 camDist = (gRenderInstManager.getCamPos() - inst->sortPoint).len();
-    elem.key = *((U32*)&camDist);
-
-    //F32 camDist = HIGH_NUM - (gRenderInstManager.getCamPos() - inst->sortPoint).lenSquared() * 2500.0f;
-    //elem.key = *((U32*)&camDist);
+    U32 distKey = ~*((U32*)&camDist);
 
-    // we want key2 to sort by Material, but if the matInst is null, we can't.
+    // then by Material, but if the matInst is null, we can't.
     // in that case, use the "miscTex" for the secondary key
-
-    // TODO: might break under 64 bit
+    U64 matKey;
     if (inst->matInst == NULL)
-        elem.key2 = static_cast<U32>(reinterpret_cast<size_t>(inst->miscTex));
+        matKey = makePointerKey(inst->miscTex) & 0xFFFFFF;
     else
-        elem.key2 = static_cast<U32>(reinterpret_cast<size_t>(inst->matInst->getMaterial()));
+        matKey = makeMaterialKey(inst->matInst) >> 32;
+
+    elem.key = makeWeightKey(inst->matInst) | (U64(distKey) << 24) | matKey;
 }
 
 //-----------------------------------------------------------------------------
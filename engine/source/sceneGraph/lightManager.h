@@ -52,7 +52,6 @@ class LightInfo
 typedef Vector<LightInfo*> LightInfoList;
 
 
-/*
 //------------------------------------------------------------------------------
 class SimObject;
 class SceneObject;
@@ -14,6 +14,7 @@
 #endif
 #include "sim/decalManager.h"
 #include "sceneGraph/detailManager.h"
+#include "ts/tsShapeInstance.h"
 #include "core/fileStream.h"
 #include "platform/profiler.h"
 #include "renderInstance/renderInstMgr.h"
@@ -28,6 +29,8 @@ SceneGraph* gServerSceneGraph = NULL;
 SceneGraph* gSPModeSceneGraph = NULL;
 const U32 SceneGraph::csmRefPoolBlockSize = 4096;
 F32 SceneGraph::smVisibleDistanceMod = 1.0;
+bool SceneGraph::smUseScopeSnapshot = true;
+F32 SceneGraph::smScopeCellSize = 64.0f;
 
 F32 SceneGraph::mHazeArray[FogTextureDistSize];
 U32 SceneGraph::mHazeArrayi[FogTextureDistSize];
@@ -42,6 +45,12 @@ SceneGraph::SceneGraph(bool isClient)
     VECTOR_SET_ASSOCIATION(mRefPoolBlocks);
     VECTOR_SET_ASSOCIATION(mZoneManagers);
     VECTOR_SET_ASSOCIATION(mZoneLists);
+    VECTOR_SET_ASSOCIATION(mScopeObjects);
+    VECTOR_SET_ASSOCIATION(mScopeLargeObjects);
+    VECTOR_SET_ASSOCIATION(mScopeBucketStart);
+    VECTOR_SET_ASSOCIATION(mScopeBucketObjects);
+
+    mScopeSnapshotDirty = true;
 
     mHazeArrayDirty = true;
     mCurrZoneEnd = 0;
@@ -184,6 +193,10 @@ void SceneGraph::renderScene(const U32 objectMask)
     //PROFILE_END();
 
 
+    // Get the shapes drawn last time animated in parallel; prepping them
+    // below will then have little animating left to do.
+    TSShapeInstance::animateQueued();
+
     DetailManager::beginPrepRender();
 
     PROFILE_START(BuildSceneTree);
@@ -418,10 +431,116 @@ inline void scopeCallback(SceneObject* obj, ScopingInfo* pInfo)
     }
 }
 
+void SceneGraph::scopeSnapshotObjects(SceneObject** objects, U32 count, ScopingInfo* pInfo)
+{
+    pInfo->connection->getScopeStats().objectsExamined += count;
+
+    for (U32 i = 0; i < count; i++) {
+        SceneObject* pObject = objects[i];
+        if (pObject->mLastStateKey == smStateKey)
+            continue;
+        pObject->mLastStateKey = smStateKey;
+
+        // Only scope it if it's in one of the zones this query reached.
+        for (SceneObjectRef* walk = pObject->mZoneRefHead; walk; walk = walk->nextInObj) {
+            if (pInfo->zoneScopeStates[walk->zone]) {
+                scopeCallback(pObject, pInfo);
+                break;
+            }
+        }
+    }
+}
+
+void SceneGraph::getScopeCellRange(const Point3F& center, F32 radius, S32& minX, S32& minY, S32& maxX, S32& maxY) const
+{
+    F32 invCellSize = 1.0f / smScopeCellSize;
+    minX = S32(mFloor((center.x - radius) * invCellSize));
+    minY = S32(mFloor((center.y - radius) * invCellSize));
+    maxX = S32(mFloor((center.x + radius) * invCellSize));
+    maxY = S32(mFloor((center.y + radius) * invCellSize));
+}
+
+void SceneGraph::buildScopeSnapshot()
+{
+    PROFILE_START(SG_BuildScopeSnapshot);
+
+    mScopeObjects.clear();
+    mScopeLargeObjects.clear();
+    mScopeBucketObjects.clear();
+    mScopeBucketStart.setSize(ScopeBucketCount + 1);
+    dMemset(mScopeBucketStart.address(), 0, sizeof(U32) * (ScopeBucketCount + 1));
+
+    // Objects in several zones only go in once.
+    smStateKey++;
+    U32 i;
+    for (i = 0; i < mCurrZoneEnd; i++)
+    {
+        if (mZoneLists[i] == NULL)
+            continue;
+
+        for (SceneObjectRef* walk = mZoneLists[i]->nextInBin; walk; walk = walk->nextInBin)
+        {
+            SceneObject* obj = walk->object;
+            if (obj->mLastStateKey != smStateKey)
+            {
+                obj->mLastStateKey = smStateKey;
+                mScopeObjects.push_back(obj);
+            }
+        }
+    }
+
+    // Count, then fill, the buckets.
+    S32 minX, minY, maxX, maxY, x, y;
+    for (S32 j = 0; j < mScopeObjects.size(); j++)
+    {
+        const SphereF& sphere = mScopeObjects[j]->getWorldSphere();
+        getScopeCellRange(sphere.center, sphere.radius, minX, minY, maxX, maxY);
+        if (F32(maxX - minX + 1) * F32(maxY - minY + 1) > ScopeMaxObjectCells)
+            continue;
+
+        for (y = minY; y <= maxY; y++)
+            for (x = minX; x <= maxX; x++)
+                mScopeBucketStart[getScopeBucket(x, y) + 1]++;
+    }
+
+    for (i = 1; i <= ScopeBucketCount; i++)
+        mScopeBucketStart[i] += mScopeBucketStart[i - 1];
+
+    mScopeBucketObjects.setSize(mScopeBucketStart[ScopeBucketCount]);
+    U32 fill[ScopeBucketCount];
+    dMemcpy(fill, mScopeBucketStart.address(), sizeof(fill));
+    for (S32 j = 0; j < mScopeObjects.size(); j++)
+    {
+        SceneObject* obj = mScopeObjects[j];
+        const SphereF& sphere = obj->getWorldSphere();
+        getScopeCellRange(sphere.center, sphere.radius, minX, minY, maxX, maxY);
+        if (F32(maxX - minX + 1) * F32(maxY - minY + 1) > ScopeMaxObjectCells)
+        {
+            mScopeLargeObjects.push_back(obj);
+            continue;
+        }
+
+        for (y = minY; y <= maxY; y++)
+            for (x = minX; x <= maxX; x++)
+                mScopeBucketObjects[fill[getScopeBucket(x, y)]++] = obj;
+    }
+
+    mScopeSnapshotDirty = false;
+    PROFILE_END();
+}
+
 void SceneGraph::scopeScene(const Point3F& scopePosition,
     const F32      scopeDistance,
     NetConnection* netConnection)
 {
+    // The snapshot uses the state key too, so it has to be built before the
+    //  traversal below starts marking objects.
+    if (smUseScopeSnapshot && mScopeSnapshotDirty)
+        buildScopeSnapshot();
+
+    NetConnection::ScopeStats& stats = netConnection->getScopeStats();
+    stats.queries++;
+
     // Find the start zone...
     SceneObject* startObject;
     U32          startZone;
@@ -490,6 +609,33 @@ void SceneGraph::scopeScene(const Point3F& scopePosition,
     info.zoneScopeStates = zoneScopeState;
     info.connection = netConnection;
 
+    if (smUseScopeSnapshot)
+    {
+        // Only the cells the scope sphere covers can hold anything that passes
+        //  the distance test in scopeCallback.  Each object still has to be in
+        //  a zone that got scoped.
+        S32 minX, minY, maxX, maxY;
+        getScopeCellRange(scopePosition, scopeDistance, minX, minY, maxX, maxY);
+        if (F32(maxX - minX + 1) * F32(maxY - minY + 1) >= ScopeBucketCount) {
+            // The scope area is bigger than the hash table, just look at everything.
+            scopeSnapshotObjects(mScopeObjects.address(), mScopeObjects.size(), &info);
+        }
+        else {
+            scopeSnapshotObjects(mScopeLargeObjects.address(), mScopeLargeObjects.size(), &info);
+            for (S32 y = minY; y <= maxY; y++) {
+                for (S32 x = minX; x <= maxX; x++) {
+                    U32 bucket = getScopeBucket(x, y);
+                    scopeSnapshotObjects(mScopeBucketObjects.address() + mScopeBucketStart[bucket],
+                        mScopeBucketStart[bucket + 1] - mScopeBucketStart[bucket], &info);
+                }
+            }
+        }
+
+        delete[] zoneScopeState;
+        zoneScopeState = NULL;
+        return;
+    }
+
     for (i = 0; i < mCurrZoneEnd; i++) {
         // Zip through the zone lists...
         if (zoneScopeState[i] == true) {
@@ -498,6 +644,7 @@ void SceneGraph::scopeScene(const Point3F& scopePosition,
             SceneObjectRef* pWalk = pList->nextInBin;
             while (pWalk != NULL) {
                 SceneObject* pObject = pWalk->object;
+                stats.objectsExamined++;
                 if (pObject->mLastStateKey != smStateKey) {
                     pObject->mLastStateKey = smStateKey;
                     scopeCallback(pObject, &info);
@@ -583,6 +730,7 @@ void SceneGraph::registerZones(SceneObject* obj, U32 numZones)
 {
     AssertFatal(alreadyManagingZones(obj) == false, "Error, added zones twice!");
     compactZonesCheck();
+    mScopeSnapshotDirty = true;
 
     U32 i;
     U32 retVal = mCurrZoneEnd;
@@ -633,6 +781,7 @@ void SceneGraph::registerZones(SceneObject* obj, U32 numZones)
 void SceneGraph::unregisterZones(SceneObject* obj)
 {
     AssertFatal(alreadyManagingZones(obj) == true, "Error, not managing any zones!");
+    mScopeSnapshotDirty = true;
 
     // First, let's nuke the lists associated with this object.  We can leave the
     //  horizontal references in the objects in place, they'll be freed before too
@@ -786,6 +935,7 @@ void SceneGraph::rezoneObject(SceneObject* obj)
 {
     AssertFatal(obj->mSceneManager != NULL && obj->mSceneManager == this, "Error, bad or no scenemanager here!");
     PROFILE_START(SG_Rezone);
+    mScopeSnapshotDirty = true;
 
     if (obj->mZoneRefHead != NULL) {
         // Remove the object from the zone lists...
@@ -933,6 +1083,7 @@ void SceneGraph::zoneInsert(SceneObject* obj)
 void SceneGraph::zoneRemove(SceneObject* obj)
 {
     PROFILE_START(SG_ZoneRemove);
+    mScopeSnapshotDirty = true;
     obj->mNumCurrZones = 0;
 
     // Remove the object from the zone lists...
@@ -37,6 +37,7 @@
 
 class SceneState;
 class NetConnection;
+struct ScopingInfo;
 
 class Sky;
 #ifdef TORQUE_TERRAIN
@@ -148,6 +149,11 @@ protected:
 public:
     static F32 smVisibleDistanceMod;
 
+    /// Answer scope queries from a spatial snapshot of the scene that is shared
+    /// by all connections, rather than walking every zone list per connection.
+    static bool smUseScopeSnapshot;
+    static F32  smScopeCellSize;   ///< Width of a snapshot grid cell
+
 
 public:
     static bool useSpecial;
@@ -269,6 +275,31 @@ protected:
     ///  point to a referenced object, but the owner of that zone...
     Vector<SceneObjectRef*> mZoneLists;
 
+    /// @name Scope snapshot
+    ///
+    /// Every zoned object hashed into a 2d grid by the xy extent of its world
+    /// sphere.  It is rebuilt by the first scope query after anything is rezoned,
+    /// which in practice means once per tick no matter how many connections scope
+    /// against it.
+    /// @{
+
+    enum {
+        ScopeBucketCount = 1024,   ///< Must be a power of two
+        ScopeMaxObjectCells = 16,  ///< Objects covering more cells than this are always examined
+    };
+
+    bool                 mScopeSnapshotDirty;
+    Vector<SceneObject*> mScopeObjects;        ///< All zoned objects, once each
+    Vector<SceneObject*> mScopeLargeObjects;   ///< Objects too big to hash
+    Vector<U32>          mScopeBucketStart;    ///< ScopeBucketCount + 1 offsets into mScopeBucketObjects
+    Vector<SceneObject*> mScopeBucketObjects;
+
+    void buildScopeSnapshot();
+    void scopeSnapshotObjects(SceneObject** objects, U32 count, ScopingInfo* info);
+    void getScopeCellRange(const Point3F& center, F32 radius, S32& minX, S32& minY, S32& maxX, S32& maxY) const;
+    static U32 getScopeBucket(S32 x, S32 y) { return (U32(x) * 73856093 ^ U32(y) * 19349663) & (ScopeBucketCount - 1); }
+    /// @}
+
 protected:
     void buildSceneTree(SceneState*, SceneObject*, const U32, const U32, const U32);
     void traverseSceneTree(SceneState* pState);
@@ -58,6 +58,9 @@ class SFXNullDevice : public SFXDevice
 
       U32 getVoiceCount() const { return mVoices.size(); }
 
+      // Null voices never touch the sample data.
+      bool canStream() const { return true; }
+
       void update( const SFXListener& listener );
 };
 
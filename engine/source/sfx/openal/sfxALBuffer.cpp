@@ -48,11 +48,7 @@ bool SFXALBuffer::createVoice(   ALuint *bufferName,
    AssertFatal( mOpenAL.alIsBuffer( *bufferName ), "AL Buffer Sanity Check Failed!" ); \
    AssertFatal( mOpenAL.alIsSource( *sourceName ), "AL Source Sanity Check Failed!" );
 
-   // Stereo 16 == 32 bits per sample, 16 per channel
-   if( mResource->getChannels() > 1 )
-      *bufferFormat = mResource->getSampleBits() == 32 ? AL_FORMAT_STEREO16 : AL_FORMAT_STEREO8;
-   else
-      *bufferFormat = mResource->getSampleBits() == 16 ? AL_FORMAT_MONO16 : AL_FORMAT_MONO8;
+   *bufferFormat = getFormat();
 
    // Is this 3d?
    mOpenAL.alSourcei( *sourceName, AL_SOURCE_RELATIVE, ( mIs3d ? AL_FALSE : AL_TRUE ) );
@@ -73,3 +69,12 @@ bool SFXALBuffer::createVoice(   ALuint *bufferName,
 
    return ( err == AL_NO_ERROR );
 }
+
+ALenum SFXALBuffer::getFormat() const
+{
+   // Stereo 16 == 32 bits per sample, 16 per channel
+   if( mResource->getChannels() > 1 )
+      return mResource->getSampleBits() == 32 ? AL_FORMAT_STEREO16 : AL_FORMAT_STEREO8;
+   else
+      return mResource->getSampleBits() == 16 ? AL_FORMAT_MONO16 : AL_FORMAT_MONO8;
+}
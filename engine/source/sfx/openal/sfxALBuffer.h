@@ -56,6 +56,9 @@ class SFXALBuffer : public SFXBuffer
                         ALuint *sourceName,
                         ALenum *bufferFormat ) const;
 
+      /// Returns the AL format of the resource.
+      ALenum getFormat() const;
+
 };
 
 
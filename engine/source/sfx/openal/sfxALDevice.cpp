@@ -132,6 +132,10 @@ void SFXALDevice::update( const SFXListener& listener )
    {
       if (mVoices[i]->is3D())
          mVoices[i]->setVelocity(velocity);
+
+      // Keep the streaming voices fed.
+      if (mVoices[i]->isStreaming())
+         mVoices[i]->updateStream();
    }
 
 }
\ No newline at end of file
@@ -71,6 +71,8 @@ class SFXALDevice : public SFXDevice
 
       U32 getVoiceCount() const { return mVoices.size(); }
 
+      bool canStream() const { return true; }
+
       void update( const SFXListener& listener );
 };
 
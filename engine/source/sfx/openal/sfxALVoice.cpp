@@ -11,7 +11,7 @@
 
 #ifdef TORQUE_DEBUG
 #  define AL_SANITY_CHECK() \
-   AssertFatal( mOpenAL.alIsBuffer( mBufferName ), "AL Buffer Sanity Check Failed!" ); \
+   AssertFatal( mStream || mOpenAL.alIsBuffer( mBufferName ), "AL Buffer Sanity Check Failed!" ); \
    AssertFatal( mOpenAL.alIsSource( mSourceName ), "AL Source Sanity Check Failed!" );
 #else
 #  define AL_SANITY_CHECK() 
@@ -20,7 +20,10 @@
 SFXALVoice* SFXALVoice::create( SFXALBuffer *buffer )
 {
    AssertFatal( buffer, "SFXALVoice::create() - Got null buffer!" );
- 
+
+   if ( buffer->mResource->isStreaming() )
+      return _createStreaming( buffer );
+
    ALuint bufferName;
    ALuint sourceName;
    ALenum bufferFormat;
@@ -48,20 +51,130 @@ SFXALVoice::SFXALVoice( const OPENALFNTABLE &oalft,
       mIsPlaying( false ), 
       mBufferName( bufferName ), 
       mSourceName( sourceName ),
-      mIs3D(buffer->mIs3d)
+      mIs3D(buffer->mIs3d),
+      mStream( NULL ),
+      mStreamFormat( 0 ),
+      mStreamFrequency( 0 ),
+      mStreamSampleBytes( 0 ),
+      mStreamStatus( SFXStatusStopped )
 {
-   AL_SANITY_CHECK();
+   dMemset( mStreamBuffers, 0, sizeof( mStreamBuffers ) );
+}
+
+SFXALVoice* SFXALVoice::_createStreaming( SFXALBuffer *buffer )
+{
+   const OPENALFNTABLE &openAL = buffer->mOpenAL;
+
+   SFXStream *stream = buffer->mResource->openStream();
+   if ( !stream )
+      return NULL;
+
+   ALuint sourceName;
+   openAL.alGenSources( 1, &sourceName );
+   openAL.alSourcei( sourceName, AL_SOURCE_RELATIVE, ( buffer->mIs3d ? AL_FALSE : AL_TRUE ) );
+
+   SFXALVoice *voice = new SFXALVoice( openAL, buffer, 0, sourceName );
+
+   const SFXResource *resource = buffer->mResource;
+   voice->mStream = new SFXStreamRing( stream, SFXStreamRing::getPacketSize( resource ), false );
+   voice->mStreamFormat = buffer->getFormat();
+   voice->mStreamFrequency = resource->getFrequency();
+   voice->mStreamSampleBytes = resource->getSampleBytes();
+
+   openAL.alGenBuffers( SFXStreamRing::NumPackets, voice->mStreamBuffers );
+   for ( U32 i=0; i < SFXStreamRing::NumPackets; i++ )
+      voice->mFreeStreamBuffers.push_back( voice->mStreamBuffers[i] );
+
+   return voice;
 }
 
 SFXALVoice::~SFXALVoice()
 {
+   if ( mStream )
+   {
+      _flushStream();
+      delete mStream;
+      mOpenAL.alDeleteSources( 1, &mSourceName );
+      mOpenAL.alDeleteBuffers( SFXStreamRing::NumPackets, mStreamBuffers );
+      return;
+   }
+
    mOpenAL.alDeleteSources( 1, &mSourceName );
    mOpenAL.alDeleteBuffers( 1, &mBufferName );
 }
 
+void SFXALVoice::_flushStream()
+{
+   // Clearing the buffer of a stopped source
+   // unqueues everything at once.
+   mOpenAL.alSourceStop( mSourceName );
+   mOpenAL.alSourcei( mSourceName, AL_BUFFER, 0 );
+
+   mFreeStreamBuffers.clear();
+   for ( U32 i=0; i < SFXStreamRing::NumPackets; i++ )
+      mFreeStreamBuffers.push_back( mStreamBuffers[i] );
+}
+
+void SFXALVoice::updateStream()
+{
+   if ( !mStream || mStreamStatus != SFXStatusPlaying )
+      return;
+
+   AL_SANITY_CHECK();
+
+   // Take back the buffers that finished playing.
+   ALint processed = 0;
+   mOpenAL.alGetSourcei( mSourceName, AL_BUFFERS_PROCESSED, &processed );
+   while ( processed-- > 0 )
+   {
+      ALuint bufferName;
+      mOpenAL.alSourceUnqueueBuffers( mSourceName, 1, &bufferName );
+      mFreeStreamBuffers.push_back( bufferName );
+   }
+
+   // Refill them with whatever the stream thread has ready.
+   const U8 *data;
+   U32 size;
+   while ( !mFreeStreamBuffers.empty() && mStream->getPacket( &data, &size ) )
+   {
+      ALuint bufferName = mFreeStreamBuffers.last();
+      mFreeStreamBuffers.pop_back();
+
+      mOpenAL.alBufferData( bufferName, mStreamFormat, data, size, mStreamFrequency );
+      mOpenAL.alSourceQueueBuffers( mSourceName, 1, &bufferName );
+      mStream->releasePacket();
+   }
+
+   ALint state;
+   mOpenAL.alGetSourcei( mSourceName, AL_SOURCE_STATE, &state );
+   if ( state == AL_PLAYING )
+      return;
+
+   // The source stops when it runs out of buffers, either at
+   // the end of the sound or if the stream thread fell behind.
+   ALint queued = 0;
+   mOpenAL.alGetSourcei( mSourceName, AL_BUFFERS_QUEUED, &queued );
+   if ( queued > 0 )
+      mOpenAL.alSourcePlay( mSourceName );
+   else if ( mStream->isFinished() )
+   {
+      mStreamStatus = SFXStatusStopped;
+      mStream->seek( 0 );
+   }
+}
+
 void SFXALVoice::setPosition( U32 pos )
 {
    AL_SANITY_CHECK();
+
+   if ( mStream )
+   {
+      // The position is in bytes.
+      _flushStream();
+      mStream->seek( pos / mStreamSampleBytes );
+      return;
+   }
+
    mOpenAL.alSourcei( mSourceName, AL_SAMPLE_OFFSET, pos );
 }
 
@@ -77,6 +190,9 @@ SFXStatus SFXALVoice::getStatus() const
 {
    AL_SANITY_CHECK();
 
+   if ( mStream )
+      return mStreamStatus;
+
    ALint state;
    mOpenAL.alGetSourcei( mSourceName, AL_SOURCE_STATE, &state );
    
@@ -93,6 +209,19 @@ void SFXALVoice::play( bool looping )
 {
    AL_SANITY_CHECK();
 
+   if ( mStream )
+   {
+      // The ring does the looping, the source never does.
+      mStream->setLooping( looping );
+
+      if ( mStreamStatus == SFXStatusPaused )
+         mOpenAL.alSourcePlay( mSourceName );
+
+      mStreamStatus = SFXStatusPlaying;
+      updateStream();
+      return;
+   }
+
    mOpenAL.alSourceStop( mSourceName );
    mOpenAL.alSourcei( mSourceName, AL_LOOPING, ( looping ? AL_TRUE : AL_FALSE ) );
    mOpenAL.alSourcePlay( mSourceName );
@@ -115,6 +244,13 @@ void SFXALVoice::pause()
 {
    AL_SANITY_CHECK();
 
+   if ( mStream )
+   {
+      mOpenAL.alSourcePause( mSourceName );
+      mStreamStatus = SFXStatusPaused;
+      return;
+   }
+
    mOpenAL.alSourcePause( mSourceName );
 
    //WORKAROUND: Another workaround for the buggy OAL.  Resuming playback of a paused source will cause the 
@@ -127,6 +263,14 @@ void SFXALVoice::stop()
 {
    AL_SANITY_CHECK();
 
+   if ( mStream )
+   {
+      _flushStream();
+      mStream->seek( 0 );
+      mStreamStatus = SFXStatusStopped;
+      return;
+   }
+
    mOpenAL.alSourceStop( mSourceName );
    
    mResumeAtSampleOffset = -1.0f;
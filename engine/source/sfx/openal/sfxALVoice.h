@@ -13,6 +13,9 @@
 #ifndef _OPENALFNTABLE
 #  include "sfx/openal/LoadOAL.h"
 #endif
+#ifndef _SFXSTREAM_H_
+#  include "sfx/sfxStream.h"
+#endif
 
 class SFXALBuffer;
 
@@ -41,6 +44,39 @@ class SFXALVoice : public SFXVoice
 
       const OPENALFNTABLE &mOpenAL;
 
+      /// @name Streaming
+      /// A streaming voice has no buffer of its own.  Packets
+      /// from the stream ring are queued on the source in a
+      /// small set of AL buffers instead.
+      /// @{
+
+      /// The decoded packets or NULL if this isn't streaming.
+      SFXStreamRing *mStream;
+
+      ///
+      ALuint mStreamBuffers[ SFXStreamRing::NumPackets ];
+
+      /// The stream buffers not queued on the source.
+      Vector<ALuint> mFreeStreamBuffers;
+
+      ALenum mStreamFormat;
+
+      U32 mStreamFrequency;
+
+      U32 mStreamSampleBytes;
+
+      /// The status as the source sees it, which the AL
+      /// source doesn't know when the stream runs dry.
+      SFXStatus mStreamStatus;
+
+      ///
+      static SFXALVoice* _createStreaming( SFXALBuffer *buffer );
+
+      /// Stops the source and takes back all the queued buffers.
+      void _flushStream();
+
+      /// @}
+
    public:
 
       static SFXALVoice* create( SFXALBuffer *buffer );
@@ -68,6 +104,12 @@ class SFXALVoice : public SFXVoice
       void setPitch( F32 pitch );
 
       bool is3D() { return mIs3D; }
+
+      bool isStreaming() const { return mStream != NULL; }
+
+      /// Moves decoded packets from the stream ring onto
+      /// the source.  Called from the device every update.
+      void updateStream();
 };
 
 
@@ -68,6 +68,14 @@ class SFXDevice
       /// The maximum number of playback buffers this device will use.
       S32 getMaxBuffers() const { return mMaxBuffers; }
 
+      /// Returns true if the voices of this device can play
+      /// streaming resources.  If not profiles marked for
+      /// streaming load their sounds in full.
+      ///
+      /// @see SFXResource::isStreaming()
+      ///
+      virtual bool canStream() const { return false; }
+
       /// Returns the name of this device.
       virtual const char* getName() const = 0;
 
@@ -174,8 +174,13 @@ bool SFXProfile::_preloadBuffer()
 {
    mBuffer = NULL;
 
-   if ( !mResource )
-      mResource = SFXResource::load( mFilename );
+   // Only stream if the device can play it, else
+   // we fall back to loading the whole sound.
+   const bool streaming =  mDescription && mDescription->mIsStreaming &&
+                           SFX && SFX->getDevice() && SFX->getDevice()->canStream();
+
+   if ( !mResource || mResource->isStreaming() != streaming )
+      mResource = SFXResource::load( mFilename, streaming );
 
    if ( mResource && SFX )
       mBuffer = SFX->_createBuffer( this );
@@ -28,8 +28,42 @@
 // ?????
 
 
-Resource<SFXResource> SFXResource::load( const char* filename )
+Resource<SFXResource> SFXResource::load( const char* filename, bool streaming )
 {
+   #ifndef TORQUE_NO_OGGVORBIS
+
+      // Streaming resources only hold the header, so they
+      // are cached apart from any fully loaded copy of the
+      // same file.  Only ogg files can stream.
+      if ( streaming )
+      {
+         char temp[256];
+         const char* ext = dStrrchr( filename, '.' );
+         if ( ext && !dStricmp( ext, ".ogg" ) )
+            dStrncpy( temp, filename, sizeof( temp ) );
+         else
+         {
+            dStrncpy( temp, filename, sizeof( temp ) );
+            dStrncat( temp, ".ogg", sizeof( temp ) );
+         }
+
+         char key[256];
+         dSprintf( key, sizeof( key ), "%s.stream", temp );
+
+         Resource<SFXResource> buffer = ResourceManager->load( key );
+         if ( (bool)buffer )
+            return buffer;
+
+         SFXResource* res = create( temp, true );
+         if ( res )
+         {
+            ResourceManager->add( key, res );
+            return ResourceManager->load( key );
+         }
+      }
+
+   #endif
+
    // Sound resources have a load on demand feature that
    // isn't directly supported by the resource manager.
    // To put loading under our control we add the resource
@@ -55,35 +89,61 @@ Resource<SFXResource> SFXResource::load( const char* filename )
    char temp[256];
    dStrncpy( temp, filename, sizeof( temp ) );
    dStrncat( temp, ".wav", sizeof( temp ) );
-   Stream* stream = ResourceManager->openStream( temp );
-   if ( stream )
-   {
-      ResourceManager->add( filename, SFXWavResource::create( *stream ) );
-      ResourceManager->closeStream( stream );
-      return ResourceManager->load( filename );
-   }
-   else
-   {
-      #ifndef TORQUE_NO_OGGVORBIS
+   SFXResource* res = create( temp );
+
+   #ifndef TORQUE_NO_OGGVORBIS
 
-         // Now try it as an ogg.
+      // Now try it as an ogg.
+      if ( !res )
+      {
          dStrncpy( temp, filename, sizeof( temp ) );
          dStrncat( temp, ".ogg", sizeof( temp ) );
-         stream = ResourceManager->openStream( temp );
-         if ( stream )
-         {
-            ResourceManager->add( filename, SFXOggResource::create( *stream ) );
-            ResourceManager->closeStream( stream );
-            return ResourceManager->load( filename );
-         }
+         res = create( temp );
+      }
 
-      #endif
+   #endif
+
+   if ( res )
+   {
+      ResourceManager->add( filename, res );
+      return ResourceManager->load( filename );
    }
 
    return NULL;
 }
 
 
+SFXResource* SFXResource::create( const char* filename, bool streaming )
+{
+   const char* ext = dStrrchr( filename, '.' );
+   if ( !ext )
+      return NULL;
+
+   Stream* stream = ResourceManager->openStream( filename );
+   if ( !stream )
+      return NULL;
+
+   ResourceInstance* res = NULL;
+   if ( !dStricmp( ext, ".wav" ) )
+      res = SFXWavResource::create( *stream );
+
+   #ifndef TORQUE_NO_OGGVORBIS
+
+      else if ( !dStricmp( ext, ".ogg" ) )
+      {
+         if ( streaming )
+            res = SFXOggResource::createStreaming( *stream, filename );
+         else
+            res = SFXOggResource::create( *stream );
+      }
+
+   #endif
+
+   ResourceManager->closeStream( stream );
+   return static_cast<SFXResource*>( res );
+}
+
+
 bool SFXResource::exists( const char* filename )
 {
    // First check to see if the resource manager can find it.
@@ -115,7 +175,8 @@ SFXResource::SFXResource()
       mData( NULL ),
       mSize( 0 ),
       mFrequency( 22050 ),
-      mLength( 0 )
+      mLength( 0 ),
+      mIsStreaming( false )
 {
 }
 
@@ -11,6 +11,8 @@
 #include "core/resManager.h"
 #endif
 
+class SFXStream;
+
 
 /// The various types of sound data that may be
 /// returned from SFXResource::getData().
@@ -41,6 +43,9 @@ enum SFXFormat
 /// the stream buffer.  This is triggered by a call to ????.
 /// SFXProfile, for example, does this when mPreload is enabled.
 ///
+/// A streaming resource never loads its sample data.  Instead
+/// each voice playing it gets a decoder from openStream().
+///
 class SFXResource : public ResourceInstance
 {
    protected:
@@ -67,15 +72,30 @@ class SFXResource : public ResourceInstance
       /// The length of the sample in milliseconds.
       U32 mLength;
 
+      /// True if only the header was loaded.
+      bool mIsStreaming;
+
    public:
 
       /// This is a helper function used by SFXProfile for load
       /// a sound resource.  It takes care of trying different 
       /// types for extension-less filenames.
       ///
-      /// @param filename The sound file path with or without extension.
+      /// @param filename  The sound file path with or without extension.
+      /// @param streaming Load only the header for playback thru
+      ///                  openStream().  Formats that can't stream
+      ///                  are loaded in full.
+      ///
+      static Resource<SFXResource> load( const char* filename, bool streaming = false );
+
+      /// Loads a sound file without going thru the resource cache.
+      ///
+      /// @param filename  The sound file path with extension.
+      /// @param streaming Load only the header if the format can stream.
+      ///
+      /// @return The new resource which the caller owns or NULL.
       ///
-      static Resource<SFXResource> load( const char* filename );
+      static SFXResource* create( const char* filename, bool streaming = false );
 
       /// A helper function which returns true if the 
       /// sound resource exists.
@@ -114,6 +134,14 @@ class SFXResource : public ResourceInstance
 
       /// Returns the number of samples per second.
       U32 getFrequency() const { return mFrequency; }
+
+      /// Returns true if this resource has no sample data
+      /// and must be played thru openStream().
+      bool isStreaming() const { return mIsStreaming; }
+
+      /// Returns a new decoder for a streaming resource
+      /// which the caller must delete, or NULL.
+      virtual SFXStream* openStream() const { return NULL; }
 };
 
 
@@ -0,0 +1,353 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "sfx/sfxStream.h"
+
+#include "sfx/sfxResource.h"
+#include "core/tAlgorithm.h"
+#include "platform/platformThread.h"
+#include "platform/platformMutex.h"
+#include "platform/platformSemaphore.h"
+#include "platform/profiler.h"
+#include "console/console.h"
+
+
+Vector<SFXStreamRing*> SFXStreamRing::smRings;
+void* SFXStreamRing::smMutex = NULL;
+void* SFXStreamRing::smSemaphore = NULL;
+void* SFXStreamRing::smDecodedSemaphore = NULL;
+Thread* SFXStreamRing::smThread = NULL;
+bool SFXStreamRing::smExiting = false;
+
+
+SFXStreamRing::SFXStreamRing( SFXStream *stream, U32 packetSize, bool looping )
+   :  mStream( stream ),
+      mPacketSize( packetSize ),
+      mReadIndex( 0 ),
+      mNumReady( 0 ),
+      mLooping( looping ),
+      mEndOfStream( false ),
+      mSeekSample( -1 ),
+      mGeneration( 0 ),
+      mDecoding( false ),
+      mWaiting( false )
+{
+   AssertFatal( mStream, "SFXStreamRing::SFXStreamRing() - Got null stream!" );
+   AssertFatal( mPacketSize, "SFXStreamRing::SFXStreamRing() - Got zero packet size!" );
+
+   mData = new U8[ mPacketSize * NumPackets ];
+   dMemset( mPacketBytes, 0, sizeof( mPacketBytes ) );
+
+   // The thread is started with the first ring.
+   if ( !smThread )
+   {
+      smMutex = Mutex::createMutex();
+      smSemaphore = Semaphore::createSemaphore( 0 );
+      smDecodedSemaphore = Semaphore::createSemaphore( 0 );
+      smExiting = false;
+      smThread = new Thread( _threadMain, NULL );
+   }
+
+   Mutex::lockMutex( smMutex );
+   smRings.push_back( this );
+   Mutex::unlockMutex( smMutex );
+
+   Semaphore::releaseSemaphore( smSemaphore );
+}
+
+SFXStreamRing::~SFXStreamRing()
+{
+   Mutex::lockMutex( smMutex );
+
+   // Once we're out of the list the stream thread
+   // won't pick us again...
+   Vector<SFXStreamRing*>::iterator iter = find( smRings.begin(), smRings.end(), this );
+   AssertFatal( iter != smRings.end(), "SFXStreamRing::~SFXStreamRing() - Ring was not registered!" );
+   smRings.erase( iter );
+
+   // ...but it may be decoding for us right now, and
+   // we can't pull the stream out from under it.
+   mWaiting = mDecoding;
+   const bool wait = mWaiting;
+
+   Mutex::unlockMutex( smMutex );
+
+   if ( wait )
+      Semaphore::acquireSemaphore( smDecodedSemaphore );
+
+   delete mStream;
+   delete [] mData;
+}
+
+void SFXStreamRing::shutdown()
+{
+   if ( !smThread )
+      return;
+
+   AssertFatal( smRings.empty(), "SFXStreamRing::shutdown() - Rings are still active!" );
+
+   Mutex::lockMutex( smMutex );
+   smExiting = true;
+   Mutex::unlockMutex( smMutex );
+   Semaphore::releaseSemaphore( smSemaphore );
+
+   // The destructor joins.
+   delete smThread;
+   smThread = NULL;
+
+   Semaphore::destroySemaphore( smSemaphore );
+   smSemaphore = NULL;
+   Semaphore::destroySemaphore( smDecodedSemaphore );
+   smDecodedSemaphore = NULL;
+   Mutex::destroyMutex( smMutex );
+   smMutex = NULL;
+}
+
+U32 SFXStreamRing::getPacketSize( const SFXResource *resource )
+{
+   const U32 sampleBytes = resource->getSampleBytes();
+   const U32 samples = ( resource->getFrequency() * PacketMs ) / 1000;
+   return getMax( samples, (U32)1 ) * sampleBytes;
+}
+
+void SFXStreamRing::setLooping( bool looping )
+{
+   Mutex::lockMutex( smMutex );
+
+   // If we've already hit the end then restart
+   // at the beginning to fill in the loop.
+   if ( looping && !mLooping && mEndOfStream )
+   {
+      mEndOfStream = false;
+      mSeekSample = 0;
+   }
+
+   mLooping = looping;
+   Mutex::unlockMutex( smMutex );
+
+   Semaphore::releaseSemaphore( smSemaphore );
+}
+
+void SFXStreamRing::seek( U32 sample )
+{
+   Mutex::lockMutex( smMutex );
+
+   mNumReady = 0;
+   mEndOfStream = false;
+   mSeekSample = sample;
+   mGeneration++;
+
+   Mutex::unlockMutex( smMutex );
+
+   Semaphore::releaseSemaphore( smSemaphore );
+}
+
+bool SFXStreamRing::getPacket( const U8 **data, U32 *size )
+{
+   Mutex::lockMutex( smMutex );
+
+   const bool ready = mNumReady > 0;
+   if ( ready )
+   {
+      *data = mData + ( mReadIndex * mPacketSize );
+      *size = mPacketBytes[ mReadIndex ];
+   }
+
+   Mutex::unlockMutex( smMutex );
+   return ready;
+}
+
+void SFXStreamRing::releasePacket()
+{
+   Mutex::lockMutex( smMutex );
+
+   AssertFatal( mNumReady > 0, "SFXStreamRing::releasePacket() - No packet to release!" );
+   mReadIndex = ( mReadIndex + 1 ) % NumPackets;
+   mNumReady--;
+
+   Mutex::unlockMutex( smMutex );
+
+   Semaphore::releaseSemaphore( smSemaphore );
+}
+
+bool SFXStreamRing::isFinished() const
+{
+   Mutex::lockMutex( smMutex );
+   const bool finished = mEndOfStream && mNumReady == 0;
+   Mutex::unlockMutex( smMutex );
+   return finished;
+}
+
+bool SFXStreamRing::_decodeNext()
+{
+   Mutex::lockMutex( smMutex );
+
+   // The ring with the fewest packets left is
+   // the closest to running dry.
+   SFXStreamRing *ring = NULL;
+   for ( S32 i=0; i < smRings.size(); i++ )
+   {
+      if ( smRings[i]->_needsDecode() &&
+           ( !ring || smRings[i]->mNumReady < ring->mNumReady ) )
+         ring = smRings[i];
+   }
+
+   if ( !ring )
+   {
+      Mutex::unlockMutex( smMutex );
+      return false;
+   }
+
+   ring->mDecoding = true;
+   const U32 generation = ring->mGeneration;
+   const S32 seekSample = ring->mSeekSample;
+   const bool looping = ring->mLooping;
+   const U32 index = ( ring->mReadIndex + ring->mNumReady ) % NumPackets;
+   ring->mSeekSample = -1;
+
+   Mutex::unlockMutex( smMutex );
+
+   PROFILE_START( SFXStreamRing_Decode );
+
+   // Only this thread touches the stream while mDecoding is set.
+   SFXStream *stream = ring->mStream;
+   if ( seekSample >= 0 )
+      stream->seek( seekSample );
+
+   U8 *packet = ring->mData + ( index * ring->mPacketSize );
+   U32 bytes = 0;
+   bool endOfStream = false;
+   bool wrapped = false;
+   while ( bytes < ring->mPacketSize )
+   {
+      const U32 read = stream->read( packet + bytes, ring->mPacketSize - bytes );
+      if ( read > 0 )
+      {
+         bytes += read;
+         wrapped = false;
+         continue;
+      }
+
+      // Wrap around for looping sounds, unless the sound
+      // is empty and we'd just spin here.
+      if ( looping && !wrapped && stream->seek( 0 ) )
+      {
+         wrapped = true;
+         continue;
+      }
+
+      endOfStream = true;
+      break;
+   }
+
+   PROFILE_END();
+
+   Mutex::lockMutex( smMutex );
+
+   // If a seek came in while we were decoding then
+   // the packet is from the wrong place... drop it.
+   if ( generation == ring->mGeneration )
+   {
+      if ( bytes > 0 )
+      {
+         ring->mPacketBytes[ index ] = bytes;
+         ring->mNumReady++;
+      }
+
+      ring->mEndOfStream = endOfStream;
+   }
+
+   ring->mDecoding = false;
+
+   // The ring is gone as soon as its destructor
+   // wakes up, so don't touch it after this.
+   const bool waiting = ring->mWaiting;
+   Mutex::unlockMutex( smMutex );
+
+   if ( waiting )
+      Semaphore::releaseSemaphore( smDecodedSemaphore );
+
+   return true;
+}
+
+void SFXStreamRing::_threadMain( void *arg )
+{
+   while ( true )
+   {
+      Semaphore::acquireSemaphore( smSemaphore );
+
+      Mutex::lockMutex( smMutex );
+      const bool exiting = smExiting;
+      Mutex::unlockMutex( smMutex );
+
+      if ( exiting )
+         return;
+
+      // Keep going till every ring is full.
+      while ( _decodeNext() )
+         ;
+   }
+}
+
+
+ConsoleFunction( sfxMeasureStreaming, void, 2, 2,
+                  "sfxMeasureStreaming( string filename )\n"
+                  "Loads a sound file both in full and for streaming, and prints the load time "
+                  "and sample memory each way takes.\n"
+                  "@param filename The sound file path with extension." )
+{
+   const char* filename = argv[1];
+
+   // The current path: decode it all up front.
+   U32 start = Platform::getRealMilliseconds();
+   SFXResource* full = SFXResource::create( filename, false );
+   const U32 fullMs = Platform::getRealMilliseconds() - start;
+   if ( !full )
+   {
+      Con::errorf( "sfxMeasureStreaming - Unable to load '%s'!", filename );
+      return;
+   }
+
+   const U32 fullBytes = full->getSize();
+   Con::printf( "%s: %d ms long, %d Hz, %d channels", 
+      filename, full->getLength(), full->getFrequency(), full->getChannels() );
+   Con::printf( "   full:      %5d ms to load, %9d bytes of samples", fullMs, fullBytes );
+   delete static_cast<ResourceInstance*>( full );
+
+   // Streaming: read the header, open a decoder, and
+   // decode the first packet so the voice can start.
+   start = Platform::getRealMilliseconds();
+   SFXResource* header = SFXResource::create( filename, true );
+   SFXStream* stream = header ? header->openStream() : NULL;
+   if ( !stream )
+   {
+      Con::printf( "   streaming: not supported for this format" );
+      if ( header )
+         delete static_cast<ResourceInstance*>( header );
+      return;
+   }
+
+   const U32 packetSize = SFXStreamRing::getPacketSize( header );
+   U8* packet = new U8[ packetSize ];
+   stream->read( packet, packetSize );
+   const U32 firstMs = Platform::getRealMilliseconds() - start;
+
+   // And the rest of it, which a voice would spread over
+   // the playback time on the stream thread.
+   start = Platform::getRealMilliseconds();
+   while ( stream->read( packet, packetSize ) > 0 )
+      ;
+   const U32 restMs = Platform::getRealMilliseconds() - start;
+
+   // The voice holds as many packets again in device buffers.
+   const U32 streamBytes = packetSize * SFXStreamRing::NumPackets * 2;
+   Con::printf( "   streaming: %5d ms to start, %9d bytes of samples per voice, %d ms decoding in the background",
+      firstMs, streamBytes, restMs );
+
+   delete [] packet;
+   delete stream;
+   delete static_cast<ResourceInstance*>( header );
+}
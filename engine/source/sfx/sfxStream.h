@@ -0,0 +1,174 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _SFXSTREAM_H_
+#define _SFXSTREAM_H_
+
+#ifndef _PLATFORM_H_
+   #include "platform/platform.h"
+#endif
+#ifndef _TVECTOR_H_
+   #include "core/tVector.h"
+#endif
+
+class SFXResource;
+class Thread;
+
+
+/// The decoder for a streaming SFXResource.
+///
+/// Each playing voice gets its own from SFXResource::openStream(),
+/// and it is only ever used by one thread at a time.
+class SFXStream
+{
+   public:
+
+      /// The destructor.
+      virtual ~SFXStream() {}
+
+      /// Decodes up to length bytes of sample data into buffer.
+      ///
+      /// @return The number of bytes decoded, zero at the end of the sound.
+      ///
+      virtual U32 read( U8 *buffer, U32 length ) = 0;
+
+      /// Moves the decoder to the given sample ( a sample
+      /// includes all channels ).
+      virtual bool seek( U32 sample ) = 0;
+};
+
+
+/// A small ring of decoded packets which a background
+/// thread keeps full from an SFXStream.
+///
+/// The voice that owns the ring takes packets off of it
+/// from the main thread and queues them on the device, so
+/// only NumPackets worth of sample data is ever held here
+/// no matter how long the sound is.
+///
+class SFXStreamRing
+{
+   public:
+
+      enum
+      {
+         /// The number of packets in the ring.
+         NumPackets = 4,
+
+         /// The length of a packet in milliseconds.
+         PacketMs = 250,
+      };
+
+   protected:
+
+      /// The decoder which is only touched by the
+      /// stream thread once the ring is created.
+      SFXStream *mStream;
+
+      /// The size of each packet in bytes.
+      U32 mPacketSize;
+
+      /// The packet storage.
+      U8 *mData;
+
+      /// The number of bytes decoded into each packet.
+      U32 mPacketBytes[NumPackets];
+
+      /// The next packet to hand to the voice.
+      U32 mReadIndex;
+
+      /// The number of decoded packets waiting for the voice.
+      U32 mNumReady;
+
+      /// Restart from the beginning at the end of the sound.
+      bool mLooping;
+
+      /// Set once the last packet has been decoded.
+      bool mEndOfStream;
+
+      /// A seek for the stream thread to do before it
+      /// decodes again or -1.
+      S32 mSeekSample;
+
+      /// Bumped on every seek so that the stream thread
+      /// can drop a packet it was decoding at the time.
+      U32 mGeneration;
+
+      /// True while the stream thread is decoding a packet.
+      bool mDecoding;
+
+      /// Set by the destructor when it has to wait for
+      /// the packet being decoded to finish.
+      bool mWaiting;
+
+      /// Returns true if the stream thread has work to do.
+      bool _needsDecode() const { return !mDecoding && !mEndOfStream && mNumReady < NumPackets; }
+
+      /// @name Stream Thread
+      /// @{
+
+      ///
+      static Vector<SFXStreamRing*> smRings;
+      static void *smMutex;
+      static void *smSemaphore;
+
+      /// Released by the stream thread when it finishes
+      /// a packet for a ring that is being deleted.
+      static void *smDecodedSemaphore;
+
+      static Thread *smThread;
+      static bool smExiting;
+
+      /// Decodes the next packet of the neediest ring,
+      /// returning false if none needed one.
+      static bool _decodeNext();
+
+      static void _threadMain( void *arg );
+
+      /// @}
+
+   public:
+
+      /// Creates the ring and hands it to the stream thread which
+      /// starts filling it right away.  The ring owns the stream.
+      SFXStreamRing( SFXStream *stream, U32 packetSize, bool looping );
+
+      /// The destructor.  This waits on the stream
+      /// thread if it is decoding for us.
+      ~SFXStreamRing();
+
+      /// Returns the packet size to use for a resource,
+      /// rounded to whole samples.
+      static U32 getPacketSize( const SFXResource *resource );
+
+      /// Sets if the stream wraps around at the end.
+      void setLooping( bool looping );
+
+      /// Drops all the decoded packets and restarts
+      /// the stream at the given sample.
+      void seek( U32 sample );
+
+      /// Returns the oldest decoded packet without removing
+      /// it, or false if the stream thread is behind.
+      bool getPacket( const U8 **data, U32 *size );
+
+      /// Removes the packet returned by getPacket() and
+      /// lets the stream thread reuse it.
+      void releasePacket();
+
+      /// Returns true if the end of a non-looping stream
+      /// has been reached and every packet was taken.
+      bool isFinished() const;
+
+      /// Returns the bytes of packet storage held by the ring.
+      U32 getMemorySize() const { return mPacketSize * NumPackets; }
+
+      /// Stops the stream thread.  All rings must have been
+      /// deleted already.
+      static void shutdown();
+};
+
+
+#endif // _SFXSTREAM_H_
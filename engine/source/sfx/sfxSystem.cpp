@@ -11,6 +11,7 @@
 #include "console/console.h"
 #include "platform/profiler.h"
 #include "sfx/sfxWavResource.h"
+#include "sfx/sfxStream.h"
 
 #ifndef TORQUE_NO_OGGVORBIS
    #include "sfx/vorbis/sfxOggResource.h"
@@ -27,10 +28,10 @@ void SFXSystem::init()
    // We register the common resource types 
    // here.  Provider specific resource types
    // should be registered in their constructors.
-   ResourceManager->registerExtension( ".wav", SFXWavResource::create );
+   ResourceManager->registerExtension( ".wav", SFXWavResource::create, true );
 
 #ifndef TORQUE_NO_OGGVORBIS
-   ResourceManager->registerExtension( ".ogg", SFXOggResource::create );
+   ResourceManager->registerExtension( ".ogg", SFXOggResource::create, true );
 #endif
 
    // Create the system.
@@ -84,6 +85,10 @@ SFXSystem::~SFXSystem()
 
    // If we still have a device... delete it.
    deleteDevice();
+
+   // The device took all the streaming voices with
+   // it so the stream thread can go now.
+   SFXStreamRing::shutdown();
 }
 
 bool SFXSystem::createDevice( const char* providerName, const char* deviceName, bool useHardware, S32 maxBuffers, bool changeDevice )
@@ -295,13 +300,10 @@ void SFXSystem::_update()
 {
    PROFILE_SCOPE( SFXSystem_Update );
    
-   // Every four system ticks.
-   const U32 SOURCE_UPDATE_MS = 32 * 4;
-
    // The update of the sources can be a bit expensive
    // and it does not need to be updated every frame.
    const U32 time = Platform::getVirtualMilliseconds();
-   if ( ( time - mLastTime ) >= SOURCE_UPDATE_MS )
+   if ( ( time - mLastTime ) >= SourceUpdateMs )
    {
       _updateSources( time );
       mLastTime = time;
@@ -39,6 +39,10 @@
 ///   providers will reformat on the fly, for best quality
 ///   and performance match your sound files to this setting.
 ///
+///   $pref::SFX::softwareOutputFile - If set when the software
+///   mixer device is created, the mix is written to this wav
+///   file until the device is deleted.
+///
 class SFXSystem
 {
    friend class SFXSource;    // for _onRemoveSource.
@@ -49,6 +53,10 @@ class SFXSystem
       /// The number of volume channels available in the system.
       enum { NumChannels = 32 };
 
+      /// How often _update() reprioritizes the sources and
+      /// reassigns voices, in milliseconds.
+      enum { SourceUpdateMs = 32 * 4 };
+
    protected:
 
       /// The one and only instance of the SFXSystem.
@@ -183,6 +191,9 @@ class SFXSystem
       /// Returns true if a device is allocated.
       bool hasDevice() const { return mDevice != NULL; }
 
+      /// Returns the current device or NULL.
+      SFXDevice* getDevice() const { return mDevice; }
+
       /// Used to create new sound sources from a sound profile.  The
       /// returned source is in a stopped state and ready for playback.
       /// Use the SFX_DELETE macro to free the source when your done.
@@ -0,0 +1,57 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "sfx/soft/sfxSoftBuffer.h"
+
+#include "sfx/sfxProfile.h"
+
+
+SFXSoftBuffer* SFXSoftBuffer::create( SFXProfile *profile )
+{
+   AssertFatal( profile, "SFXSoftBuffer::create() - Got null profile!" );
+
+   const Resource<SFXResource> &resource = profile->getResource();
+   if (  resource.isNull() || 
+         resource->isStreaming() ||
+         !resource->getData() ||
+         resource->getChannels() == 0 )
+      return NULL;
+
+   return new SFXSoftBuffer( resource, profile->getDescription()->mIs3D );
+}
+
+SFXSoftBuffer::SFXSoftBuffer( const Resource<SFXResource> &resource, bool is3d )
+   :  mResource( resource ),
+      mData( NULL ),
+      mIs3d( is3d )
+{
+   mChannels = mResource->getChannels();
+   mFrequency = mResource->getFrequency();
+   mResourceSampleBytes = mResource->getSampleBytes();
+   mSamples = mResource->getSize() / mResourceSampleBytes;
+
+   const U32 bitsPerChannel = mResource->getSampleBits() / mChannels;
+   if ( bitsPerChannel == 16 )
+   {
+      // Mix straight out of the resource.
+      mData = (const S16*)mResource->getData();
+      return;
+   }
+
+   // 8bit samples are unsigned.
+   const U8 *src = mResource->getData();
+   const U32 count = mSamples * mChannels;
+   mConverted.setSize( count );
+   for ( U32 i=0; i < count; i++ )
+      mConverted[i] = ( (S16)src[i] - 128 ) << 8;
+
+   mData = mConverted.address();
+}
+
+SFXSoftBuffer::~SFXSoftBuffer()
+{
+   mResource = NULL;
+}
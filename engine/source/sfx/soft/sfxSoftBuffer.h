@@ -0,0 +1,83 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _SFXSOFTBUFFER_H_
+#define _SFXSOFTBUFFER_H_
+
+#ifndef _SFXBUFFER_H_
+   #include "sfx/sfxBuffer.h"
+#endif
+#ifndef _SFXRESOURCE_H_
+   #include "sfx/sfxResource.h"
+#endif
+#ifndef _TVECTOR_H_
+   #include "core/tVector.h"
+#endif
+
+class SFXProfile;
+
+
+/// The sample data for the software mixer, held as
+/// interleaved signed 16bit samples.
+class SFXSoftBuffer : public SFXBuffer
+{
+   friend class SFXSoftDevice;
+
+   protected:
+
+      SFXSoftBuffer( const Resource<SFXResource> &resource, bool is3d );
+
+      /// The resource which holds the sample data.
+      Resource<SFXResource> mResource;
+
+      /// The 8bit data converted to 16bit.  Empty when
+      /// the resource data is already 16bit.
+      Vector<S16> mConverted;
+
+      /// The sample data to mix from.
+      const S16 *mData;
+
+      /// The number of samples ( a sample includes all channels ).
+      U32 mSamples;
+
+      /// 1 for mono or 2 for stereo.
+      U32 mChannels;
+
+      /// The number of samples per second.
+      U32 mFrequency;
+
+      /// The bytes per sample in the resource format, which 
+      /// voice positions are given in.
+      U32 mResourceSampleBytes;
+
+      ///
+      bool mIs3d;
+
+   public:
+
+      /// Returns a new buffer or NULL if the profile's 
+      /// resource isn't fully loaded PCM data.
+      static SFXSoftBuffer* create( SFXProfile *profile );
+
+      virtual ~SFXSoftBuffer();
+
+      const S16* getData() const { return mData; }
+
+      U32 getSamples() const { return mSamples; }
+
+      U32 getChannels() const { return mChannels; }
+
+      U32 getFrequency() const { return mFrequency; }
+
+      U32 getResourceSampleBytes() const { return mResourceSampleBytes; }
+
+      bool is3d() const { return mIs3d; }
+};
+
+
+/// A vector of SFXSoftBuffer pointers.
+typedef Vector<SFXSoftBuffer*> SFXSoftBufferVector;
+
+#endif // _SFXSOFTBUFFER_H_
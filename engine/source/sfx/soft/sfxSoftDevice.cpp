@@ -0,0 +1,484 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+
+#include "sfx/soft/sfxSoftDevice.h"
+#include "sfx/soft/sfxSoftBuffer.h"
+#include "sfx/sfxListener.h"
+#include "sfx/sfxSystem.h"
+#include "core/fileStream.h"
+#include "core/resManager.h"
+#include "core/tAlgorithm.h"
+#include "core/units.h"
+#include "console/console.h"
+#include "platform/profiler.h"
+#include "math/mRandom.h"
+
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+#include <xmmintrin.h>
+#define SFX_SSE_MIXING
+#endif
+
+
+bool SFXSoftDevice::smUseSSE = true;
+
+
+/// Adds a mono block into the stereo mix.
+static void _mixMono( F32 *dest, const F32 *src, U32 count, F32 left, F32 right )
+{
+   U32 i = 0;
+
+#ifdef SFX_SSE_MIXING
+   if ( SFXSoftDevice::smUseSSE )
+   {
+      const __m128 gains = _mm_setr_ps( left, right, left, right );
+      for ( ; i + 4 <= count; i += 4 )
+      {
+         // Spread 4 mono samples over 4 stereo pairs.
+         const __m128 s = _mm_loadu_ps( src + i );
+         const __m128 lo = _mm_unpacklo_ps( s, s );
+         const __m128 hi = _mm_unpackhi_ps( s, s );
+
+         F32 *d = dest + ( i * 2 );
+         _mm_storeu_ps( d, _mm_add_ps( _mm_loadu_ps( d ), _mm_mul_ps( lo, gains ) ) );
+         _mm_storeu_ps( d + 4, _mm_add_ps( _mm_loadu_ps( d + 4 ), _mm_mul_ps( hi, gains ) ) );
+      }
+   }
+#endif
+
+   for ( ; i < count; i++ )
+   {
+      dest[ i * 2 ] += src[i] * left;
+      dest[ i * 2 + 1 ] += src[i] * right;
+   }
+}
+
+/// Adds a stereo block into the stereo mix.
+static void _mixStereo( F32 *dest, const F32 *src, U32 count, F32 left, F32 right )
+{
+   const U32 values = count * 2;
+   U32 i = 0;
+
+#ifdef SFX_SSE_MIXING
+   if ( SFXSoftDevice::smUseSSE )
+   {
+      const __m128 gains = _mm_setr_ps( left, right, left, right );
+      for ( ; i + 8 <= values; i += 8 )
+      {
+         _mm_storeu_ps( dest + i, _mm_add_ps( _mm_loadu_ps( dest + i ), _mm_mul_ps( _mm_loadu_ps( src + i ), gains ) ) );
+         _mm_storeu_ps( dest + i + 4, _mm_add_ps( _mm_loadu_ps( dest + i + 4 ), _mm_mul_ps( _mm_loadu_ps( src + i + 4 ), gains ) ) );
+      }
+   }
+#endif
+
+   for ( ; i < values; i += 2 )
+   {
+      dest[i] += src[i] * left;
+      dest[i + 1] += src[i + 1] * right;
+   }
+}
+
+/// Clamps the mix and converts it to 16bit.
+static void _convertMix( S16 *dest, const F32 *src, U32 values )
+{
+   U32 i = 0;
+
+#ifdef SFX_SSE_MIXING
+   if ( SFXSoftDevice::smUseSSE )
+   {
+      const __m128 lo = _mm_set1_ps( -1.0f );
+      const __m128 hi = _mm_set1_ps( 1.0f );
+      const __m128 scale = _mm_set1_ps( 32767.0f );
+
+      F32 temp[4];
+      for ( ; i + 4 <= values; i += 4 )
+      {
+         const __m128 s = _mm_mul_ps( _mm_min_ps( _mm_max_ps( _mm_loadu_ps( src + i ), lo ), hi ), scale );
+         _mm_storeu_ps( temp, s );
+         dest[i] = (S16)temp[0];
+         dest[i + 1] = (S16)temp[1];
+         dest[i + 2] = (S16)temp[2];
+         dest[i + 3] = (S16)temp[3];
+      }
+   }
+#endif
+
+   for ( ; i < values; i++ )
+      dest[i] = (S16)( mClampF( src[i], -1.0f, 1.0f ) * 32767.0f );
+}
+
+
+SFXSoftDevice::SFXSoftDevice( SFXProvider* provider, 
+                              const char* name, 
+                              bool useHardware, 
+                              S32 maxBuffers )
+
+   :  SFXDevice( provider, useHardware, maxBuffers ),
+      mName( StringTable->insert( name ) ),
+      mTimeRemainder( 0 ),
+      mMixing( true ),
+      mWorldToListener( true ),
+      mOutputFile( NULL ),
+      mOutputBytes( 0 ),
+      mMixedSamples( 0 )
+{
+   // Voices are cheap here so the default is generous.
+   mMaxBuffers = maxBuffers < 0 ? 64 : getMax( maxBuffers, 8 );
+   mFrequency = getMax( Con::getIntVariable( "$pref::SFX::frequency", 44100 ), 8000 );
+   mLastTime = Platform::getVirtualMilliseconds();
+
+   const char* outputFile = Con::getVariable( "$pref::SFX::softwareOutputFile" );
+   if ( outputFile && outputFile[0] )
+      openOutputFile( outputFile );
+}
+
+SFXSoftDevice::~SFXSoftDevice()
+{
+   closeOutputFile();
+
+   SFXSoftVoiceVector::iterator voice = mVoices.begin();
+   for ( ; voice != mVoices.end(); voice++ )
+      delete (*voice);
+   mVoices.clear();
+
+   SFXSoftBufferVector::iterator buffer = mBuffers.begin();
+   for ( ; buffer != mBuffers.end(); buffer++ )
+      delete (*buffer);
+   mBuffers.clear();
+}
+
+SFXBuffer* SFXSoftDevice::createBuffer( SFXProfile *profile )
+{
+   AssertFatal( profile, "SFXSoftDevice::createBuffer() - Got null profile!" );
+
+   SFXSoftBuffer* buffer = SFXSoftBuffer::create( profile );
+   if ( !buffer )
+      return NULL;
+
+   mBuffers.push_back( buffer );
+   return buffer;
+}
+
+SFXVoice* SFXSoftDevice::createVoice( SFXBuffer *buffer )
+{
+   // Don't bother going any further if we've 
+   // exceeded the maximum voices.
+   if ( mVoices.size() >= mMaxBuffers )
+      return NULL;
+
+   AssertFatal( buffer, "SFXSoftDevice::createVoice() - Got null buffer!" );
+
+   SFXSoftBuffer* softBuffer = dynamic_cast<SFXSoftBuffer*>( buffer );
+   AssertFatal( softBuffer, "SFXSoftDevice::createVoice() - Got bad buffer!" );
+
+   SFXSoftVoice* voice = new SFXSoftVoice( softBuffer );
+   mVoices.push_back( voice );
+   return voice;
+}
+
+void SFXSoftDevice::deleteVoice( SFXVoice* voice )
+{
+   AssertFatal( voice, "SFXSoftDevice::deleteVoice() - Got null voice!" );
+
+   SFXSoftVoice* softVoice = dynamic_cast<SFXSoftVoice*>( voice );
+   AssertFatal( softVoice, "SFXSoftDevice::deleteVoice() - Got bad voice!" );
+
+   SFXSoftVoiceVector::iterator iter = find( mVoices.begin(), mVoices.end(), softVoice );
+   AssertFatal( iter != mVoices.end(), "SFXSoftDevice::deleteVoice() - Got unknown voice!" );
+
+   mVoices.erase( iter );
+   delete softVoice;
+}
+
+void SFXSoftDevice::update( const SFXListener& listener )
+{
+   mWorldToListener = listener.getTransform();
+   mWorldToListener.inverse();
+
+   // Don't try to catch up on a long stall.
+   const U32 time = Platform::getVirtualMilliseconds();
+   const U32 elapsed = getMin( time - mLastTime, (U32)MaxMixMs );
+   mLastTime = time;
+
+   const U32 total = ( elapsed * mFrequency ) + mTimeRemainder;
+   mTimeRemainder = total % 1000;
+   mix( total / 1000 );
+}
+
+void SFXSoftDevice::mix( U32 samples )
+{
+   PROFILE_SCOPE( SFXSoftDevice_Mix );
+
+   while ( samples > 0 )
+   {
+      const U32 count = getMin( samples, (U32)MixBlockSamples );
+      _mixBlock( count );
+      samples -= count;
+   }
+}
+
+void SFXSoftDevice::_mixBlock( U32 samples )
+{
+   mMixedSamples += samples;
+
+   if ( !mMixing )
+   {
+      for ( S32 i=0; i < mVoices.size(); i++ )
+      {
+         if ( mVoices[i]->isPlaying() )
+            mVoices[i]->_skip( samples, mFrequency );
+      }
+
+      return;
+   }
+
+   mMixBuffer.setSize( samples * 2 );
+   mVoiceBuffer.setSize( samples * 2 );
+   dMemset( mMixBuffer.address(), 0, samples * 2 * sizeof( F32 ) );
+
+   for ( S32 i=0; i < mVoices.size(); i++ )
+   {
+      SFXSoftVoice *voice = mVoices[i];
+      if ( !voice->isPlaying() )
+         continue;
+
+      // Voices out of range only need to keep time.
+      F32 left, right;
+      voice->_getGains( mWorldToListener, &left, &right );
+      if ( left <= 0.0f && right <= 0.0f )
+      {
+         voice->_skip( samples, mFrequency );
+         continue;
+      }
+
+      const U32 read = voice->_read( mVoiceBuffer.address(), samples, mFrequency );
+      if ( voice->getBuffer()->getChannels() == 1 )
+         _mixMono( mMixBuffer.address(), mVoiceBuffer.address(), read, left, right );
+      else
+         _mixStereo( mMixBuffer.address(), mVoiceBuffer.address(), read, left, right );
+   }
+
+   mOutput.setSize( samples * 2 );
+   _convertMix( mOutput.address(), mMixBuffer.address(), samples * 2 );
+
+   if ( mOutputFile )
+   {
+      #ifdef TORQUE_BIG_ENDIAN
+         for ( S32 i=0; i < mOutput.size(); i++ )
+            mOutputFile->write( mOutput[i] );
+      #else
+         mOutputFile->write( mOutput.size() * sizeof( S16 ), mOutput.address() );
+      #endif
+
+      mOutputBytes += mOutput.size() * sizeof( S16 );
+   }
+}
+
+bool SFXSoftDevice::openOutputFile( const char* filename )
+{
+   closeOutputFile();
+
+   mOutputFile = new FileStream;
+   if ( !ResourceManager->openFileForWrite( *mOutputFile, filename ) )
+   {
+      Con::errorf( "SFXSoftDevice::openOutputFile() - Unable to open '%s'!", filename );
+      delete mOutputFile;
+      mOutputFile = NULL;
+      return false;
+   }
+
+   mOutputBytes = 0;
+   _writeWavHeader();
+   return true;
+}
+
+void SFXSoftDevice::closeOutputFile()
+{
+   if ( !mOutputFile )
+      return;
+
+   // Fill in the sizes now that we know them.
+   mOutputFile->setPosition( 0 );
+   _writeWavHeader();
+
+   mOutputFile->close();
+   delete mOutputFile;
+   mOutputFile = NULL;
+}
+
+void SFXSoftDevice::_writeWavHeader()
+{
+   const U16 channels = 2;
+   const U16 bits = 16;
+   const U16 blockAlign = channels * ( bits / 8 );
+
+   mOutputFile->write( 4, "RIFF" );
+   mOutputFile->write( U32( 36 + mOutputBytes ) );
+   mOutputFile->write( 4, "WAVE" );
+
+   mOutputFile->write( 4, "fmt " );
+   mOutputFile->write( U32( 16 ) );
+   mOutputFile->write( U16( 1 ) );  // PCM
+   mOutputFile->write( channels );
+   mOutputFile->write( U32( mFrequency ) );
+   mOutputFile->write( U32( mFrequency * blockAlign ) );
+   mOutputFile->write( blockAlign );
+   mOutputFile->write( bits );
+
+   mOutputFile->write( 4, "data" );
+   mOutputFile->write( mOutputBytes );
+}
+
+
+ConsoleFunction( sfxBenchmarkMixer, void, 3, 6,
+                  "sfxBenchmarkMixer( SFXProfile profile, S32 sources, [F32 seconds = 10], [S32 maxVoices = 64], [string wavFile] )\n"
+                  "Plays many copies of a profile scattered around a moving listener thru the software "
+                  "mixer, stepping SFXSystem::_update() at the tick rate as fast as it will go, and prints "
+                  "the time spent in voice assignment and in mixing with and without SSE.  The profile "
+                  "should be 3D and looping.  Each pass runs on a fresh software device for seconds rounded "
+                  "up to whole source updates, so the virtual clock is moved forward about three times "
+                  "seconds, and the current device is recreated afterwards.\n"
+                  "@param profile The sound to play.\n"
+                  "@param sources The number of sources to play.\n"
+                  "@param seconds The sound time to mix in each pass.\n"
+                  "@param maxVoices The voice limit for the device.\n"
+                  "@param wavFile An optional file to write the SSE pass to." )
+{
+   SFXProfile *profile = dynamic_cast<SFXProfile*>( Sim::findObject( argv[1] ) );
+   if ( !profile || !profile->getDescription() )
+   {
+      Con::errorf( "sfxBenchmarkMixer - Unable to locate sfx profile '%s'!", argv[1] );
+      return;
+   }
+
+   const S32 numSources = getMax( dAtoi( argv[2] ), 1 );
+   const F32 seconds = argc > 3 ? getMax( (F32)dAtof( argv[3] ), 0.1f ) : 10.0f;
+   const S32 maxVoices = argc > 4 ? dAtoi( argv[4] ) : 64;
+   const char* wavFile = argc > 5 ? argv[5] : NULL;
+
+   const SFXDescription *desc = profile->getDescription();
+   if ( !desc->mIs3D || !desc->mIsLooping )
+      Con::warnf( "sfxBenchmarkMixer - '%s' isn't 3D and looping, so the results will be light.", argv[1] );
+
+   // Remember the device to put it back after.
+   char oldDevice[1024];
+   oldDevice[0] = 0;
+   const char* info = SFX->getDeviceInfoString();
+   if ( info )
+      dStrncpy( oldDevice, info, sizeof( oldDevice ) );
+
+   SFXListener &listener = SFX->getListener();
+   const MatrixF oldListener = listener.getTransform();
+   const bool oldUseSSE = SFXSoftDevice::smUseSSE;
+
+   // Run whole source updates so that every pass reassigns
+   // the voices on the same ticks.
+   const U32 tickMs = 32;
+   const U32 updateTicks = SFXSystem::SourceUpdateMs / tickMs;
+   U32 ticks = getMax( U32( seconds * 1000.0f ) / tickMs, (U32)1 );
+   ticks = ( ( ticks + updateTicks - 1 ) / updateTicks ) * updateTicks;
+   const F32 radius = desc->mMaxDistance;
+
+   static const char* passNames[] = { "update only", "scalar mix ", "SSE mix    " };
+   U32 updateMs = 0;
+
+   for ( U32 pass = 0; pass < 3; pass++ )
+   {
+      // A fresh device each pass so the mixer clock
+      // and voices don't carry over.
+      SFX->deleteDevice();
+      if ( !SFX->createDevice( "Software", "SFX Software Mixer", false, maxVoices ) )
+      {
+         Con::errorf( "sfxBenchmarkMixer - Unable to create the software device!" );
+         break;
+      }
+
+      SFXSoftDevice *device = dynamic_cast<SFXSoftDevice*>( SFX->getDevice() );
+      AssertFatal( device, "sfxBenchmarkMixer - Got the wrong device!" );
+
+      if ( pass == 0 )
+         Con::printf( "sfxBenchmarkMixer - %s: %d sources, %d voices, %d ticks, %d Hz",
+            argv[1], numSources, device->getMaxBuffers(), ticks, device->getFrequency() );
+
+      device->setMixing( pass > 0 );
+      SFXSoftDevice::smUseSSE = ( pass == 2 );
+
+      if ( pass == 2 && wavFile && wavFile[0] )
+         device->openOutputFile( wavFile );
+
+      // The same layout every pass.
+      MRandomLCG random( 1 );
+      listener.setTransform( MatrixF( true ) );
+
+      SFXSourceVector sources;
+      for ( S32 i=0; i < numSources; i++ )
+      {
+         MatrixF transform( true );
+         transform.setColumn( 3, Point3F( random.randF( -radius, radius ), random.randF( -radius, radius ), random.randF( -2, 2 ) ) );
+
+         SFXSource *source = SFX->createSource( profile, &transform );
+         if ( !source )
+            break;
+
+         source->play();
+         sources.push_back( source );
+      }
+
+      U32 voices = 0;
+      const U32 start = Platform::getRealMilliseconds();
+      for ( U32 t=0; t < ticks; t++ )
+      {
+         Platform::advanceTime( tickMs );
+
+         // Walk the listener around so the voices
+         // keep getting reassigned.
+         const F32 angle = F32( t ) * 0.01f;
+         MatrixF transform;
+         transform.set( EulerF( 0, 0, angle ), Point3F( mCos( angle ) * radius * 0.5f, mSin( angle ) * radius * 0.5f, 0 ) );
+         listener.setTransform( transform );
+
+         SFX->_update();
+         voices += device->getVoiceCount();
+      }
+      const U32 elapsed = getMax( Platform::getRealMilliseconds() - start, (U32)1 );
+
+      for ( S32 i=0; i < sources.size(); i++ )
+         SFX_DELETE( sources[i] );
+
+      if ( pass == 2 )
+         device->closeOutputFile();
+
+      if ( pass == 0 )
+         updateMs = elapsed;
+
+      Con::printf( "   %s: %5d ms, %6.2f%% of real time, %.1f voices, %d ms mixing",
+         passNames[pass], elapsed, 100.0f * F32( elapsed ) / F32( ticks * tickMs ), 
+         F32( voices ) / F32( ticks ), pass ? S32( elapsed ) - S32( updateMs ) : 0 );
+
+#ifndef SFX_SSE_MIXING
+      if ( pass == 1 )
+      {
+         Con::printf( "   (SSE mixing not compiled in on this platform)" );
+         break;
+      }
+#endif
+   }
+
+   SFXSoftDevice::smUseSSE = oldUseSSE;
+   listener.setTransform( oldListener );
+
+   // Put the old device back.
+   SFX->deleteDevice();
+   if ( oldDevice[0] )
+   {
+      char provider[256];
+      dStrncpy( provider, getUnit( oldDevice, 0, "\t" ), sizeof( provider ) );
+      SFX->createDevice(   provider,
+                           getUnit( oldDevice, 1, "\t" ),
+                           dAtob( getUnit( oldDevice, 2, "\t" ) ),
+                           dAtoi( getUnit( oldDevice, 3, "\t" ) ) );
+   }
+}
@@ -0,0 +1,155 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _SFXSOFTDEVICE_H_
+#define _SFXSOFTDEVICE_H_
+
+class SFXProvider;
+class FileStream;
+
+#ifndef _SFXDEVICE_H_
+   #include "sfx/sfxDevice.h"
+#endif
+#ifndef _SFXPROVIDER_H_
+   #include "sfx/sfxProvider.h"
+#endif
+#ifndef _SFXSOFTBUFFER_H_
+   #include "sfx/soft/sfxSoftBuffer.h"
+#endif
+#ifndef _SFXSOFTVOICE_H_
+   #include "sfx/soft/sfxSoftVoice.h"
+#endif
+
+
+/// A device which resamples, attenuates and mixes its voices
+/// in software into a 16bit stereo buffer.
+///
+/// It doesn't need a sound card.  The mix is written to a wav
+/// file if $pref::SFX::softwareOutputFile is set when the device
+/// is created, else it is thrown away.  The mix follows the
+/// virtual clock, so it is the same from run to run no matter
+/// how fast the frames are.
+///
+/// @see sfxBenchmarkMixer
+///
+class SFXSoftDevice : public SFXDevice
+{
+   typedef SFXDevice Parent;
+
+   public:
+
+      SFXSoftDevice( SFXProvider* provider, 
+                     const char* name, 
+                     bool useHardware, 
+                     S32 maxBuffers );
+
+      virtual ~SFXSoftDevice();
+
+      enum
+      {
+         /// The most samples mixed in one pass.
+         MixBlockSamples = 1024,
+
+         /// The most time one update will mix.
+         MaxMixMs = 1000,
+      };
+
+      /// Use the SSE mixing loops when they are compiled in.
+      static bool smUseSSE;
+
+   protected:
+
+      const StringTableEntry mName;
+
+      SFXSoftVoiceVector mVoices;
+
+      SFXSoftBufferVector mBuffers;
+
+      /// The output samples per second.
+      U32 mFrequency;
+
+      /// The virtual time of the last mix.
+      U32 mLastTime;
+
+      /// The leftover ms * frequency from the last
+      /// update that didn't make a whole sample.
+      U32 mTimeRemainder;
+
+      /// If false the voices are moved along
+      /// without being mixed.
+      bool mMixing;
+
+      /// The inverse listener transform for the current mix.
+      MatrixF mWorldToListener;
+
+      /// The stereo accumulation buffer.
+      Vector<F32> mMixBuffer;
+
+      /// One voice's resampled block.
+      Vector<F32> mVoiceBuffer;
+
+      /// The last mixed block.
+      Vector<S16> mOutput;
+
+      /// The wav file we're writing or NULL.
+      FileStream *mOutputFile;
+
+      /// The bytes of sample data written to mOutputFile.
+      U32 mOutputBytes;
+
+      /// The total samples mixed.
+      U32 mMixedSamples;
+
+      /// Writes the header of the output file with the
+      /// current data size.
+      void _writeWavHeader();
+
+      /// Mixes a block of at most MixBlockSamples.
+      void _mixBlock( U32 samples );
+
+   public:
+
+      const char* getName() const { return mName; }
+
+      //
+      SFXBuffer* createBuffer( SFXProfile *profile );
+
+      ///
+      SFXVoice* createVoice( SFXBuffer *buffer );
+
+      ///
+      void deleteVoice( SFXVoice* buffer );
+
+      U32 getVoiceCount() const { return mVoices.size(); }
+
+      /// Mixes the time that passed on the virtual clock.
+      void update( const SFXListener& listener );
+
+      /// Mixes the given samples with the current listener.
+      void mix( U32 samples );
+
+      /// Turns mixing on or off.  When off the voices still
+      /// play, they just aren't heard.
+      void setMixing( bool enable ) { mMixing = enable; }
+
+      /// Starts writing the mix to a wav file, closing
+      /// any open one first.
+      bool openOutputFile( const char* filename );
+
+      /// Finishes the wav file if one is open.
+      void closeOutputFile();
+
+      /// Returns the output samples per second.
+      U32 getFrequency() const { return mFrequency; }
+
+      /// Returns the total samples mixed.
+      U32 getMixedSamples() const { return mMixedSamples; }
+
+      /// Returns the last mixed block as interleaved 
+      /// 16bit stereo samples.
+      const Vector<S16>& getOutput() const { return mOutput; }
+};
+
+#endif // _SFXSOFTDEVICE_H_
@@ -0,0 +1,220 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "sfx/soft/sfxSoftVoice.h"
+
+#include "sfx/soft/sfxSoftBuffer.h"
+#include "math/mMathFn.h"
+#include "math/mConstants.h"
+
+
+/// Linear interpolating resampler for interleaved
+/// 16bit data with the given channel count.
+template< U32 channels >
+static U32 _resample(   const S16 *data, 
+                        U32 numSamples, 
+                        bool looping,
+                        U32 &pos, 
+                        U32 &frac, 
+                        U32 step,
+                        F32 *dest, 
+                        U32 count )
+{
+   const F32 scale = 1.0f / 32768.0f;
+   const F32 fracScale = 1.0f / 65536.0f;
+
+   U32 i = 0;
+   while ( i < count )
+   {
+      U32 next = pos + 1;
+      if ( next >= numSamples )
+         next = looping ? 0 : pos;
+
+      const F32 t = F32( frac ) * fracScale;
+      const S16 *s0 = data + ( pos * channels );
+      const S16 *s1 = data + ( next * channels );
+      for ( U32 c=0; c < channels; c++ )
+         dest[c] = ( F32( s0[c] ) + F32( s1[c] - s0[c] ) * t ) * scale;
+
+      dest += channels;
+      i++;
+
+      frac += step;
+      pos += frac >> 16;
+      frac &= 0xFFFF;
+
+      if ( pos >= numSamples )
+      {
+         if ( !looping )
+            break;
+
+         pos %= numSamples;
+      }
+   }
+
+   return i;
+}
+
+
+SFXSoftVoice::SFXSoftVoice( SFXSoftBuffer *buffer )
+   :  mBuffer( buffer ),
+      mStatus( SFXStatusNull ),
+      mLooping( false ),
+      mPosition( 0 ),
+      mFraction( 0 ),
+      mVolume( 1 ),
+      mPitch( 1 ),
+      mPosition3d( 0, 0, 0 ),
+      mMinDistance( 1 ),
+      mMaxDistance( 100 )
+{
+   AssertFatal( mBuffer, "SFXSoftVoice::SFXSoftVoice() - Got null buffer!" );
+}
+
+SFXSoftVoice::~SFXSoftVoice()
+{
+}
+
+U32 SFXSoftVoice::_getStep( U32 outFrequency ) const
+{
+   const F64 step = ( F64( mBuffer->getFrequency() ) * mPitch * 65536.0 ) / F64( outFrequency );
+   return getMax( U32( step ), (U32)1 );
+}
+
+void SFXSoftVoice::_checkEnd()
+{
+   if ( mPosition < mBuffer->getSamples() )
+      return;
+
+   if ( mLooping )
+      mPosition %= mBuffer->getSamples();
+   else
+   {
+      mStatus = SFXStatusStopped;
+      mPosition = 0;
+      mFraction = 0;
+   }
+}
+
+U32 SFXSoftVoice::_read( F32 *dest, U32 count, U32 outFrequency )
+{
+   const U32 step = _getStep( outFrequency );
+
+   U32 read;
+   if ( mBuffer->getChannels() == 1 )
+      read = _resample<1>( mBuffer->getData(), mBuffer->getSamples(), mLooping, mPosition, mFraction, step, dest, count );
+   else
+      read = _resample<2>( mBuffer->getData(), mBuffer->getSamples(), mLooping, mPosition, mFraction, step, dest, count );
+
+   _checkEnd();
+   return read;
+}
+
+void SFXSoftVoice::_skip( U32 count, U32 outFrequency )
+{
+   const U64 advance = U64( mFraction ) + U64( _getStep( outFrequency ) ) * count;
+   const U64 pos = U64( mPosition ) + ( advance >> 16 );
+   const U32 samples = mBuffer->getSamples();
+
+   mFraction = U32( advance & 0xFFFF );
+   mPosition = pos < samples ? U32( pos ) : ( mLooping ? U32( pos % samples ) : samples );
+
+   _checkEnd();
+}
+
+void SFXSoftVoice::_getGains( const MatrixF &worldToListener, F32 *left, F32 *right ) const
+{
+   F32 volume = mVolume;
+
+   if ( !mBuffer->is3d() )
+   {
+      *left = *right = volume;
+      return;
+   }
+
+   // Same falloff as SFXSource::_updateVolume().
+   Point3F local;
+   worldToListener.mulP( mPosition3d, &local );
+   const F32 dist = local.len();
+   if ( dist > mMaxDistance )
+   {
+      *left = *right = 0;
+      return;
+   }
+
+   if ( dist > mMinDistance )
+      volume *= mMinDistance / dist;
+
+   // Only mono sounds are positioned, like the other devices.
+   if ( mBuffer->getChannels() != 1 )
+   {
+      *left = *right = volume;
+      return;
+   }
+
+   // Equal power pan across the listener's x axis.
+   const F32 pan = dist > 0.001f ? mClampF( local.x / dist, -1.0f, 1.0f ) : 0.0f;
+   const F32 angle = ( pan + 1.0f ) * M_PI_F * 0.25f;
+   *left = volume * mCos( angle );
+   *right = volume * mSin( angle );
+}
+
+void SFXSoftVoice::setPosition( U32 pos )
+{
+   mPosition = pos / mBuffer->getResourceSampleBytes();
+   mFraction = 0;
+
+   if ( mPosition >= mBuffer->getSamples() )
+      mPosition = 0;
+}
+
+void SFXSoftVoice::setMinMaxDistance( F32 min, F32 max )
+{
+   mMinDistance = min;
+   mMaxDistance = max;
+}
+
+void SFXSoftVoice::play( bool looping )
+{
+   mLooping = looping;
+   mStatus = SFXStatusPlaying;
+}
+
+void SFXSoftVoice::pause()
+{
+   mStatus = SFXStatusPaused;
+}
+
+void SFXSoftVoice::stop()
+{
+   mStatus = SFXStatusStopped;
+   mPosition = 0;
+   mFraction = 0;
+}
+
+SFXStatus SFXSoftVoice::getStatus() const
+{
+   return mStatus;
+}
+
+void SFXSoftVoice::setVelocity( const VectorF& velocity )
+{
+}
+
+void SFXSoftVoice::setTransform( const MatrixF& transform )
+{
+   transform.getColumn( 3, &mPosition3d );
+}
+
+void SFXSoftVoice::setVolume( F32 volume )
+{
+   mVolume = volume;
+}
+
+void SFXSoftVoice::setPitch( F32 pitch )
+{ 
+   mPitch = getMax( pitch, 0.01f );
+}
@@ -0,0 +1,126 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _SFXSOFTVOICE_H_
+#define _SFXSOFTVOICE_H_
+
+#ifndef _SFXVOICE_H_
+   #include "sfx/sfxVoice.h"
+#endif
+#ifndef _SFXSTATUS_H_
+   #include "sfx/sfxStatus.h"
+#endif
+#ifndef _TVECTOR_H_
+   #include "core/tVector.h"
+#endif
+
+class SFXSoftBuffer;
+
+
+/// A voice of the software mixer.
+///
+/// The voice doesn't play anything on its own.  The device
+/// pulls resampled blocks out of it with _read() when it 
+/// mixes and asks it for its speaker gains.
+///
+class SFXSoftVoice : public SFXVoice
+{
+   friend class SFXSoftDevice;
+
+   protected:
+
+      SFXSoftVoice( SFXSoftBuffer *buffer );
+
+      /// The buffer we're playing.  The device owns it.
+      SFXSoftBuffer *mBuffer;
+
+      ///
+      SFXStatus mStatus;
+
+      ///
+      bool mLooping;
+
+      /// The playback position in whole samples.
+      U32 mPosition;
+
+      /// The fraction of a sample past mPosition in 16.16 fixed point.
+      U32 mFraction;
+
+      ///
+      F32 mVolume;
+
+      ///
+      F32 mPitch;
+
+      /// The 3d position.  Velocity is ignored as the
+      /// mixer doesn't do doppler.
+      Point3F mPosition3d;
+
+      F32 mMinDistance;
+      F32 mMaxDistance;
+
+      /// Returns the 16.16 fixed point step thru the
+      /// buffer for each output sample.
+      U32 _getStep( U32 outFrequency ) const;
+
+      /// Stops the voice once a non-looping
+      /// sound passes its last sample.
+      void _checkEnd();
+
+      /// Resamples up to count samples into dest, which gets as
+      /// many channels per sample as the buffer has, and moves
+      /// the playback position along.
+      ///
+      /// @return The samples written, which is less than count
+      ///         only if the sound ended.
+      ///
+      U32 _read( F32 *dest, U32 count, U32 outFrequency );
+
+      /// Moves the playback position along as if count
+      /// samples were read.
+      void _skip( U32 count, U32 outFrequency );
+
+      /// Returns the left and right gains for the voice with
+      /// the volume, distance attenuation and panning applied.
+      ///
+      /// @param worldToListener The inverse listener transform.
+      ///
+      void _getGains( const MatrixF &worldToListener, F32 *left, F32 *right ) const;
+
+   public:
+
+      virtual ~SFXSoftVoice();
+
+      /// Returns true if the device should mix this voice.
+      bool isPlaying() const { return mStatus == SFXStatusPlaying; }
+
+      const SFXSoftBuffer* getBuffer() const { return mBuffer; }
+
+      void setPosition( U32 pos );
+
+      void setMinMaxDistance( F32 min, F32 max );
+
+      SFXStatus getStatus() const;
+
+      void play( bool looping );
+
+      void pause();
+
+      void stop();
+
+      void setVelocity( const VectorF& velocity );
+
+      void setTransform( const MatrixF& transform );
+
+      void setVolume( F32 volume );
+
+      void setPitch( F32 pitch );
+};
+
+
+/// A vector of SFXSoftVoice pointers.
+typedef Vector<SFXSoftVoice*> SFXSoftVoiceVector;
+
+#endif // _SFXSOFTVOICE_H_
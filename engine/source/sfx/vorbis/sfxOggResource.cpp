@@ -7,6 +7,81 @@
 
 #include "sfxOggResource.h"
 #include "vorbisStream.h"
+#include "sfx/sfxStream.h"
+
+
+/// Decodes an ogg file for a streaming voice.
+class SFXOggStream : public SFXStream
+{
+   protected:
+
+      Stream* mStream;
+
+      OggVorbisFile mFile;
+
+      S32 mSection;
+
+   public:
+
+      SFXOggStream()
+         :  mStream( NULL ),
+            mSection( 0 )
+      {
+      }
+
+      virtual ~SFXOggStream()
+      {
+         if ( !mStream )
+            return;
+
+         mFile.ov_clear();
+         ResourceManager->closeStream( mStream );
+      }
+
+      bool open( const char* filename )
+      {
+         mStream = ResourceManager->openStream( filename );
+         if ( !mStream )
+            return false;
+
+         if ( mFile.ov_open( mStream, NULL, 0 ) < 0 )
+         {
+            ResourceManager->closeStream( mStream );
+            mStream = NULL;
+            return false;
+         }
+
+         return true;
+      }
+
+      // SFXStream
+      virtual U32 read( U8 *buffer, U32 length )
+      {
+         #ifdef TORQUE_BIG_ENDIAN
+            bool endian = true;
+         #else
+            bool endian = false;
+         #endif
+
+         // ov_read() stops at packet boundaries.
+         U32 offset = 0;
+         while ( offset < length )
+         {
+            long bytesRead = mFile.ov_read( (char*)buffer + offset, length - offset, endian, &mSection );
+            if ( bytesRead <= 0 )
+               break;
+
+            offset += bytesRead;
+         }
+
+         return offset;
+      }
+
+      virtual bool seek( U32 sample )
+      {
+         return mFile.ov_pcm_seek( sample ) == 0;
+      }
+};
 
 
 ResourceInstance* SFXOggResource::create( Stream &stream )
@@ -20,8 +95,23 @@ ResourceInstance* SFXOggResource::create( Stream &stream )
 }
 
 
+ResourceInstance* SFXOggResource::createStreaming( Stream &stream, const char* filename )
+{
+   SFXOggResource* res = new SFXOggResource;
+   if ( res->load( stream, true ) )
+   {
+      res->mStreamFile = StringTable->insert( filename );
+      return res;
+   }
+
+   delete res;
+   return NULL;
+}
+
+
 SFXOggResource::SFXOggResource( )
-   : SFXResource()
+   :  SFXResource(),
+      mStreamFile( NULL )
 {
 }
 
@@ -31,7 +121,7 @@ SFXOggResource::~SFXOggResource()
 }
 
 
-bool SFXOggResource::load( Stream& stream )
+bool SFXOggResource::load( Stream& stream, bool streaming )
 {
    OggVorbisFile vf;
    vorbis_info *vi;
@@ -56,15 +146,23 @@ bool SFXOggResource::load( Stream& stream )
       mSize = 4 * samples;
    }
 
-   #ifdef TORQUE_BIG_ENDIAN
-      bool endian = true;
-   #else
-      bool endian = false;
-   #endif
-
-   mData = new U8[ mSize ];
-   S32 current_section = 0;
-   read( &vf, mData, mSize, endian, &current_section );
+   if ( streaming )
+   {
+      // Voices decode it as they play.
+      mIsStreaming = true;
+   }
+   else
+   {
+      #ifdef TORQUE_BIG_ENDIAN
+         bool endian = true;
+      #else
+         bool endian = false;
+      #endif
+
+      mData = new U8[ mSize ];
+      S32 current_section = 0;
+      read( &vf, mData, mSize, endian, &current_section );
+   }
 
    vf.ov_clear();
 
@@ -99,4 +197,17 @@ S32 SFXOggResource::read( OggVorbisFile* vf, U8* buffer, U32 length, bool bigend
    }
 
    return offset;
-}
\ No newline at end of file
+}
+
+SFXStream* SFXOggResource::openStream() const
+{
+   if ( !mIsStreaming )
+      return NULL;
+
+   SFXOggStream* stream = new SFXOggStream;
+   if ( stream->open( mStreamFile ) )
+      return stream;
+
+   delete stream;
+   return NULL;
+}
@@ -30,9 +30,13 @@ class SFXOggResource : public SFXResource
       /// The destructor.
       virtual ~SFXOggResource();
 
+      /// The file streaming voices decode from.
+      StringTableEntry mStreamFile;
+
       /// This does the real work of loading the 
-      /// data from the stream.
-      bool load( Stream& stream );
+      /// data from the stream.  For streaming only
+      /// the header is read.
+      bool load( Stream& stream, bool streaming = false );
 
       /// Helper function reads one buffer length of data.
       static S32 read( OggVorbisFile* vf, U8* buffer, U32 length, bool bigendianp, S32* bitstream );
@@ -46,6 +50,16 @@ class SFXOggResource : public SFXResource
       ///
       static ResourceInstance* create( Stream &stream );
 
+      /// Creates a streaming resource for the file
+      /// the stream was opened from.
+      ///
+      /// @see SFXResource::create()
+      ///
+      static ResourceInstance* createStreaming( Stream &stream, const char* filename );
+
+      // SFXResource
+      virtual SFXStream* openStream() const;
+
 };
 
 
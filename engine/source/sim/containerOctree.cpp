@@ -0,0 +1,199 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "sim/containerOctree.h"
+
+//----------------------------------------------------------------------------
+
+ContainerOctree::ContainerOctree(F32 rootHalfSize, U32 maxDepth)
+{
+    AssertFatal(rootHalfSize > 0.0f, "ContainerOctree: bad root size");
+
+    mRootHalfSize = rootHalfSize;
+    mMaxDepth = getMin(maxDepth, U32(24));
+    mRoot = allocNode(NULL, Point3F(0, 0, 0), rootHalfSize);
+}
+
+ContainerOctree::~ContainerOctree()
+{
+    freeNode(mRoot);
+    mRoot = NULL;
+}
+
+ContainerOctreeNode* ContainerOctree::allocNode(ContainerOctreeNode* parent, const Point3F& center, F32 halfSize)
+{
+    ContainerOctreeNode* node = mNodeChunker.alloc();
+    node->center = center;
+    node->halfSize = halfSize;
+    node->depth = parent ? parent->depth + 1 : 0;
+    node->parent = parent;
+    for (U32 i = 0; i < 8; i++)
+        node->children[i] = NULL;
+
+    node->objects.object = NULL;
+    node->objects.nextInBin = NULL;
+    node->objects.prevInBin = NULL;
+    node->objects.nextInObj = NULL;
+    node->subtreeCount = 0;
+    return node;
+}
+
+void ContainerOctree::freeNode(ContainerOctreeNode* node)
+{
+    for (U32 i = 0; i < 8; i++)
+        if (node->children[i])
+            freeNode(node->children[i]);
+    mNodeChunker.free(node);
+}
+
+//----------------------------------------------------------------------------
+
+S32 ContainerOctree::getPlacementDepth(const Box3F& box, Point3F& center) const
+{
+    center = (box.min + box.max) * 0.5f;
+    if (mFabs(center.x) >= mRootHalfSize ||
+        mFabs(center.y) >= mRootHalfSize ||
+        mFabs(center.z) >= mRootHalfSize)
+        return -1;
+
+    F32 extent = getMax(box.len_x(), getMax(box.len_y(), box.len_z())) * 0.5f;
+    if (extent > mRootHalfSize)
+        return -1;
+
+    // Go down as long as the child cells are still at least as big as the object.
+    S32 depth = 0;
+    F32 halfSize = mRootHalfSize * 0.5f;
+    while (depth < S32(mMaxDepth) && halfSize >= extent)
+    {
+        depth++;
+        halfSize *= 0.5f;
+    }
+    return depth;
+}
+
+ContainerOctreeNode* ContainerOctree::findNode(const Box3F& box)
+{
+    Point3F center;
+    S32 depth = getPlacementDepth(box, center);
+    if (depth < 0)
+        return NULL;
+
+    ContainerOctreeNode* node = mRoot;
+    while (S32(node->depth) < depth)
+    {
+        U32 index = 0;
+        Point3F childCenter = node->center;
+        F32 childHalf = node->halfSize * 0.5f;
+
+        if (center.x >= node->center.x) { index |= 1; childCenter.x += childHalf; }
+        else childCenter.x -= childHalf;
+        if (center.y >= node->center.y) { index |= 2; childCenter.y += childHalf; }
+        else childCenter.y -= childHalf;
+        if (center.z >= node->center.z) { index |= 4; childCenter.z += childHalf; }
+        else childCenter.z -= childHalf;
+
+        if (node->children[index] == NULL)
+            node->children[index] = allocNode(node, childCenter, childHalf);
+        node = node->children[index];
+    }
+    return node;
+}
+
+bool ContainerOctree::isPlacedIn(const ContainerOctreeNode* node, const Box3F& box) const
+{
+    Point3F center;
+    S32 depth = getPlacementDepth(box, center);
+    if (node == NULL || depth < 0)
+        return node == NULL && depth < 0;
+
+    // Anything whose center is still in the (closed) cell is covered by the
+    // loose bounds, so there's no need to be exact about the cell edges.
+    return S32(node->depth) == depth &&
+        mFabs(center.x - node->center.x) <= node->halfSize &&
+        mFabs(center.y - node->center.y) <= node->halfSize &&
+        mFabs(center.z - node->center.z) <= node->halfSize;
+}
+
+//----------------------------------------------------------------------------
+
+void ContainerOctree::insert(ContainerOctreeNode* node, SceneObjectRef* ref)
+{
+    ref->nextInBin = node->objects.nextInBin;
+    ref->prevInBin = &node->objects;
+    if (node->objects.nextInBin)
+        node->objects.nextInBin->prevInBin = ref;
+    node->objects.nextInBin = ref;
+
+    for (ContainerOctreeNode* walk = node; walk; walk = walk->parent)
+        walk->subtreeCount++;
+}
+
+void ContainerOctree::removed(ContainerOctreeNode* node)
+{
+    // Find the topmost node that just went empty, and drop it and everything
+    // below it.  The root always stays.
+    ContainerOctreeNode* prune = NULL;
+    for (ContainerOctreeNode* walk = node; walk; walk = walk->parent)
+    {
+        AssertFatal(walk->subtreeCount != 0, "ContainerOctree: bad subtree count");
+        if (--walk->subtreeCount == 0 && walk != mRoot)
+            prune = walk;
+    }
+
+    if (prune)
+    {
+        ContainerOctreeNode* parent = prune->parent;
+        for (U32 i = 0; i < 8; i++)
+        {
+            if (parent->children[i] == prune)
+            {
+                parent->children[i] = NULL;
+                break;
+            }
+        }
+        freeNode(prune);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+U32 ContainerOctree::findRefs(const Box3F& box, const Point3F* start, const Point3F* end,
+    RefCallback callback, void* key)
+{
+    // Depth first with an explicit stack, at most 7 pending siblings per level.
+    ContainerOctreeNode* stack[8 * 32];
+    U32 stackSize = 0;
+    U32 visited = 0;
+
+    if (mRoot->subtreeCount)
+        stack[stackSize++] = mRoot;
+
+    while (stackSize)
+    {
+        ContainerOctreeNode* node = stack[--stackSize];
+
+        Box3F looseBox;
+        node->getLooseBox(looseBox);
+        if (!looseBox.isOverlapped(box))
+            continue;
+        if (start && !looseBox.collideLine(*start, *end))
+            continue;
+
+        visited++;
+        for (SceneObjectRef* chain = node->objects.nextInBin; chain; chain = chain->nextInBin)
+            (*callback)(chain, key);
+
+        for (U32 i = 0; i < 8; i++)
+        {
+            ContainerOctreeNode* child = node->children[i];
+            if (child && child->subtreeCount)
+            {
+                AssertFatal(stackSize < sizeof(stack) / sizeof(stack[0]), "ContainerOctree: traversal stack overflow");
+                stack[stackSize++] = child;
+            }
+        }
+    }
+    return visited;
+}
@@ -0,0 +1,100 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _CONTAINEROCTREE_H_
+#define _CONTAINEROCTREE_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _DATACHUNKER_H_
+#include "core/dataChunker.h"
+#endif
+#ifndef _SCENEOBJECT_H_
+#include "sim/sceneObject.h"
+#endif
+
+//----------------------------------------------------------------------------
+/// Node of a ContainerOctree.
+///
+/// The node's cell is center +/- halfSize, but objects are placed by the cell
+/// containing their center, so the node's loose bounds are twice that.  Objects
+/// in the node are chained off of the objects sentinel through nextInBin, just
+/// like a container bin.
+struct ContainerOctreeNode
+{
+    Point3F center;
+    F32     halfSize;
+    U32     depth;
+
+    ContainerOctreeNode* parent;
+    ContainerOctreeNode* children[8];
+
+    SceneObjectRef objects;       ///< Sentinel, only nextInBin is used
+    U32            subtreeCount; ///< Objects in this node and all of its children
+
+    void getLooseBox(Box3F& box) const
+    {
+        F32 loose = halfSize * 2.0f;
+        box.min.set(center.x - loose, center.y - loose, center.z - loose);
+        box.max.set(center.x + loose, center.y + loose, center.z + loose);
+    }
+};
+
+//----------------------------------------------------------------------------
+/// Loose octree used by Container as an alternative to the wrapping bin grid.
+///
+/// Each object lives in exactly one node: the deepest one whose cell is at
+/// least as large as the object and contains the object's center.  Objects
+/// that don't fit under the root (or that have global bounds) are left for the
+/// container's overflow bin.  Nodes are created on demand and pruned when
+/// their subtree empties.
+class ContainerOctree
+{
+    ContainerOctreeNode*                  mRoot;
+    F32                                   mRootHalfSize;
+    U32                                   mMaxDepth;
+    FreeListChunker<ContainerOctreeNode>  mNodeChunker;
+
+    ContainerOctreeNode* allocNode(ContainerOctreeNode* parent, const Point3F& center, F32 halfSize);
+    void freeNode(ContainerOctreeNode* node);
+
+    /// Returns the depth an object with the given box should be placed at, or
+    /// -1 if it doesn't fit under the root.
+    S32 getPlacementDepth(const Box3F& box, Point3F& center) const;
+
+public:
+    typedef void (*RefCallback)(SceneObjectRef* ref, void* key);
+
+    ContainerOctree(F32 rootHalfSize, U32 maxDepth);
+    ~ContainerOctree();
+
+    F32 getRootHalfSize() const { return mRootHalfSize; }
+    U32 getMaxDepth() const { return mMaxDepth; }
+
+    /// Finds (creating if needed) the node an object with the given world box
+    /// belongs in.  Returns NULL if it belongs in the overflow bin.
+    ContainerOctreeNode* findNode(const Box3F& box);
+
+    /// Returns true if an object with the given world box would be placed in
+    /// node.  A NULL node stands for the overflow bin.
+    bool isPlacedIn(const ContainerOctreeNode* node, const Box3F& box) const;
+
+    /// Link ref into node's object chain.
+    void insert(ContainerOctreeNode* node, SceneObjectRef* ref);
+
+    /// Called after a ref has been unlinked from node's chain.  Prunes any
+    /// nodes left empty.
+    void removed(ContainerOctreeNode* node);
+
+    /// Calls callback for every ref in a node whose loose bounds overlap box
+    /// and, if start is given, are hit by the segment start-end.
+    ///
+    /// @returns Number of nodes visited.
+    U32 findRefs(const Box3F& box, const Point3F* start, const Point3F* end,
+        RefCallback callback, void* key);
+};
+
+#endif
@@ -208,6 +208,9 @@ void NetConnection::setNetClassGroup(U32 grp)
 }
 
 NetConnection::NetConnection()
+    : mNotifyPool(MaxPacketNotifySize, NotifyPoolChunkSize),
+    mGhostRefPool(sizeof(GhostRef), NotifyPoolChunkSize),
+    mEventNotePool(sizeof(NetEventNote), NotifyPoolChunkSize)
 {
     mTranslateStrings = false;
     mConnectSequence = 0;
@@ -267,6 +270,8 @@ NetConnection::NetConnection()
     mGhostingSequence = 0;
     mGhosting = false;
     mScoping = false;
+    mScopeStats.queries = 0;
+    mScopeStats.objectsExamined = 0;
     mGhostArray = NULL;
     mGhostRefs = NULL;
     mGhostLookupTable = NULL;
@@ -388,6 +393,28 @@ ConsoleMethod(NetConnection, getPacketLoss, S32, 2, 2, "conn.getPacketLoss()")
     return(S32(100 * object->getPacketLoss()));
 }
 
+ConsoleMethod(NetConnection, getScopeStats, const char*, 2, 2, "conn.getScopeStats()"
+    "Returns \"queries objectsExamined\" for the scene scoping done for this connection.")
+{
+    const NetConnection::ScopeStats& stats = object->getScopeStats();
+    char* returnBuffer = Con::getReturnBuffer(32);
+    dSprintf(returnBuffer, 32, "%d %d", stats.queries, stats.objectsExamined);
+    return returnBuffer;
+}
+
+ConsoleMethod(NetConnection, resetScopeStats, void, 2, 2, "conn.resetScopeStats()")
+{
+    NetConnection::ScopeStats& stats = object->getScopeStats();
+    stats.queries = 0;
+    stats.objectsExamined = 0;
+}
+
+ConsoleMethod(NetConnection, dumpAllocStats, void, 2, 2, "conn.dumpAllocStats()"
+    "Prints the usage of the packet notify, ghost ref and event note pools of this connection.")
+{
+    object->dumpAllocStats();
+}
+
 ConsoleMethod(NetConnection, checkMaxRate, void, 2, 2, "conn.checkMaxRate()")
 {
     argc; argv;
@@ -485,7 +512,7 @@ void NetConnection::handleNotify(bool recvd)
     else
         packetDropped(note);
 
-    delete note;
+    freeNotify(note);
 }
 
 void NetConnection::processRawPacket(BitStream* bstream)
@@ -539,7 +566,31 @@ void NetConnection::connectionError(const char* errorString)
 
 NetConnection::PacketNotify* NetConnection::allocNotify()
 {
-    return new PacketNotify;
+    return new (allocNotifyMemory(sizeof(PacketNotify))) PacketNotify;
+}
+
+void* NetConnection::allocNotifyMemory(U32 size)
+{
+    AssertFatal(size <= mNotifyPool.getElementSize(), "NetConnection::allocNotifyMemory - notify too large for the pool, raise MaxPacketNotifySize.");
+    return mNotifyPool.alloc();
+}
+
+void NetConnection::freeNotify(PacketNotify* note)
+{
+    // Subclass notifies only add plain data, so there's nothing more to tear down.
+    note->~PacketNotify();
+    mNotifyPool.free(note);
+}
+
+void NetConnection::dumpAllocStats()
+{
+    Con::printf("Connection %d pools:   in use   peak  capacity  allocs", getId());
+    Con::printf("  packet notifies    %6d %6d %9d %7d", mNotifyPool.getInUse(), mNotifyPool.getPeakInUse(),
+        mNotifyPool.getCapacity(), mNotifyPool.getAllocCount());
+    Con::printf("  ghost refs         %6d %6d %9d %7d", mGhostRefPool.getInUse(), mGhostRefPool.getPeakInUse(),
+        mGhostRefPool.getCapacity(), mGhostRefPool.getAllocCount());
+    Con::printf("  event notes        %6d %6d %9d %7d", mEventNotePool.getInUse(), mEventNotePool.getPeakInUse(),
+        mEventNotePool.getCapacity(), mEventNotePool.getAllocCount());
 }
 
 /// Used when simulating lag.
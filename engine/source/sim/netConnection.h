@@ -21,6 +21,9 @@
 #ifndef _DNET_H_
 #include "core/dnet.h"
 #endif
+#ifndef _DATACHUNKER_H_
+#include "core/dataChunker.h"
+#endif
 
 #ifndef _H_CONNECTIONSTRINGTABLE
 #include "sim/connectionStringTable.h"
@@ -698,11 +701,27 @@ public:
         PacketNotify* nextPacket;  ///< Next packet sent.
         PacketNotify();
     };
+
+    enum NotifyConstants {
+        MaxPacketNotifySize = 128, ///< Largest PacketNotify subclass the notify pool can hold.
+        NotifyPoolChunkSize = 4096,
+    };
+
+    /// Allocate the notify for an outgoing packet.
+    ///
+    /// Subclasses that track more per packet should derive from PacketNotify and
+    /// construct it with placement new in memory from allocNotifyMemory().
     virtual PacketNotify* allocNotify();
+    void* allocNotifyMemory(U32 size);
+    void freeNotify(PacketNotify* note);
+
     PacketNotify* mNotifyQueueHead;  ///< Head of packet notify list.
     PacketNotify* mNotifyQueueTail;  ///< Tail of packet notify list.
 
 protected:
+    FreeListPool<PacketNotify> mNotifyPool;  ///< PacketNotifies, sized for MaxPacketNotifySize
+    FreeListPool<GhostRef> mGhostRefPool;    ///< GhostRefs for the updates in flight
+
     virtual void readPacket(BitStream* bstream);
     virtual void writePacket(BitStream* bstream, PacketNotify* note);
     virtual void packetReceived(PacketNotify* note);
@@ -721,7 +740,7 @@ private:
     NetEventNote* mWaitSeqEvents;
     NetEventNote* mNotifyEventList;
 
-    static FreeListChunker<NetEventNote> mEventNoteChunker;
+    FreeListPool<NetEventNote> mEventNotePool;
 
     bool mSendingEvents;
 
@@ -789,6 +808,13 @@ public:
     /// @name Ghost manager
     /// @{
 
+    /// Scene scoping work done for this connection.
+    struct ScopeStats
+    {
+        U32 queries;           ///< Scene scope queries run
+        U32 objectsExamined;   ///< Objects those queries looked at
+    };
+
 protected:
     enum GhostStates
     {
@@ -809,6 +835,7 @@ protected:
 
     bool mGhosting;             ///< Am I currently ghosting objects?
     bool mScoping;              ///< am I currently scoping objects?
+    ScopeStats mScopeStats;
     U32  mGhostingSequence;     ///< Sequence number describing this ghosting session.
 
     NetObject** mLocalGhosts;  ///< Local ghost for remote object.
@@ -878,6 +905,12 @@ public:
     /// Add an object to scope.
     void objectInScope(NetObject* object);
 
+    /// Counters for the scene scoping done for this connection.
+    ScopeStats& getScopeStats() { return mScopeStats; }
+
+    /// Print the usage of this connection's packet, ghost and event pools.
+    void dumpAllocStats();
+
     /// Add an object to scope, marking that it should always be scoped to this connection.
     void objectLocalScopeAlways(NetObject* object);
 
@@ -11,8 +11,6 @@
 
 #define DebugChecksum 0xF00DBAAD
 
-FreeListChunker<NetEventNote> NetConnection::mEventNoteChunker;
-
 NetEvent::~NetEvent()
 {
     AssertWarn(mRefCount == 0, "NetEvent::~NetEvent - encountered non-zero ref count!");
@@ -42,7 +40,7 @@ void NetConnection::eventOnRemove()
 
         temp->mEvent->notifyDelivered(this, true);
         temp->mEvent->decRef();
-        mEventNoteChunker.free(temp);
+        mEventNotePool.free(temp);
     }
 
     while (mUnorderedSendEventQueueHead)
@@ -52,7 +50,7 @@ void NetConnection::eventOnRemove()
 
         temp->mEvent->notifyDelivered(this, true);
         temp->mEvent->decRef();
-        mEventNoteChunker.free(temp);
+        mEventNotePool.free(temp);
     }
 
     while (mSendEventQueueHead)
@@ -62,7 +60,7 @@ void NetConnection::eventOnRemove()
 
         temp->mEvent->notifyDelivered(this, true);
         temp->mEvent->decRef();
-        mEventNoteChunker.free(temp);
+        mEventNotePool.free(temp);
     }
 }
 
@@ -111,7 +109,7 @@ void NetConnection::eventPacketDropped(PacketNotify* notify)
             walk->mEvent->notifyDelivered(this, false);
             walk->mEvent->decRef();
             temp = walk->mNextEvent;
-            mEventNoteChunker.free(walk);
+            mEventNotePool.free(walk);
             walk = temp;
         }
     }
@@ -129,7 +127,7 @@ void NetConnection::eventPacketReceived(PacketNotify* notify)
         {
             walk->mEvent->notifyDelivered(this, true);
             walk->mEvent->decRef();
-            mEventNoteChunker.free(walk);
+            mEventNotePool.free(walk);
             walk = next;
         }
         else
@@ -150,7 +148,7 @@ void NetConnection::eventPacketReceived(PacketNotify* notify)
         //Con::printf("EVT  %d: ACK - %d", getId(), mNotifyEventList->mSeqCount);
         mNotifyEventList->mEvent->notifyDelivered(this, true);
         mNotifyEventList->mEvent->decRef();
-        mEventNoteChunker.free(mNotifyEventList);
+        mEventNotePool.free(mNotifyEventList);
         mNotifyEventList = next;
     }
 }
@@ -331,7 +329,7 @@ void NetConnection::eventReadPacket(BitStream* bstream)
         if (seq < mNextRecvEventSeq)
             seq += 128;
 
-        NetEventNote* note = mEventNoteChunker.alloc();
+        NetEventNote* note = mEventNotePool.alloc();
         note->mEvent = evt;
         note->mEvent->incRef();
 
@@ -353,7 +351,7 @@ void NetConnection::eventReadPacket(BitStream* bstream)
         //Con::printf("EVT  %d: PROCESS - %d", getId(), temp->mSeqCount);
         temp->mEvent->process(this);
         temp->mEvent->decRef();
-        mEventNoteChunker.free(temp);
+        mEventNotePool.free(temp);
         if (mErrorBuffer[0])
             return;
     }
@@ -366,7 +364,7 @@ bool NetConnection::postNetEvent(NetEvent* theEvent)
         theEvent->decRef();
         return false;
     }
-    NetEventNote* event = mEventNoteChunker.alloc();
+    NetEventNote* event = mEventNotePool.alloc();
     event->mEvent = theEvent;
     theEvent->incRef();
 
@@ -417,7 +415,7 @@ void NetConnection::eventReadStartBlock(BitStream* stream)
         S32 classTag = stream->readClassId(NetClassTypeEvent, getNetClassGroup());
         NetEvent* evt = (NetEvent*)ConsoleObject::create(getNetClassGroup(), NetClassTypeEvent, classTag);
         evt->unpack(this, stream);
-        NetEventNote* add = mEventNoteChunker.alloc();
+        NetEventNote* add = mEventNotePool.alloc();
         add->mEvent = evt;
         evt->incRef();
         add->mNextEvent = NULL;
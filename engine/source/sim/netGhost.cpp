@@ -225,7 +225,7 @@ void NetConnection::ghostPacketDropped(PacketNotify* notify)
             packRef->ghost->flags &= ~GhostInfo::KillingGhost;
         }
 
-        delete packRef;
+        mGhostRefPool.free(packRef);
         packRef = temp;
     }
 }
@@ -261,7 +261,7 @@ void NetConnection::ghostPacketReceived(PacketNotify* notify)
         else if (packRef->ghostInfoFlags & GhostInfo::KillingGhost)
             freeGhostInfo(packRef->ghost);
 
-        delete packRef;
+        mGhostRefPool.free(packRef);
         packRef = temp;
     }
 }
@@ -277,13 +277,57 @@ struct UpdateQueueEntry
     }
 };
 
-static S32 QSORT_CALLBACK UQECompare(const void* a, const void* b)
+//-----------------------------------------------------------------------------
+// Ghost update heap.
+//
+// Only the ghosts that fit in the packet need to come out in priority order, so
+// rather than sorting every dirty ghost each packet, the dirty part of
+// mGhostArray is made into a max heap on priority and the best ghost is popped
+// to the back each time another one is written.  That's linear in the number
+// of dirty ghosts plus log n per ghost actually sent.  arrayIndex is kept up to
+// date as entries move so the ghostPush* functions keep working.
+
+static inline void ghostHeapSwap(GhostInfo** heap, U32 a, U32 b)
+{
+    GhostInfo* temp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = temp;
+    heap[a]->arrayIndex = a;
+    heap[b]->arrayIndex = b;
+}
+
+static void ghostHeapSiftDown(GhostInfo** heap, U32 index, U32 size)
+{
+    for (;;)
+    {
+        U32 best = index;
+        U32 left = index * 2 + 1;
+        U32 right = left + 1;
+        if (left < size && heap[left]->priority > heap[best]->priority)
+            best = left;
+        if (right < size && heap[right]->priority > heap[best]->priority)
+            best = right;
+        if (best == index)
+            return;
+        ghostHeapSwap(heap, index, best);
+        index = best;
+    }
+}
+
+static void ghostHeapBuild(GhostInfo** heap, U32 size)
 {
-    GhostInfo* ga = *((GhostInfo**)a);
-    GhostInfo* gb = *((GhostInfo**)b);
+    for (U32 i = size / 2; i-- > 0; )
+        ghostHeapSiftDown(heap, i, size);
+}
 
-    F32 ret = ga->priority - gb->priority;
-    return (ret < 0) ? -1 : ((ret > 0) ? 1 : 0);
+/// Moves the highest priority ghost to heap[size - 1], leaving a heap of size - 1.
+static void ghostHeapPop(GhostInfo** heap, U32 size)
+{
+    if (size > 1)
+    {
+        ghostHeapSwap(heap, 0, size - 1);
+        ghostHeapSiftDown(heap, 0, size - 1);
+    }
 }
 
 void NetConnection::ghostWritePacket(BitStream* bstream, PacketNotify* notify)
@@ -369,11 +413,7 @@ void NetConnection::ghostWritePacket(BitStream* bstream, PacketNotify* notify)
             walk->priority = 0;
     }
     GhostRef* updateList = NULL;
-    dQsort(mGhostArray, mGhostZeroUpdateIndex, sizeof(GhostInfo*), UQECompare);
-
-    // reset the array indices...
-    for (i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
-        mGhostArray[i]->arrayIndex = i;
+    ghostHeapBuild(mGhostArray, mGhostZeroUpdateIndex);
 
     S32 sendSize = 1;
     while (maxIndex >>= 1)
@@ -388,6 +428,9 @@ void NetConnection::ghostWritePacket(BitStream* bstream, PacketNotify* notify)
     //
     for (i = mGhostZeroUpdateIndex - 1; i >= 0 && !bstream->isFull(); i--)
     {
+        // Everything above i has been popped already, so the heap is [0, i].
+        // Ghosts that get pushed to zero below only swap with entries above i.
+        ghostHeapPop(mGhostArray, i + 1);
         GhostInfo* walk = mGhostArray[i];
         if (walk->flags & (GhostInfo::KillingGhost | GhostInfo::Ghosting))
             continue;
@@ -397,7 +440,7 @@ void NetConnection::ghostWritePacket(BitStream* bstream, PacketNotify* notify)
         bstream->writeInt(walk->index, sendSize);
         U32 updateMask = walk->updateMask;
 
-        GhostRef* upd = new GhostRef;
+        GhostRef* upd = mGhostRefPool.alloc();
 
         upd->nextRef = updateList;
         updateList = upd;
@@ -423,6 +423,9 @@ void ProcessList::advanceObjects()
     mHead.plUnlink();
     while (list.mProcessLink.next != &list)
     {
+        if (mIsServer && !gSPMode && advanceMarbleRun(list))
+            continue;
+
         SimObjectPtr<GameBase> obj = getGameBase(list.mProcessLink.next);
 
         obj->plUnlink();
@@ -514,6 +517,45 @@ void ProcessList::advanceObjects()
     PROFILE_END();
 }
 
+//-----------------------------------------------------------------------------
+// Move handling for advanceMarbleRun()
+//-----------------------------------------------------------------------------
+bool ProcessList::takeMarbleMove(GameBase* marble, Move*& move, GameConnection*& con)
+{
+    move = NULL;
+    con = NULL;
+
+    if (!marble)
+        return false;
+
+    GameConnection* controller = marble->getControllingClient();
+    U32 numMoves;
+    if (controller && controller->getControlObject() == marble && controller->getMoveList(&move, &numMoves))
+    {
+        con = controller;
+        return true;
+    }
+
+    move = NULL;
+    return marble->mProcessTick;
+}
+
+void ProcessList::endMarbleMove(GameBase* marble, Move* move, GameConnection* con)
+{
+    if (!con)
+        return;
+
+    if (marble && marble->getControllingClient())
+    {
+        U32 newsum = Move::ChecksumMask & marble->getPacketDataChecksum(con);
+        if (move->checksum != newsum)
+            move->checksum = Move::ChecksumMismatch;
+    }
+
+    // The move was used even if the marble went away during its tick.
+    con->clearMoves(1);
+}
+
 void ProcessList::ageTickCache(S32 numToAge, S32 len)
 {
     for (ProcessObject* i = mHead.mProcessLink.next; i != &mHead; i = i->mProcessLink.next)
@@ -11,6 +11,8 @@
 
 class GameConnection;
 class GameBase;
+class Marble;
+struct Move;
 
 class ProcessObject
 {
@@ -54,6 +56,24 @@ class ProcessList
     void orderList();
     void advanceObjects();
 
+    /// Ticks a run of marbles at the head of list together so their
+    /// physics can be stepped in parallel.  Returns false if there is no
+    /// run worth batching.
+    bool advanceMarbleRun(ProcessObject& list);
+
+    /// Gets the move for a marble in the run the same way advanceObjects()
+    /// does.  Returns false if the marble doesn't tick this time.
+    bool takeMarbleMove(GameBase* marble, Move*& move, GameConnection*& con);
+
+    /// Updates the move checksum and clears the move, if a connection's
+    /// move was taken.
+    void endMarbleMove(GameBase* marble, Move* move, GameConnection* con);
+
+    /// Steps the pending marbles of a run together, then commits and
+    /// finishes them in process order.
+    void finishMarbleRun(Vector<SimObjectPtr<Marble> >& run, Vector<S32>& pending,
+                         Vector<Move*>& moves, Vector<GameConnection*>& cons);
+
 public:
     SimTime getLastTime() { return mLastTime; }
     ProcessList(bool isServer);
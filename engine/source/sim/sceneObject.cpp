@@ -20,6 +20,13 @@
 #include "gfx/gBitmap.h"
 #include "lightingSystem/sgLightObject.h"
 #include "sim/netConnection.h"
+#include "sim/containerOctree.h"
+#include "math/mRandom.h"
+
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+#include <xmmintrin.h>
+#define CONTAINER_SSE_RAYS
+#endif
 
 IMPLEMENT_CONOBJECT(SceneObject);
 
@@ -247,6 +254,125 @@ ConsoleFunction(containerRayCast, const char*, 4, 5, "( Point3F start, Point3F e
     return(returnBuffer);
 }
 
+ConsoleFunction(containerSetSpatialIndex, void, 2, 4, "(string index, float rootHalfSize=4096, int maxDepth=8)"
+    "Select the spatial index used by the server, client and single player containers.\n\n"
+    "@param index \"grid\" for the wrapping bin grid or \"octree\" for a loose octree centered on the origin.\n"
+    "@param rootHalfSize Half the width of the octree root cell.  Objects outside it go in the overflow bin.\n"
+    "@param maxDepth Deepest octree level.")
+{
+    Container::SpatialIndex index;
+    if (!dStricmp(argv[1], "grid"))
+        index = Container::BinGrid;
+    else if (!dStricmp(argv[1], "octree"))
+        index = Container::LooseOctree;
+    else
+    {
+        Con::errorf("containerSetSpatialIndex: unknown index '%s'", argv[1]);
+        return;
+    }
+
+    F32 rootHalfSize = argc > 2 ? dAtof(argv[2]) : 4096.0f;
+    U32 maxDepth = argc > 3 ? dAtoi(argv[3]) : 8;
+    if (rootHalfSize <= 0.0f)
+    {
+        Con::errorf("containerSetSpatialIndex: root size must be positive");
+        return;
+    }
+
+    gServerContainer.setSpatialIndex(index, rootHalfSize, maxDepth);
+    gClientContainer.setSpatialIndex(index, rootHalfSize, maxDepth);
+    gSPModeContainer.setSpatialIndex(index, rootHalfSize, maxDepth);
+}
+
+ConsoleFunction(containerGetQueryStats, const char*, 1, 2, "(bool client=false)"
+    "Get the query counters of the server (or client) container since the last containerResetQueryStats().\n\n"
+    "@returns \"queries cellsVisited objectsVisited objectsAccepted\"")
+{
+    Container* container = (argc > 1 && dAtob(argv[1])) ? getCurrentClientContainer() : getCurrentServerContainer();
+    const Container::QueryStats& stats = container->getQueryStats();
+
+    char* returnBuffer = Con::getReturnBuffer(64);
+    dSprintf(returnBuffer, 64, "%d %d %d %d",
+        stats.queries, stats.cellsVisited, stats.objectsVisited, stats.objectsAccepted);
+    return returnBuffer;
+}
+
+ConsoleFunction(containerResetQueryStats, void, 1, 1, "Reset the query counters of all containers.")
+{
+    gServerContainer.resetQueryStats();
+    gClientContainer.resetQueryStats();
+    gSPModeContainer.resetQueryStats();
+}
+
+ConsoleFunction(containerRayCastBenchmark, void, 4, 7, "(Point3F center, float radius, int numRays, bitset mask=-1, float rayLength=radius, int iterations=100)"
+    "Time castRay against castRays on the server container.\n\n"
+    "Casts numRays random rays starting within radius of center, each iteration "
+    "once ray by ray and once as a batch, and reports the timings and any rays "
+    "where the two disagree.")
+{
+    Point3F center;
+    dSscanf(argv[1], "%g %g %g", &center.x, &center.y, &center.z);
+    F32 radius = dAtof(argv[2]);
+    S32 numRays = dAtoi(argv[3]);
+    U32 mask = argc > 4 ? dAtoi(argv[4]) : 0xFFFFFFFF;
+    F32 rayLength = argc > 5 ? dAtof(argv[5]) : radius;
+    S32 iterations = argc > 6 ? dAtoi(argv[6]) : 100;
+    if (numRays <= 0 || iterations <= 0)
+        return;
+
+    // Fixed seed so runs are comparable.
+    MRandomLCG random(1376312589);
+    Vector<Container::RayQuery> rays;
+    rays.setSize(numRays);
+    for (S32 i = 0; i < numRays; i++)
+    {
+        Point3F offset(random.randF(-1, 1), random.randF(-1, 1), random.randF(-1, 1));
+        VectorF dir(random.randF(-1, 1), random.randF(-1, 1), random.randF(-1, 1));
+        if (dir.isZero())
+            dir.set(0, 0, -1);
+        dir.normalize(rayLength);
+
+        rays[i].start = center + offset * radius;
+        rays[i].end = rays[i].start + dir;
+    }
+
+    Container* container = getCurrentServerContainer();
+    Vector<RayInfo> single;
+    Vector<bool> singleHit;
+    single.setSize(numRays);
+    singleHit.setSize(numRays);
+
+    container->resetQueryStats();
+    U32 start = Platform::getRealMilliseconds();
+    for (S32 it = 0; it < iterations; it++)
+        for (S32 i = 0; i < numRays; i++)
+            singleHit[i] = container->castRay(rays[i].start, rays[i].end, mask, &single[i]);
+    U32 singleTime = Platform::getRealMilliseconds() - start;
+    Container::QueryStats singleStats = container->getQueryStats();
+
+    container->resetQueryStats();
+    start = Platform::getRealMilliseconds();
+    U32 numHits = 0;
+    for (S32 it = 0; it < iterations; it++)
+        numHits = container->castRays(rays.address(), numRays, mask);
+    U32 batchTime = Platform::getRealMilliseconds() - start;
+    Container::QueryStats batchStats = container->getQueryStats();
+
+    S32 mismatches = 0;
+    for (S32 i = 0; i < numRays; i++)
+    {
+        if (singleHit[i] != rays[i].hit ||
+            (rays[i].hit && (single[i].object != rays[i].info.object || mFabs(single[i].t - rays[i].info.t) > 1e-5f)))
+            mismatches++;
+    }
+
+    Con::printf("containerRayCastBenchmark: %d rays x %d iterations, %d hits, %d mismatches", numRays, iterations, numHits, mismatches);
+    Con::printf("   castRay:  %5d ms (%d queries, %d objects visited, %d tested)",
+        singleTime, singleStats.queries, singleStats.objectsVisited, singleStats.objectsAccepted);
+    Con::printf("   castRays: %5d ms (%d queries, %d objects visited, %d tested)",
+        batchTime, batchStats.queries, batchStats.objectsVisited, batchStats.objectsAccepted);
+}
+
 ConsoleFunctionGroupEnd(Containers);
 
 // Utility method for bin insertion
@@ -372,6 +498,7 @@ SceneObject::SceneObject()
     mBinMaxX = 0xFFFFFFFF;
     mBinMinY = 0xFFFFFFFF;
     mBinMaxY = 0xFFFFFFFF;
+    mOctreeNode = NULL;
 
     mHidden = false;
 
@@ -861,6 +988,9 @@ Container::Container()
     mOverflowBin.prevInBin = NULL;
     mOverflowBin.nextInObj = NULL;
 
+    mOctree = NULL;
+    resetQueryStats();
+
     VECTOR_SET_ASSOCIATION(mRefPoolBlocks);
     VECTOR_SET_ASSOCIATION(mSearchList);
 
@@ -893,9 +1023,42 @@ Container::~Container()
     }
     mFreeRefPool = NULL;
 
+    delete mOctree;
+    mOctree = NULL;
+
     cleanupSearchVectors();
 }
 
+//----------------------------------------------------------------------------
+
+void Container::setSpatialIndex(SpatialIndex index, F32 rootHalfSize, U32 maxDepth)
+{
+    if (index == getSpatialIndex() &&
+        (index == BinGrid ||
+            (mOctree->getRootHalfSize() == rootHalfSize && mOctree->getMaxDepth() == maxDepth)))
+        return;
+
+    Link* itr;
+    for (itr = mStart.next; itr != &mEnd; itr = itr->next)
+        removeFromBins(static_cast<SceneObject*>(itr));
+
+    delete mOctree;
+    mOctree = index == LooseOctree ? new ContainerOctree(rootHalfSize, maxDepth) : NULL;
+
+    for (itr = mStart.next; itr != &mEnd; itr = itr->next)
+        insertIntoBins(static_cast<SceneObject*>(itr));
+}
+
+void Container::resetQueryStats()
+{
+    mQueryStats.queries = 0;
+    mQueryStats.cellsVisited = 0;
+    mQueryStats.objectsVisited = 0;
+    mQueryStats.objectsAccepted = 0;
+}
+
+//----------------------------------------------------------------------------
+
 bool Container::addObject(SceneObject* obj)
 {
     AssertFatal(obj->mContainer == NULL, "Adding already added object.");
@@ -940,6 +1103,12 @@ void Container::insertIntoBins(SceneObject* obj)
     AssertFatal(obj != NULL, "No object?");
     AssertFatal(obj->mBinRefHead == NULL, "Error, already have a bin chain!");
 
+    if (mOctree)
+    {
+        insertIntoOctree(obj);
+        return;
+    }
+
     // The first thing we do is find which bins are covered in x and y...
     const Box3F* pWBox = &obj->getWorldBox();
 
@@ -1062,6 +1231,30 @@ void Container::insertIntoBins(SceneObject* obj,
     PROFILE_END();
 }
 
+void Container::insertIntoOctree(SceneObject* obj)
+{
+    // Only ever one ref per object, either in an octree node or the overflow bin.
+    SceneObjectRef* ref = allocateObjectRef();
+    ref->object = obj;
+    ref->nextInObj = NULL;
+    obj->mBinRefHead = ref;
+
+    obj->mOctreeNode = obj->isGlobalBounds() ? NULL : mOctree->findNode(obj->getWorldBox());
+    if (obj->mOctreeNode)
+    {
+        mOctree->insert(obj->mOctreeNode, ref);
+    }
+    else
+    {
+        ref->nextInBin = mOverflowBin.nextInBin;
+        ref->prevInBin = &mOverflowBin;
+
+        if (mOverflowBin.nextInBin)
+            mOverflowBin.nextInBin->prevInBin = ref;
+        mOverflowBin.nextInBin = ref;
+    }
+}
+
 void Container::removeFromBins(SceneObject* obj)
 {
     PROFILE_START(RemoveFromBins);
@@ -1082,6 +1275,12 @@ void Container::removeFromBins(SceneObject* obj)
 
         freeObjectRef(trash);
     }
+
+    if (obj->mOctreeNode)
+    {
+        mOctree->removed(obj->mOctreeNode);
+        obj->mOctreeNode = NULL;
+    }
     PROFILE_END();
 }
 
@@ -1102,6 +1301,19 @@ void Container::checkBins(SceneObject* obj)
     //  the bins that it's currently in...
     const Box3F* pWBox = &obj->getWorldBox();
 
+    if (mOctree)
+    {
+        bool placed = obj->isGlobalBounds() ? obj->mOctreeNode == NULL :
+            mOctree->isPlacedIn(obj->mOctreeNode, *pWBox);
+        if (!placed)
+        {
+            removeFromBins(obj);
+            insertIntoOctree(obj);
+        }
+        PROFILE_END();
+        return;
+    }
+
     U32 minX, maxX, minY, maxY;
     getBinRange(pWBox->min.x, pWBox->max.x, minX, maxX);
     getBinRange(pWBox->min.y, pWBox->max.y, minY, maxY);
@@ -1117,119 +1329,125 @@ void Container::checkBins(SceneObject* obj)
 }
 
 
-void Container::findObjects(const Box3F& box, U32 mask, FindCallback callback, void* key)
+//----------------------------------------------------------------------------
+
+struct OctreeFindInfo
 {
-    PROFILE_START(ContainerFindObjects);
-    U32 minX, maxX, minY, maxY;
-    getBinRange(box.min.x, box.max.x, minX, maxX);
-    getBinRange(box.min.y, box.max.y, minY, maxY);
-    smCurrSeqKey++;
-    for (U32 i = minY; i <= maxY; i++)
-    {
-        U32 insertY = i % csmNumBins;
-        U32 base = insertY * csmNumBins;
-        for (U32 j = minX; j <= maxX; j++)
-        {
-            U32 insertX = j % csmNumBins;
+    Container::QueryStats* stats;
+    const Box3F* box;
+    U32 mask;
+    bool skipHidden;
+    Container::FindCallback callback;
+    void* key;
+};
 
-            SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
-            while (chain)
-            {
-                if (chain->object->getContainerSeqKey() != smCurrSeqKey)
-                {
-                    chain->object->setContainerSeqKey(smCurrSeqKey);
+static void octreeFindCallback(SceneObjectRef* ref, void* key)
+{
+    OctreeFindInfo* info = reinterpret_cast<OctreeFindInfo*>(key);
+    SceneObject* obj = ref->object;
 
-                    if ((chain->object->getType() & mask) != 0 &&
-                        chain->object->isCollisionEnabled() && !chain->object->isHidden())
-                    {
-                        if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
-                        {
-                            (*callback)(chain->object, key);
-                        }
-                    }
-                }
-                chain = chain->nextInBin;
-            }
-        }
-    }
-    SceneObjectRef* chain = mOverflowBin.nextInBin;
-    while (chain)
+    // Objects only live in one node, so no need for the sequence key.  Global
+    //  bounds objects are always in the overflow bin.
+    info->stats->objectsVisited++;
+    if ((obj->getType() & info->mask) != 0 &&
+        obj->isCollisionEnabled() && !(info->skipHidden && obj->isHidden()) &&
+        obj->getWorldBox().isOverlapped(*info->box))
     {
-        if (chain->object->getContainerSeqKey() != smCurrSeqKey)
-        {
-            chain->object->setContainerSeqKey(smCurrSeqKey);
-
-            if ((chain->object->getType() & mask) != 0 &&
-                chain->object->isCollisionEnabled() && !chain->object->isHidden())
-            {
-                if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
-                {
-                    (*callback)(chain->object, key);
-                }
-            }
-        }
-        chain = chain->nextInBin;
+        info->stats->objectsAccepted++;
+        (*info->callback)(obj, info->key);
     }
+}
+
+void Container::findObjects(const Box3F& box, U32 mask, FindCallback callback, void* key)
+{
+    PROFILE_START(ContainerFindObjects);
+    findObjectsInBox(box, mask, true, callback, key);
     PROFILE_END();
 }
 
 
 void Container::polyhedronFindObjects(const Polyhedron& polyhedron, U32 mask, FindCallback callback, void* key)
 {
-    U32 i;
     Box3F box;
     box.min.set(1e9, 1e9, 1e9);
     box.max.set(-1e9, -1e9, -1e9);
-    for (i = 0; i < polyhedron.pointList.size(); i++)
+    for (U32 i = 0; i < polyhedron.pointList.size(); i++)
     {
         box.min.setMin(polyhedron.pointList[i]);
         box.max.setMax(polyhedron.pointList[i]);
     }
 
-    U32 minX, maxX, minY, maxY;
-    getBinRange(box.min.x, box.max.x, minX, maxX);
-    getBinRange(box.min.y, box.max.y, minY, maxY);
+    findObjectsInBox(box, mask, false, callback, key);
+}
+
+
+void Container::findObjectsInBox(const Box3F& box, U32 mask, bool skipHidden, FindCallback callback, void* key)
+{
+    mQueryStats.queries++;
     smCurrSeqKey++;
-    for (i = minY; i <= maxY; i++)
+    if (mOctree)
     {
-        U32 insertY = i % csmNumBins;
-        U32 base = insertY * csmNumBins;
-        for (U32 j = minX; j <= maxX; j++)
+        OctreeFindInfo info;
+        info.stats = &mQueryStats;
+        info.box = &box;
+        info.mask = mask;
+        info.skipHidden = skipHidden;
+        info.callback = callback;
+        info.key = key;
+        mQueryStats.cellsVisited += mOctree->findRefs(box, NULL, NULL, octreeFindCallback, &info);
+    }
+    else
+    {
+        U32 minX, maxX, minY, maxY;
+        getBinRange(box.min.x, box.max.x, minX, maxX);
+        getBinRange(box.min.y, box.max.y, minY, maxY);
+        for (U32 i = minY; i <= maxY; i++)
         {
-            U32 insertX = j % csmNumBins;
-
-            SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
-            while (chain)
+            U32 insertY = i % csmNumBins;
+            U32 base = insertY * csmNumBins;
+            for (U32 j = minX; j <= maxX; j++)
             {
-                if (chain->object->getContainerSeqKey() != smCurrSeqKey)
-                {
-                    chain->object->setContainerSeqKey(smCurrSeqKey);
+                U32 insertX = j % csmNumBins;
 
-                    if ((chain->object->getType() & mask) != 0 &&
-                        chain->object->isCollisionEnabled())
+                mQueryStats.cellsVisited++;
+                SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
+                while (chain)
+                {
+                    mQueryStats.objectsVisited++;
+                    if (chain->object->getContainerSeqKey() != smCurrSeqKey)
                     {
-                        if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
+                        chain->object->setContainerSeqKey(smCurrSeqKey);
+
+                        if ((chain->object->getType() & mask) != 0 &&
+                            chain->object->isCollisionEnabled() && !(skipHidden && chain->object->isHidden()))
                         {
-                            (*callback)(chain->object, key);
+                            if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
+                            {
+                                mQueryStats.objectsAccepted++;
+                                (*callback)(chain->object, key);
+                            }
                         }
                     }
+                    chain = chain->nextInBin;
                 }
-                chain = chain->nextInBin;
             }
         }
     }
+    mQueryStats.cellsVisited++;
     SceneObjectRef* chain = mOverflowBin.nextInBin;
     while (chain)
     {
+        mQueryStats.objectsVisited++;
         if (chain->object->getContainerSeqKey() != smCurrSeqKey)
         {
             chain->object->setContainerSeqKey(smCurrSeqKey);
 
             if ((chain->object->getType() & mask) != 0 &&
-                chain->object->isCollisionEnabled())
+                chain->object->isCollisionEnabled() && !(skipHidden && chain->object->isHidden()))
             {
                 if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
                 {
+                    mQueryStats.objectsAccepted++;
                     (*callback)(chain->object, key);
                 }
             }
@@ -1252,16 +1470,60 @@ void Container::polyhedronFindObjects(const Polyhedron& polyhedron, U32 mask, Fi
 //             rasterizer for anti-aliased lines that will serve better than what
 //             we have below.
 //
+struct OctreeRayInfo
+{
+    Container::QueryStats* stats;
+    Point3F start;
+    Point3F end;
+    U32 mask;
+    RayInfo* info;
+    F32 currentT;
+};
+
+static void octreeRayCallback(SceneObjectRef* ref, void* key)
+{
+    OctreeRayInfo* rayInfo = reinterpret_cast<OctreeRayInfo*>(key);
+    SceneObject* ptr = ref->object;
+
+    rayInfo->stats->objectsVisited++;
+    if ((ptr->getType() & rayInfo->mask) != 0 &&
+        ptr->isCollisionEnabled() == true &&
+        ptr->getWorldBox().collideLine(rayInfo->start, rayInfo->end))
+    {
+        rayInfo->stats->objectsAccepted++;
+
+        Point3F xformedStart, xformedEnd;
+        ptr->getWorldTransform().mulP(rayInfo->start, &xformedStart);
+        ptr->getWorldTransform().mulP(rayInfo->end, &xformedEnd);
+        xformedStart.convolveInverse(ptr->getScale());
+        xformedEnd.convolveInverse(ptr->getScale());
+
+        RayInfo ri;
+        if (ptr->castRay(xformedStart, xformedEnd, &ri))
+        {
+            if (ri.t < rayInfo->currentT)
+            {
+                *rayInfo->info = ri;
+                rayInfo->info->point.interpolate(rayInfo->start, rayInfo->end, ri.t);
+                rayInfo->currentT = ri.t;
+            }
+        }
+    }
+}
+
 bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayInfo* info)
 {
     PROFILE_START(ContainerCastRay);
     F32 currentT = 2.0;
+    mQueryStats.queries++;
     smCurrSeqKey++;
 
+    mQueryStats.cellsVisited++;
     SceneObjectRef* chain = mOverflowBin.nextInBin;
     while (chain)
     {
         SceneObject* ptr = chain->object;
+        mQueryStats.objectsVisited++;
         if (ptr->getContainerSeqKey() != smCurrSeqKey)
         {
             ptr->setContainerSeqKey(smCurrSeqKey);
@@ -1271,6 +1533,7 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
             if ((ptr->getType() & mask) != 0 &&
                 ptr->isCollisionEnabled() == true)
             {
+                mQueryStats.objectsAccepted++;
                 Point3F xformedStart, xformedEnd;
                 ptr->mWorldToObj.mulP(start, &xformedStart);
                 ptr->mWorldToObj.mulP(end, &xformedEnd);
@@ -1325,7 +1588,22 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
        // We'll optimize the case that the line is contained in one bin row or column, which
        //  will be quite a few lines.  No sense doing more work than we have to...
        //
-    if ((mFabs(normalStart.x - normalEnd.x) < csmTotalBinSize && minX == maxX) ||
+    if (mOctree)
+    {
+        // The octree walks the nodes whose loose bounds the line passes through.
+        OctreeRayInfo rayInfo;
+        rayInfo.stats = &mQueryStats;
+        rayInfo.start = start;
+        rayInfo.end = end;
+        rayInfo.mask = mask;
+        rayInfo.info = info;
+        rayInfo.currentT = currentT;
+
+        Box3F lineBox(start, end);
+        mQueryStats.cellsVisited += mOctree->findRefs(lineBox, &start, &end, octreeRayCallback, &rayInfo);
+        currentT = rayInfo.currentT;
+    }
+    else if ((mFabs(normalStart.x - normalEnd.x) < csmTotalBinSize && minX == maxX) ||
         (mFabs(normalStart.y - normalEnd.y) < csmTotalBinSize && minY == maxY))
     {
         U32 count;
@@ -1350,10 +1628,12 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
             U32 checkX = x % csmNumBins;
             U32 checkY = y % csmNumBins;
 
+            mQueryStats.cellsVisited++;
             SceneObjectRef* chain = mBinArray[(checkY * csmNumBins) + checkX].nextInBin;
             while (chain)
             {
                 SceneObject* ptr = chain->object;
+                mQueryStats.objectsVisited++;
                 if (ptr->getContainerSeqKey() != smCurrSeqKey)
                 {
                     ptr->setContainerSeqKey(smCurrSeqKey);
@@ -1363,6 +1643,7 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
                     {
                         if (ptr->getWorldBox().collideLine(start, end) || chain->object->isGlobalBounds())
                         {
+                            mQueryStats.objectsAccepted++;
                             Point3F xformedStart, xformedEnd;
                             ptr->mWorldToObj.mulP(start, &xformedStart);
                             ptr->mWorldToObj.mulP(end, &xformedEnd);
@@ -1435,10 +1716,12 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
                 {
                     U32 checkY = i % csmNumBins;
 
+                    mQueryStats.cellsVisited++;
                     SceneObjectRef* chain = mBinArray[(checkY * csmNumBins) + checkX].nextInBin;
                     while (chain)
                     {
                         SceneObject* ptr = chain->object;
+                        mQueryStats.objectsVisited++;
                         if (ptr->getContainerSeqKey() != smCurrSeqKey)
                         {
                             ptr->setContainerSeqKey(smCurrSeqKey);
@@ -1448,6 +1731,7 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
                             {
                                 if (ptr->getWorldBox().collideLine(start, end))
                                 {
+                                    mQueryStats.objectsAccepted++;
                                     Point3F xformedStart, xformedEnd;
                                     ptr->mWorldToObj.mulP(start, &xformedStart);
                                     ptr->mWorldToObj.mulP(end, &xformedEnd);
@@ -1504,6 +1788,266 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
 
 }
 
+//----------------------------------------------------------------------------
+// Batched ray casts.  Rays are packed four to a packet so that each candidate's
+//  world box is slab tested against the whole packet at once.
+
+struct RayPacket
+{
+    F32 startX[4], startY[4], startZ[4];
+    F32 invDirX[4], invDirY[4], invDirZ[4];
+    F32 maxT[4];   ///< Closest hit so far, 1 for the segment end, -1 for unused lanes
+};
+
+/// Orders the rays of a batch by the bin their midpoint is in.
+struct RaySortKey
+{
+    S32 binX, binY;
+    U32 index;
+};
+
+static int QSORT_CALLBACK cmpRaySortKey(const void* p1, const void* p2)
+{
+    const RaySortKey* key1 = (const RaySortKey*)p1;
+    const RaySortKey* key2 = (const RaySortKey*)p2;
+    if (key1->binY != key2->binY)
+        return key1->binY - key2->binY;
+    if (key1->binX != key2->binX)
+        return key1->binX - key2->binX;
+    return S32(key1->index) - S32(key2->index);
+}
+
+static void rayCandidateCallback(SceneObject* obj, void* key)
+{
+    ((Vector<SceneObject*>*)key)->push_back(obj);
+}
+
+/// A ray joins a group as long as the group's box stays within a bin on each
+///  axis, or within the box the group already covers.
+static bool rayGroupFits(const Box3F& group, const Box3F& grown)
+{
+    return grown.len_x() <= getMax(Container::csmBinSize, group.len_x()) &&
+           grown.len_y() <= getMax(Container::csmBinSize, group.len_y()) &&
+           grown.len_z() <= getMax(Container::csmBinSize, group.len_z());
+}
+
+static inline F32 rayInverse(F32 d)
+{
+    // Axis parallel rays get a huge but finite inverse so the slab math can't
+    //  produce NaNs.
+    if (mFabs(d) < 1e-20f)
+        return d < 0.0f ? -1e30f : 1e30f;
+    return 1.0f / d;
+}
+
+/// Returns a bit per lane of the packet whose ray hits box before its maxT.
+static U32 packetHitsBox(const RayPacket& packet, const Box3F& box)
+{
+#ifdef CONTAINER_SSE_RAYS
+    __m128 t1, t2;
+    __m128 start = _mm_loadu_ps(packet.startX);
+    __m128 inv = _mm_loadu_ps(packet.invDirX);
+    t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.min.x), start), inv);
+    t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.max.x), start), inv);
+    __m128 tNear = _mm_min_ps(t1, t2);
+    __m128 tFar = _mm_max_ps(t1, t2);
+
+    start = _mm_loadu_ps(packet.startY);
+    inv = _mm_loadu_ps(packet.invDirY);
+    t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.min.y), start), inv);
+    t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.max.y), start), inv);
+    tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+    tFar = _mm_min_ps(tFar, _mm_max_ps(t1, t2));
+
+    start = _mm_loadu_ps(packet.startZ);
+    inv = _mm_loadu_ps(packet.invDirZ);
+    t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.min.z), start), inv);
+    t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.max.z), start), inv);
+    tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+    tFar = _mm_min_ps(tFar, _mm_max_ps(t1, t2));
+
+    tNear = _mm_max_ps(tNear, _mm_setzero_ps());
+    tFar = _mm_min_ps(tFar, _mm_loadu_ps(packet.maxT));
+    return U32(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar)));
+#else
+    U32 hits = 0;
+    for (U32 i = 0; i < 4; i++)
+    {
+        F32 t1 = (box.min.x - packet.startX[i]) * packet.invDirX[i];
+        F32 t2 = (box.max.x - packet.startX[i]) * packet.invDirX[i];
+        F32 tNear = getMin(t1, t2);
+        F32 tFar = getMax(t1, t2);
+
+        t1 = (box.min.y - packet.startY[i]) * packet.invDirY[i];
+        t2 = (box.max.y - packet.startY[i]) * packet.invDirY[i];
+        tNear = getMax(tNear, getMin(t1, t2));
+        tFar = getMin(tFar, getMax(t1, t2));
+
+        t1 = (box.min.z - packet.startZ[i]) * packet.invDirZ[i];
+        t2 = (box.max.z - packet.startZ[i]) * packet.invDirZ[i];
+        tNear = getMax(tNear, getMin(t1, t2));
+        tFar = getMin(tFar, getMax(t1, t2));
+
+        if (getMax(tNear, 0.0f) <= getMin(tFar, packet.maxT[i]))
+            hits |= 1 << i;
+    }
+    return hits;
+#endif
+}
+
+U32 Container::castRays(RayQuery* rays, U32 count, U32 mask)
+{
+    if (count == 0)
+        return 0;
+
+    PROFILE_START(ContainerCastRays);
+
+    // Sort the rays so that nearby rays are next to each other, then walk the
+    //  database once per group of nearby rays.  One box around rays spread
+    //  across the level would turn into a scan of the whole level.
+    U32 i;
+    Vector<RaySortKey> order;
+    order.setSize(count);
+    for (i = 0; i < count; i++)
+    {
+        rays[i].hit = false;
+        Point3F mid = (rays[i].start + rays[i].end) * 0.5f;
+        order[i].binX = S32(mFloor(mid.x / csmBinSize));
+        order[i].binY = S32(mFloor(mid.y / csmBinSize));
+        order[i].index = i;
+    }
+    dQsort(order.address(), count, sizeof(RaySortKey), cmpRaySortKey);
+
+    Vector<SceneObject*> candidates;
+    Vector<RayPacket> packets;
+    U32 first = 0;
+    while (first < count)
+    {
+        // Grow the group while the rays stay close together.  Like castRay,
+        //  hidden objects are fair game.
+        Box3F bounds;
+        bounds.min = bounds.max = rays[order[first].index].start;
+        bounds.min.setMin(rays[order[first].index].end);
+        bounds.max.setMax(rays[order[first].index].end);
+
+        U32 last;
+        for (last = first + 1; last < count; last++)
+        {
+            const RayQuery& ray = rays[order[last].index];
+            Box3F grown = bounds;
+            grown.min.setMin(ray.start);
+            grown.min.setMin(ray.end);
+            grown.max.setMax(ray.start);
+            grown.max.setMax(ray.end);
+            if (!rayGroupFits(bounds, grown))
+                break;
+            bounds = grown;
+        }
+
+        U32 groupSize = last - first;
+        const RaySortKey* group = &order[first];
+        first = last;
+
+        candidates.clear();
+        findObjectsInBox(bounds, mask, false, rayCandidateCallback, &candidates);
+        if (candidates.empty())
+            continue;
+
+        U32 numPackets = (groupSize + 3) >> 2;
+        packets.setSize(numPackets);
+        for (i = 0; i < numPackets * 4; i++)
+        {
+            RayPacket& packet = packets[i >> 2];
+            U32 lane = i & 3;
+            if (i < groupSize)
+            {
+                const RayQuery& ray = rays[group[i].index];
+                VectorF dir = ray.end - ray.start;
+                packet.startX[lane] = ray.start.x;
+                packet.startY[lane] = ray.start.y;
+                packet.startZ[lane] = ray.start.z;
+                packet.invDirX[lane] = rayInverse(dir.x);
+                packet.invDirY[lane] = rayInverse(dir.y);
+                packet.invDirZ[lane] = rayInverse(dir.z);
+                packet.maxT[lane] = 1.0f;
+            }
+            else
+            {
+                packet.startX[lane] = packet.startY[lane] = packet.startZ[lane] = 0.0f;
+                packet.invDirX[lane] = packet.invDirY[lane] = packet.invDirZ[lane] = 1.0f;
+                packet.maxT[lane] = -1.0f;
+            }
+        }
+
+        for (S32 c = 0; c < candidates.size(); c++)
+        {
+            SceneObject* ptr = candidates[c];
+            const Box3F& box = ptr->getWorldBox();
+            bool globalBounds = ptr->isGlobalBounds();
+
+            for (U32 p = 0; p < numPackets; p++)
+            {
+                RayPacket& packet = packets[p];
+                U32 hits;
+                if (globalBounds)
+                    hits = (p == numPackets - 1 && (groupSize & 3)) ? (1 << (groupSize & 3)) - 1 : 0xF;
+                else
+                    hits = packetHitsBox(packet, box);
+
+                for (U32 lane = 0; hits; lane++, hits >>= 1)
+                {
+                    if ((hits & 1) == 0)
+                        continue;
+
+                    RayQuery& ray = rays[group[(p << 2) + lane].index];
+                    mQueryStats.objectsAccepted++;
+
+                    Point3F xformedStart, xformedEnd;
+                    ptr->mWorldToObj.mulP(ray.start, &xformedStart);
+                    ptr->mWorldToObj.mulP(ray.end, &xformedEnd);
+                    xformedStart.convolveInverse(ptr->mObjScale);
+                    xformedEnd.convolveInverse(ptr->mObjScale);
+
+                    RayInfo ri;
+                    if (ptr->castRay(xformedStart, xformedEnd, &ri))
+                    {
+                        if (!ray.hit || ri.t < ray.info.t)
+                        {
+                            ray.hit = true;
+                            ray.info = ri;
+                            ray.info.point.interpolate(ray.start, ray.end, ri.t);
+                            packet.maxT[lane] = ri.t;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Bump the normals into worldspace, same as castRay.
+    U32 numHits = 0;
+    for (i = 0; i < count; i++)
+    {
+        if (!rays[i].hit)
+            continue;
+
+        RayInfo& info = rays[i].info;
+        PlaneF fakePlane;
+        fakePlane.x = info.normal.x;
+        fakePlane.y = info.normal.y;
+        fakePlane.z = info.normal.z;
+        fakePlane.d = 0;
+
+        PlaneF result;
+        mTransformPlane(info.object->getTransform(), info.object->getScale(), fakePlane, &result);
+        info.normal = result;
+        numHits++;
+    }
+
+    PROFILE_END();
+    return numHits;
+}
+
 // collide with the objects projected object box
 bool Container::collideBox(const Point3F& start, const Point3F& end, U32 mask, RayInfo* info)
 {
@@ -48,6 +48,8 @@ class LightManager;
 class Convex;
 class RenderInst;
 class Material;
+class ContainerOctree;
+struct ContainerOctreeNode;
 
 //----------------------------------------------------------------------------
 /// Extension of the collision structore to allow use with raycasting.
@@ -124,6 +126,31 @@ public:
     static const U32 csmRefPoolBlockSize;
     static U32    smCurrSeqKey;
 
+    /// Spatial structure used to find candidate objects for queries.
+    enum SpatialIndex
+    {
+        BinGrid,       ///< Fixed 16x16 grid of bins that wraps around in x and y
+        LooseOctree,   ///< Loose octree, see ContainerOctree
+    };
+
+    /// Counters for tuning the spatial index.
+    struct QueryStats
+    {
+        U32 queries;          ///< findObjects/polyhedronFindObjects/castRay calls
+        U32 cellsVisited;     ///< Bins or octree nodes walked
+        U32 objectsVisited;   ///< Object refs walked, including duplicates across bins
+        U32 objectsAccepted;  ///< Objects passed on to a callback or ray test
+    };
+
+    /// One ray of a castRays() batch.
+    struct RayQuery
+    {
+        Point3F start;
+        Point3F end;
+        bool    hit;    ///< Set by castRays, info is only valid if true
+        RayInfo info;
+    };
+
 private:
     Link mStart, mEnd;
 
@@ -133,10 +160,28 @@ private:
     SceneObjectRef* mBinArray;
     SceneObjectRef  mOverflowBin;
 
+    ContainerOctree* mOctree;   ///< Non-NULL when using the LooseOctree index
+    QueryStats       mQueryStats;
+
+    void insertIntoOctree(SceneObject*);
+
 public:
     Container();
     ~Container();
 
+    /// @name Spatial index
+    /// @{
+
+    /// Switch to a different spatial index, rebinning all objects.  The octree
+    /// root is centered on the origin; rootHalfSize and maxDepth are ignored for
+    /// the grid.
+    void setSpatialIndex(SpatialIndex index, F32 rootHalfSize = 4096.0f, U32 maxDepth = 8);
+    SpatialIndex getSpatialIndex() const { return mOctree ? LooseOctree : BinGrid; }
+
+    const QueryStats& getQueryStats() const { return mQueryStats; }
+    void resetQueryStats();
+    /// @}
+
     /// @name Basic database operations
     /// @{
 
@@ -148,11 +193,23 @@ public:
         FindCallback, void* key = NULL);
     /// @}
 
+private:
+    void findObjectsInBox(const Box3F& box, U32 mask, bool skipHidden, FindCallback, void* key);
+
+public:
+
     /// @name Line intersection
     /// @{
 
     ///
     bool castRay(const Point3F& start, const Point3F& end, U32 mask, RayInfo* info);
+
+    /// Same results as calling castRay on each ray, but rays are sorted into
+    /// groups of nearby rays, the database is walked once per group and object
+    /// boxes are tested against four rays at a time.
+    ///
+    /// @returns Number of rays that hit something.
+    U32  castRays(RayQuery* rays, U32 count, U32 mask);
     bool collideBox(const Point3F& start, const Point3F& end, U32 mask, RayInfo* info);
     /// @}
 
@@ -744,6 +801,8 @@ protected:
     U32 mBinMinY;
     U32 mBinMaxY;
 
+    ContainerOctreeNode* mOctreeNode;   ///< Node holding mBinRefHead when the container uses an octree
+
     /// @}
 
     /// @name Container Interface
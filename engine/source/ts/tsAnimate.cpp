@@ -4,6 +4,8 @@
 //-----------------------------------------------------------------------------
 
 #include "ts/tsShapeInstance.h"
+#include "core/threadPool.h"
+#include "platform/profiler.h"
 
 //----------------------------------------------------------------------------------
 // some utility functions
@@ -45,10 +47,10 @@ void TSShapeInstance::animateNodes(S32 ss)
         return;
 
     // temporary storage for node transforms
-    smNodeCurrentRotations.setSize(mShape->nodes.size());
-    smNodeCurrentTranslations.setSize(mShape->nodes.size());
-    smRotationThreads.setSize(mShape->nodes.size());
-    smTranslationThreads.setSize(mShape->nodes.size());
+    mNodeCurrentRotations.setSize(mShape->nodes.size());
+    mNodeCurrentTranslations.setSize(mShape->nodes.size());
+    mRotationThreads.setSize(mShape->nodes.size());
+    mTranslationThreads.setSize(mShape->nodes.size());
 
     TSIntegerSet rotBeenSet;
     TSIntegerSet tranBeenSet;
@@ -94,13 +96,13 @@ void TSShapeInstance::animateNodes(S32 ss)
     {
         if (rotBeenSet.test(i))
         {
-            mShape->defaultRotations[i].getQuatF(&smNodeCurrentRotations[i]);
-            smRotationThreads[i] = NULL;
+            mShape->defaultRotations[i].getQuatF(&mNodeCurrentRotations[i]);
+            mRotationThreads[i] = NULL;
         }
         if (tranBeenSet.test(i))
         {
-            smNodeCurrentTranslations[i] = mShape->defaultTranslations[i];
-            smTranslationThreads[i] = NULL;
+            mNodeCurrentTranslations[i] = mShape->defaultTranslations[i];
+            mTranslationThreads[i] = NULL;
         }
     }
 
@@ -133,9 +135,9 @@ void TSShapeInstance::animateNodes(S32 ss)
                 QuatF q1, q2;
                 mShape->getRotation(*th->sequence, th->keyNum1, j, &q1);
                 mShape->getRotation(*th->sequence, th->keyNum2, j, &q2);
-                TSTransform::interpolate(q1, q2, th->keyPos, &smNodeCurrentRotations[nodeIndex]);
+                TSTransform::interpolate(q1, q2, th->keyPos, &mNodeCurrentRotations[nodeIndex]);
                 rotBeenSet.set(nodeIndex);
-                smRotationThreads[nodeIndex] = th;
+                mRotationThreads[nodeIndex] = th;
             }
         }
 
@@ -154,8 +156,8 @@ void TSShapeInstance::animateNodes(S32 ss)
                 {
                     const Point3F& p1 = mShape->getTranslation(*th->sequence, th->keyNum1, j);
                     const Point3F& p2 = mShape->getTranslation(*th->sequence, th->keyNum2, j);
-                    TSTransform::interpolate(p1, p2, th->keyPos, &smNodeCurrentTranslations[nodeIndex]);
-                    smTranslationThreads[nodeIndex] = th;
+                    TSTransform::interpolate(p1, p2, th->keyPos, &mNodeCurrentTranslations[nodeIndex]);
+                    mTranslationThreads[nodeIndex] = th;
                 }
                 tranBeenSet.set(nodeIndex);
             }
@@ -172,7 +174,7 @@ void TSShapeInstance::animateNodes(S32 ss)
     // compute transforms
     for (i = a; i < b; i++)
         if (!mHandsOffNodes.test(i))
-            TSTransform::setMatrix(smNodeCurrentRotations[i], smNodeCurrentTranslations[i], &mNodeTransforms[i]);
+            TSTransform::setMatrix(mNodeCurrentRotations[i], mNodeCurrentTranslations[i], &mNodeTransforms[i]);
 
     // add scale onto transforms
     if (scaleCurrentlyAnimated())
@@ -211,37 +213,37 @@ void TSShapeInstance::handleDefaultScale(S32 a, S32 b, TSIntegerSet& scaleBeenSe
     // set default scale values (i.e., identity) and do any initialization
     // relating to animated scale (since scale normally not animated)
 
-    smScaleThreads.setSize(mShape->nodes.size());
+    mScaleThreads.setSize(mShape->nodes.size());
     scaleBeenSet.takeAway(mCallbackNodes);
     scaleBeenSet.takeAway(mHandsOffNodes);
     if (animatesUniformScale())
     {
-        smNodeCurrentUniformScales.setSize(mShape->nodes.size());
+        mNodeCurrentUniformScales.setSize(mShape->nodes.size());
         for (S32 i = a; i < b; i++)
             if (scaleBeenSet.test(i))
             {
-                smNodeCurrentUniformScales[i] = 1.0f;
-                smScaleThreads[i] = NULL;
+                mNodeCurrentUniformScales[i] = 1.0f;
+                mScaleThreads[i] = NULL;
             }
     }
     else if (animatesAlignedScale())
     {
-        smNodeCurrentAlignedScales.setSize(mShape->nodes.size());
+        mNodeCurrentAlignedScales.setSize(mShape->nodes.size());
         for (S32 i = a; i < b; i++)
             if (scaleBeenSet.test(i))
             {
-                smNodeCurrentAlignedScales[i].set(1.0f, 1.0f, 1.0f);
-                smScaleThreads[i] = NULL;
+                mNodeCurrentAlignedScales[i].set(1.0f, 1.0f, 1.0f);
+                mScaleThreads[i] = NULL;
             }
     }
     else
     {
-        smNodeCurrentArbitraryScales.setSize(mShape->nodes.size());
+        mNodeCurrentArbitraryScales.setSize(mShape->nodes.size());
         for (S32 i = a; i < b; i++)
             if (scaleBeenSet.test(i))
             {
-                smNodeCurrentArbitraryScales[i].identity();
-                smScaleThreads[i] = NULL;
+                mNodeCurrentArbitraryScales[i].identity();
+                mScaleThreads[i] = NULL;
             }
     }
 
@@ -259,7 +261,7 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
     {
         if (nodeIndex < a)
             continue;
-        TSThread* thread = smRotationThreads[nodeIndex];
+        TSThread* thread = mRotationThreads[nodeIndex];
         thread = thread && thread->transitionData.inTransition ? thread : NULL;
         if (!thread)
         {
@@ -277,7 +279,7 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
             AssertFatal(thread != NULL, "TSShapeInstance::handleRotTransitionNodes (rotation)");
         }
         QuatF tmpQ;
-        TSTransform::interpolate(mNodeReferenceRotations[nodeIndex].getQuatF(&tmpQ), smNodeCurrentRotations[nodeIndex], thread->transitionData.pos, &smNodeCurrentRotations[nodeIndex]);
+        TSTransform::interpolate(mNodeReferenceRotations[nodeIndex].getQuatF(&tmpQ), mNodeCurrentRotations[nodeIndex], thread->transitionData.pos, &mNodeCurrentRotations[nodeIndex]);
     }
 
     // then translation
@@ -285,7 +287,7 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
     end = b;
     for (nodeIndex = start; nodeIndex < end; mTransitionTranslationNodes.next(nodeIndex))
     {
-        TSThread* thread = smTranslationThreads[nodeIndex];
+        TSThread* thread = mTranslationThreads[nodeIndex];
         thread = thread && thread->transitionData.inTransition ? thread : NULL;
         if (!thread)
         {
@@ -302,7 +304,7 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
             }
             AssertFatal(thread != NULL, "TSShapeInstance::handleTransitionNodes (translation).");
         }
-        Point3F& p = smNodeCurrentTranslations[nodeIndex];
+        Point3F& p = mNodeCurrentTranslations[nodeIndex];
         Point3F& p1 = mNodeReferenceTranslations[nodeIndex];
         Point3F& p2 = p;
         F32 k = thread->transitionData.pos;
@@ -318,7 +320,7 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
         end = b;
         for (nodeIndex = start; nodeIndex < end; mTransitionScaleNodes.next(nodeIndex))
         {
-            TSThread* thread = smScaleThreads[nodeIndex];
+            TSThread* thread = mScaleThreads[nodeIndex];
             thread = thread && thread->transitionData.inTransition ? thread : NULL;
             if (!thread)
             {
@@ -336,14 +338,14 @@ void TSShapeInstance::handleTransitionNodes(S32 a, S32 b)
                 AssertFatal(thread != NULL, "TSShapeInstance::handleTransitionNodes (scale).");
             }
             if (animatesUniformScale())
-                smNodeCurrentUniformScales[nodeIndex] += thread->transitionData.pos * (mNodeReferenceUniformScales[nodeIndex] - smNodeCurrentUniformScales[nodeIndex]);
+                mNodeCurrentUniformScales[nodeIndex] += thread->transitionData.pos * (mNodeReferenceUniformScales[nodeIndex] - mNodeCurrentUniformScales[nodeIndex]);
             else if (animatesAlignedScale())
-                TSTransform::interpolate(mNodeReferenceScaleFactors[nodeIndex], smNodeCurrentAlignedScales[nodeIndex], thread->transitionData.pos, &smNodeCurrentAlignedScales[nodeIndex]);
+                TSTransform::interpolate(mNodeReferenceScaleFactors[nodeIndex], mNodeCurrentAlignedScales[nodeIndex], thread->transitionData.pos, &mNodeCurrentAlignedScales[nodeIndex]);
             else
             {
                 QuatF q;
-                TSTransform::interpolate(mNodeReferenceScaleFactors[nodeIndex], smNodeCurrentArbitraryScales[nodeIndex].mScale, thread->transitionData.pos, &smNodeCurrentArbitraryScales[nodeIndex].mScale);
-                TSTransform::interpolate(mNodeReferenceArbitraryScaleRots[nodeIndex].getQuatF(&q), smNodeCurrentArbitraryScales[nodeIndex].mRotate, thread->transitionData.pos, &smNodeCurrentArbitraryScales[nodeIndex].mRotate);
+                TSTransform::interpolate(mNodeReferenceScaleFactors[nodeIndex], mNodeCurrentArbitraryScales[nodeIndex].mScale, thread->transitionData.pos, &mNodeCurrentArbitraryScales[nodeIndex].mScale);
+                TSTransform::interpolate(mNodeReferenceArbitraryScaleRots[nodeIndex].getQuatF(&q), mNodeCurrentArbitraryScales[nodeIndex].mRotate, thread->transitionData.pos, &mNodeCurrentArbitraryScales[nodeIndex].mRotate);
             }
         }
     }
@@ -355,19 +357,19 @@ void TSShapeInstance::handleNodeScale(S32 a, S32 b)
     {
         for (S32 i = a; i < b; i++)
             if (!mHandsOffNodes.test(i))
-                TSTransform::applyScale(smNodeCurrentUniformScales[i], &mNodeTransforms[i]);
+                TSTransform::applyScale(mNodeCurrentUniformScales[i], &mNodeTransforms[i]);
     }
     else if (animatesAlignedScale())
     {
         for (S32 i = a; i < b; i++)
             if (!mHandsOffNodes.test(i))
-                TSTransform::applyScale(smNodeCurrentAlignedScales[i], &mNodeTransforms[i]);
+                TSTransform::applyScale(mNodeCurrentAlignedScales[i], &mNodeTransforms[i]);
     }
     else
     {
         for (S32 i = a; i < b; i++)
             if (!mHandsOffNodes.test(i))
-                TSTransform::applyScale(smNodeCurrentArbitraryScales[i], &mNodeTransforms[i]);
+                TSTransform::applyScale(mNodeCurrentArbitraryScales[i], &mNodeTransforms[i]);
     }
 }
 
@@ -436,28 +438,28 @@ void TSShapeInstance::handleAnimatedScale(TSThread* thread, S32 a, S32 b, TSInte
             {
             case 0: // uniform -> uniform
             {
-                smNodeCurrentUniformScales[nodeIndex] = uniformScale;
+                mNodeCurrentUniformScales[nodeIndex] = uniformScale;
                 break;
             }
             case 1: // uniform -> aligned
             case 4: // aligned -> aligned
-                smNodeCurrentAlignedScales[nodeIndex] = alignedScale;
+                mNodeCurrentAlignedScales[nodeIndex] = alignedScale;
                 break;
             case 2: // uniform -> arbitrary
             case 5: // aligned -> arbitrary
             {
-                smNodeCurrentArbitraryScales[nodeIndex].identity();
-                smNodeCurrentArbitraryScales[nodeIndex].mScale = alignedScale;
+                mNodeCurrentArbitraryScales[nodeIndex].identity();
+                mNodeCurrentArbitraryScales[nodeIndex].mScale = alignedScale;
                 break;
             }
             case 8: // arbitrary -> arbitary
             {
-                smNodeCurrentArbitraryScales[nodeIndex] = arbitraryScale;
+                mNodeCurrentArbitraryScales[nodeIndex] = arbitraryScale;
                 break;
             }
             default: AssertFatal(0, "TSShapeInstance::handleAnimatedScale"); break;
             }
-            smScaleThreads[nodeIndex] = thread;
+            mScaleThreads[nodeIndex] = thread;
             scaleBeenSet.set(nodeIndex);
         }
     }
@@ -471,13 +473,13 @@ void TSShapeInstance::handleMaskedPositionNode(TSThread* th, S32 nodeIndex, S32
     TSTransform::interpolate(p1, p2, th->keyPos, &p);
 
     if (!mMaskPosXNodes.test(nodeIndex))
-        smNodeCurrentTranslations[nodeIndex].x = p.x;
+        mNodeCurrentTranslations[nodeIndex].x = p.x;
 
     if (!mMaskPosYNodes.test(nodeIndex))
-        smNodeCurrentTranslations[nodeIndex].y = p.y;
+        mNodeCurrentTranslations[nodeIndex].y = p.y;
 
     if (!mMaskPosZNodes.test(nodeIndex))
-        smNodeCurrentTranslations[nodeIndex].z = p.z;
+        mNodeCurrentTranslations[nodeIndex].z = p.z;
 }
 
 void TSShapeInstance::handleBlendSequence(TSThread* thread, S32 a, S32 b)
@@ -907,6 +909,94 @@ void TSShapeInstance::animateSubtrees(bool forceFull)
     }
 }
 
+//-------------------------------------------------------------------------------------
+// Parallel animation
+//-------------------------------------------------------------------------------------
+
+void TSShapeInstance::queueAnimate()
+{
+    if (mAnimateQueueIndex != -1)
+        return;
+
+    mAnimateQueueIndex = smAnimateQueue.size();
+    smAnimateQueue.push_back(this);
+}
+
+void TSShapeInstance::updateSkinCaches(bool buildOnly)
+{
+    S32 dl = mCurrentDetailLevel;
+    if (dl < 0 || dl >= S32(mShape->details.size()))
+        return;
+
+    S32 ss = mShape->details[dl].subShapeNum;
+    S32 od = mShape->details[dl].objectDetailNum;
+    if (ss < 0)
+        return;
+
+    S32 start = mShape->subShapeFirstObject[ss];
+    S32 end = start + mShape->subShapeNumObjects[ss];
+    for (S32 i = start; i < end; i++)
+    {
+        MeshObjectInstance& meshObj = mMeshObjects[i];
+        TSMesh* mesh = meshObj.getMesh(od);
+        if (!mesh || mesh->getMeshType() != TSMesh::SkinMeshType)
+            continue;
+
+        TSSkinMesh* skin = (TSSkinMesh*)mesh;
+        if (buildOnly)
+        {
+            if (!skin->mSkinBatchBuilt)
+                skin->buildSkinBatch();
+        }
+        else if (meshObj.visible > 0.01f)
+            skin->updateSkinCache(&meshObj.mSkinCache, mNodeTransforms.address());
+    }
+}
+
+void TSShapeInstance::animateQueuedWork(void* data, U32 index)
+{
+    TSShapeInstance* inst = reinterpret_cast<TSShapeInstance**>(data)[index];
+    inst->animate();
+    inst->updateSkinCaches(false);
+}
+
+void TSShapeInstance::animateQueued()
+{
+    if (smAnimateQueue.empty())
+        return;
+
+    PROFILE_START(TSAnimateQueued);
+
+    if (smAnimatePool && smAnimatePool->getNumThreads() != (U32)getMax(smAnimateThreads, 0))
+    {
+        delete smAnimatePool;
+        smAnimatePool = NULL;
+    }
+    if (!smAnimatePool)
+        smAnimatePool = new ThreadPool(getMax(smAnimateThreads, 0));
+
+    // Node callbacks go back into game code, so those instances stay on this
+    // thread.  Skin batches are shared by every instance of a shape and
+    // built on first use, so build them before fanning out.
+    Vector<TSShapeInstance*> parallel;
+    for (S32 i = 0; i < smAnimateQueue.size(); i++)
+    {
+        TSShapeInstance* inst = smAnimateQueue[i];
+        inst->mAnimateQueueIndex = -1;
+        inst->updateSkinCaches(true);
+
+        if (inst->mCallback)
+            animateQueuedWork(&inst, 0);
+        else
+            parallel.push_back(inst);
+    }
+    smAnimateQueue.clear();
+
+    smAnimatePool->parallelFor(animateQueuedWork, parallel.address(), parallel.size());
+
+    PROFILE_END();
+}
+
 void TSShapeInstance::addPath(TSThread* gt, F32 start, F32 end, MatrixF* mat)
 {
     // never get here while in transition...
@@ -24,6 +24,11 @@
 #include "game/game.h"
 #include "lightingSystem/sgLightingModel.h"
 
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+#include <xmmintrin.h>
+#define TS_SSE_SKINNING
+#endif
+
 // Not worth the effort, much less the effort to comment, but if the draw types
 // are consecutive use addition rather than a table to go from index to command value...
 /*
@@ -2322,104 +2327,274 @@ GFXVertexBufferHandle<MeshVertex>& TSSkinMesh::getVertexBuffer()
     return TSShapeInstance::smRenderData.currentObjectInstance->mVB;
 }
 
+bool TSSkinMesh::smUseSSE = true;
+
+// Skinning scratch for meshes skinned outside of a shape instance.  Main
+// thread only.
 Vector<MatrixF> gBoneTransforms;
-Vector<Point3F> gSkinVerts;
-Vector<Point3F> gSkinNorms;
 
-void TSSkinMesh::updateSkin()
+void TSSkinMesh::buildSkinBatch()
 {
-    if (smGlowPass || smRefractPass)
+    // Influences come grouped by vertex; turn each group into a run.
+    mRunVertex.clear();
+    mRunInfluences.clear();
+    mRunInitialVerts.clear();
+    mRunInitialNorms.clear();
+    mInfluenceBone.setSize(vertexIndex.size());
+    mInfluenceWeight.setSize(vertexIndex.size());
+
+    S32 prevIndex = -1;
+    for (U32 i = 0; i < vertexIndex.size(); i++)
     {
-        return;
+        S32 vIndex = vertexIndex[i];
+        if (vIndex != prevIndex)
+        {
+            const Point3F& v = initialVerts[vIndex];
+            Point3F n = encodedNorms.size() ? decodeNormal(encodedNorms[vIndex]) : initialNorms[vIndex];
+
+            mRunVertex.push_back(vIndex);
+            mRunInfluences.push_back(0);
+            mRunInitialVerts.push_back(Point4F(v.x, v.y, v.z, 1.0f));
+            mRunInitialNorms.push_back(Point4F(n.x, n.y, n.z, 0.0f));
+            prevIndex = vIndex;
+        }
+
+        mRunInfluences.last()++;
+        mInfluenceBone[i] = boneIndex[i];
+        mInfluenceWeight[i] = weight[i];
     }
 
-    PROFILE_START(UpdateSkin);
+    mSkinBatchBuilt = true;
+}
 
-    // set arrays
-    gBoneTransforms.setSize(nodeIndex.size());
-#if defined(TORQUE_MAX_LIB)
-    verts.setSize(initialVerts.size());
-    norms.setSize(initialVerts.size());
-#else
-    if (encodedNorms.size())
+#ifdef TS_SSE_SKINNING
+/// Skin all runs with SSE. boneCols holds each bone transform transposed, so
+/// every matrix column is one aligned-or-not load.
+static void skinRunsSSE(const MatrixF* boneCols, U32 numRuns, const S32* runVertex, const U32* runInfluences,
+    const Point4F* initialVerts, const Point4F* initialNorms, const U32* bone, const F32* weight,
+    Point3F* outVerts, Point3F* outNorms)
+{
+    for (U32 r = 0; r < numRuns; r++)
     {
-        // we co-opt responsibility for updating encoded normals from mesh
-        gNormalStore.setSize(vertsPerFrame);
-        for (S32 i = 0; i < vertsPerFrame; i++)
-            gNormalStore[i] = decodeNormal(encodedNorms[i]);
-        initialNorms.set(gNormalStore.address(), vertsPerFrame);
-    }
-    gSkinVerts.setSize(initialVerts.size());
-    gSkinNorms.setSize(initialNorms.size());
-    verts.set(gSkinVerts.address(), gSkinVerts.size());
-    norms.set(gSkinNorms.address(), gSkinNorms.size());
+        __m128 p = _mm_loadu_ps(&initialVerts[r].x);
+        __m128 n = _mm_loadu_ps(&initialNorms[r].x);
+        __m128 px = _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 py = _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 pz = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2));
+        __m128 nx = _mm_shuffle_ps(n, n, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 ny = _mm_shuffle_ps(n, n, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 nz = _mm_shuffle_ps(n, n, _MM_SHUFFLE(2, 2, 2, 2));
+
+        __m128 accP = _mm_setzero_ps();
+        __m128 accN = _mm_setzero_ps();
+
+        for (U32 count = runInfluences[r]; count; count--, bone++, weight++)
+        {
+            const F32* m = (const F32*)boneCols[*bone];
+            __m128 c0 = _mm_loadu_ps(m);
+            __m128 c1 = _mm_loadu_ps(m + 4);
+            __m128 c2 = _mm_loadu_ps(m + 8);
+            __m128 c3 = _mm_loadu_ps(m + 12);
+            __m128 w = _mm_set1_ps(*weight);
+
+            __m128 tp = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, px), _mm_mul_ps(c1, py)),
+                _mm_add_ps(_mm_mul_ps(c2, pz), c3));
+            __m128 tn = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, nx), _mm_mul_ps(c1, ny)),
+                _mm_mul_ps(c2, nz));
+
+            accP = _mm_add_ps(accP, _mm_mul_ps(tp, w));
+            accN = _mm_add_ps(accN, _mm_mul_ps(tn, w));
+        }
+
+        // Point3F is only 12 bytes, so store xy and z separately.
+        Point3F& v = outVerts[runVertex[r]];
+        Point3F& vn = outNorms[runVertex[r]];
+        _mm_storel_pi((__m64*)&v.x, accP);
+        _mm_store_ss(&v.z, _mm_movehl_ps(accP, accP));
+        _mm_storel_pi((__m64*)&vn.x, accN);
+        _mm_store_ss(&vn.z, _mm_movehl_ps(accN, accN));
+    }
+}
 #endif
 
-    //if (!initialTangents.size())
-    //{
-    //    dMemcpy(verts.address(), initialVerts.address(), sizeof(Point3F) * verts.size());
-    //    dMemcpy(norms.address(), initialNorms.address(), sizeof(Point3F) * norms.size());
-    //    createTangents();
-    //}
+void TSSkinMesh::skinVerts(const MatrixF* nodeTransforms, Vector<MatrixF>& boneTransforms,
+    Point3F* outVerts, Point3F* outNorms)
+{
+    if (!mSkinBatchBuilt)
+        buildSkinBatch();
 
     // set up bone transforms
+    boneTransforms.setSize(nodeIndex.size());
     S32 i;
     for (i = 0; i < nodeIndex.size(); i++)
+        boneTransforms[i].mul(nodeTransforms[nodeIndex[i]], initialTransforms[i]);
+
+    const U32* bone = mInfluenceBone.address();
+    const F32* weight = mInfluenceWeight.address();
+
+#ifdef TS_SSE_SKINNING
+    if (smUseSSE)
     {
-        S32 node = nodeIndex[i];
-        gBoneTransforms[i].mul(TSShapeInstance::ObjectInstance::smTransforms[node], initialTransforms[i]);
-    }
+        for (i = 0; i < boneTransforms.size(); i++)
+            boneTransforms[i].transpose();
 
-    // multiply verts and normals by boneTransforms
-    S32 prevIndex = -1;
-    for (i = 0; i < vertexIndex.size(); i++)
+        skinRunsSSE(boneTransforms.address(), mRunVertex.size(), mRunVertex.address(), mRunInfluences.address(),
+            mRunInitialVerts.address(), mRunInitialNorms.address(), bone, weight, outVerts, outNorms);
+    }
+    else
+#endif
     {
-        Point3F v0, n0, t0;
-        S32 vIndex = vertexIndex[i];
-        MatrixF& deltaTransform = gBoneTransforms[boneIndex[i]];
-        deltaTransform.mulP(initialVerts[vIndex], &v0);
-        deltaTransform.mulV(initialNorms[vIndex], &n0);
-        deltaTransform.mulV(initialTangents[vIndex], &t0);
-        v0 *= weight[i];
-        n0 *= weight[i];
-        t0 *= weight[i];
-        Point3F& v = verts[vIndex];
-        Point3F& n = norms[vIndex];
-        Point3F& t = (Point3F&)tangents[vIndex];
-        // this should be implemented as a series of conditional moves to avoid the branch
-        if (vIndex != prevIndex)
+        // multiply verts and normals by boneTransforms
+        for (S32 r = 0; r < mRunVertex.size(); r++)
         {
-            v.x = 0.0f;
-            v.y = 0.0f;
-            v.z = 0.0f;
-            n.x = 0.0f;
-            n.y = 0.0f;
-            n.z = 0.0f;
-            t.x = 0.0f;
-            t.y = 0.0f;
-            t.z = 0.0f;
+            const Point4F& iv = mRunInitialVerts[r];
+            const Point4F& in = mRunInitialNorms[r];
+            Point3F initialVert(iv.x, iv.y, iv.z);
+            Point3F initialNorm(in.x, in.y, in.z);
+
+            Point3F v(0.0f, 0.0f, 0.0f);
+            Point3F n(0.0f, 0.0f, 0.0f);
+            for (U32 count = mRunInfluences[r]; count; count--, bone++, weight++)
+            {
+                Point3F v0, n0;
+                const MatrixF& deltaTransform = boneTransforms[*bone];
+                deltaTransform.mulP(initialVert, &v0);
+                deltaTransform.mulV(initialNorm, &n0);
+                v += v0 * *weight;
+                n += n0 * *weight;
+            }
+
+            outVerts[mRunVertex[r]] = v;
+            outNorms[mRunVertex[r]] = n;
         }
-        v += v0;
-        n += n0;
-        t += t0;
-        prevIndex = vIndex;
     }
 
     // normalize normals...
-    for (i = 0; i < norms.size(); i++)
+    for (S32 r = 0; r < mRunVertex.size(); r++)
     {
-        // gotta do a check now since shared verts between meshes
-        // may result in an unused vert in the list...
-        Point3F& n = norms[i];
+        Point3F& n = outNorms[mRunVertex[r]];
         F32 len2 = mDot(n, n);
         if (len2 > 0.01f)
-            norms[i] *= 1.0f / mSqrt(len2);
+            n *= 1.0f / mSqrt(len2);
+    }
+}
 
-        // also normalize tangent matrix
-        ((Point3F&)tangents[i]).normalize();
+void TSSkinMesh::fillSkinVB(GFXVertexBufferHandle<MeshVertex>& vb)
+{
+    if (!verts.size() || !GFXDevice::devicePresent())
+        return;
+
+    // Skinned verts live in a persistent buffer so an unchanged pose can
+    // reuse them; the indices never change, so they only go up once.
+    fillVertexBuffer(vb, GFXBufferTypeDynamic);
+    if (mPB.isNull())
+        createPrimitiveBuffer();
+}
+
+bool TSSkinMesh::updateSkinCache(TSSkinCache* cache, const MatrixF* nodeTransforms)
+{
+    U32 numVerts = initialVerts.size();
+
+    bool dirty = false;
+    if (cache->mesh != this || U32(cache->verts.size()) != numVerts)
+    {
+        // New mesh for this instance (detail change or first use).
+        cache->mesh = this;
+        cache->verts.setSize(numVerts);
+        cache->norms.setSize(numVerts);
+        dMemset(cache->verts.address(), 0, numVerts * sizeof(Point3F));
+        dMemset(cache->norms.address(), 0, numVerts * sizeof(Point3F));
+        cache->nodeTransforms.setSize(nodeIndex.size());
+        dirty = true;
+    }
+    else
+    {
+        for (U32 i = 0; i < nodeIndex.size(); i++)
+        {
+            if (dMemcmp(&cache->nodeTransforms[i], &nodeTransforms[nodeIndex[i]], sizeof(MatrixF)))
+            {
+                dirty = true;
+                break;
+            }
+        }
     }
 
+    if (!dirty)
+        return false;
+
+    PROFILE_START(UpdateSkin_skin);
+    for (U32 i = 0; i < nodeIndex.size(); i++)
+        cache->nodeTransforms[i] = nodeTransforms[nodeIndex[i]];
+
+    skinVerts(nodeTransforms, cache->boneTransforms, cache->verts.address(), cache->norms.address());
+    cache->vbValid = false;
+    PROFILE_END();
+    return true;
+}
+
+void TSSkinMesh::updateSkin()
+{
+    if (smGlowPass || smRefractPass)
+    {
+        return;
+    }
+
+    PROFILE_START(UpdateSkin);
+
+    const MatrixF* nodeTransforms = TSShapeInstance::ObjectInstance::smTransforms;
+    U32 numVerts = initialVerts.size();
+
+#if defined(TORQUE_MAX_LIB)
+    verts.setSize(numVerts);
+    norms.setSize(numVerts);
+    skinVerts(nodeTransforms, gBoneTransforms, verts.address(), norms.address());
     createVBIB();
+#else
+    // When rendering, results are kept with the shape instance, so instances
+    // don't overwrite each other's pose and an unchanged pose is free.
+    TSShapeInstance::MeshObjectInstance* inst = TSShapeInstance::smRenderData.currentObjectInstance;
+    TSSkinCache* cache = NULL;
+    for (S32 i = 0; inst && i < inst->object->numMeshes; i++)
+    {
+        if (inst->getMesh(i) == this)
+        {
+            cache = &inst->mSkinCache;
+            break;
+        }
+    }
+
+    if (!cache)
+    {
+        if (U32(mSkinVerts.size()) != numVerts)
+        {
+            mSkinVerts.setSize(numVerts);
+            mSkinNorms.setSize(numVerts);
+            dMemset(mSkinVerts.address(), 0, numVerts * sizeof(Point3F));
+            dMemset(mSkinNorms.address(), 0, numVerts * sizeof(Point3F));
+        }
+
+        skinVerts(nodeTransforms, gBoneTransforms, mSkinVerts.address(), mSkinNorms.address());
+        verts.set(mSkinVerts.address(), numVerts);
+        norms.set(mSkinNorms.address(), numVerts);
+
+        PROFILE_END();
+        return;
+    }
+
+    updateSkinCache(cache, nodeTransforms);
+    verts.set(cache->verts.address(), numVerts);
+    norms.set(cache->norms.address(), numVerts);
+
+    // A device reset leaves dynamic buffers with garbage in them.
+    if (GFXDevice::devicePresent() && (!cache->vbValid || cache->vbResetCount != GFX->getResetCount()))
+    {
+        PROFILE_START(UpdateSkin_upload);
+        fillSkinVB(inst->mVB);
+        cache->vbValid = true;
+        cache->vbResetCount = GFX->getResetCount();
+        PROFILE_END();
+    }
+#endif
 
     PROFILE_END();
 }
@@ -2469,6 +2644,185 @@ void TSSkinMesh::computeBounds(MatrixF& transform, Box3F& bounds, S32 frame, Poi
     TSMesh::computeBounds(initialVerts.address(), initialVerts.size(), transform, bounds, center, radius);
 }
 
+//-----------------------------------------------------------------------------
+
+ConsoleFunction(benchSkinMesh, void, 2, 3, "(shapeFile, [iterations]) Skin every skin mesh in a shape's "
+    "highest detail the given number of times, with and without SSE, and report verts/second.")
+{
+    Resource<TSShape> shape = ResourceManager->load(argv[1]);
+    if (!bool(shape))
+    {
+        Con::errorf("benchSkinMesh - unable to load '%s'.", argv[1]);
+        return;
+    }
+
+    U32 iterations = argc > 2 ? getMax(dAtoi(argv[2]), 1) : 1000;
+
+    TSShapeInstance inst(shape, false);
+    inst.animate(0);
+
+    S32 od = shape->details.size() ? shape->details[0].objectDetailNum : 0;
+    Vector<TSSkinMesh*> skins;
+    U32 numVerts = 0;
+    for (S32 i = 0; i < inst.mMeshObjects.size(); i++)
+    {
+        TSMesh* mesh = inst.mMeshObjects[i].getMesh(od);
+        if (mesh && mesh->getMeshType() == TSMesh::SkinMeshType)
+        {
+            TSSkinMesh* skin = (TSSkinMesh*)mesh;
+            skin->buildSkinBatch();
+            skins.push_back(skin);
+            numVerts += skin->mRunVertex.size();
+        }
+    }
+
+    if (!skins.size())
+    {
+        Con::printf("benchSkinMesh - '%s' has no skin meshes at detail 0.", argv[1]);
+        return;
+    }
+
+    Vector<Point3F> outVerts, outNorms;
+    Vector<MatrixF> boneTransforms;
+    bool oldUseSSE = TSSkinMesh::smUseSSE;
+
+    Con::printf("benchSkinMesh - %s: %d skin meshes, %d skinned verts, %d iterations",
+        argv[1], skins.size(), numVerts, iterations);
+
+    for (U32 pass = 0; pass < 2; pass++)
+    {
+        TSSkinMesh::smUseSSE = (pass == 1);
+
+        U32 start = Platform::getRealMilliseconds();
+        for (U32 iter = 0; iter < iterations; iter++)
+        {
+            for (S32 i = 0; i < skins.size(); i++)
+            {
+                outVerts.setSize(skins[i]->initialVerts.size());
+                outNorms.setSize(skins[i]->initialVerts.size());
+                skins[i]->skinVerts(inst.mNodeTransforms.address(), boneTransforms, outVerts.address(), outNorms.address());
+            }
+        }
+        U32 elapsed = getMax(Platform::getRealMilliseconds() - start, U32(1));
+
+        Con::printf("   %s: %d ms, %.0f verts/second", pass ? "SSE   " : "Scalar",
+            elapsed, F64(numVerts) * iterations * 1000.0 / elapsed);
+
+#ifndef TS_SSE_SKINNING
+        Con::printf("   (SSE skinning not compiled in on this platform)");
+        break;
+#endif
+    }
+
+    TSSkinMesh::smUseSSE = oldUseSSE;
+}
+
+ConsoleFunction(testSkinMeshTangents, bool, 2, 2, "(shapeFile) Check that the texture space of a shape's "
+    "skin meshes follows the skin.  Every bone is posed with the same rigid transform, and the "
+    "normals and T/B/N vectors built from the skinned verts must be the bind pose ones moved the same way.")
+{
+    Resource<TSShape> shape = ResourceManager->load(argv[1]);
+    if (!bool(shape))
+    {
+        Con::errorf("testSkinMeshTangents - unable to load '%s'.", argv[1]);
+        return false;
+    }
+
+    MatrixF rigid(EulerF(0.3f, -0.7f, 1.1f));
+    rigid.setPosition(Point3F(2.0f, -3.0f, 5.0f));
+
+    Vector<MatrixF> nodeTransforms, boneTransforms;
+    Vector<Point3F> outVerts, outNorms;
+    Vector<MeshVertex> bindVerts, skinnedVerts;
+    nodeTransforms.setSize(shape->nodes.size());
+
+    U32 numSkins = 0, numVerts = 0;
+    F32 maxError = 0.0f;
+    for (S32 m = 0; m < shape->meshes.size(); m++)
+    {
+        TSMesh* mesh = shape->meshes[m];
+        if (!mesh || mesh->getMeshType() != TSMesh::SkinMeshType)
+            continue;
+
+        TSSkinMesh* skin = (TSSkinMesh*)mesh;
+        U32 count = skin->initialVerts.size();
+        if (!count || skin->tverts.size() < count)
+            continue;
+
+        // Undo each bone's bind transform, then apply the rigid one.
+        for (U32 b = 0; b < skin->nodeIndex.size(); b++)
+        {
+            MatrixF invBind = skin->initialTransforms[b];
+            invBind.inverse();
+            nodeTransforms[skin->nodeIndex[b]].mul(rigid, invBind);
+        }
+
+        bindVerts.setSize(count);
+        skinnedVerts.setSize(count);
+        outVerts.setSize(count);
+        outNorms.setSize(count);
+        dMemset(bindVerts.address(), 0, count * sizeof(MeshVertex));
+        dMemset(skinnedVerts.address(), 0, count * sizeof(MeshVertex));
+
+        for (U32 i = 0; i < count; i++)
+        {
+            bindVerts[i].point = skin->initialVerts[i];
+            bindVerts[i].normal = skin->encodedNorms.size() ? skin->decodeNormal(skin->encodedNorms[i]) : skin->initialNorms[i];
+            bindVerts[i].texCoord = skin->tverts[i];
+
+            // skinVerts() leaves verts without influences alone.
+            rigid.mulP(bindVerts[i].point, &outVerts[i]);
+            rigid.mulV(bindVerts[i].normal, &outNorms[i]);
+        }
+
+        skin->skinVerts(nodeTransforms.address(), boneTransforms, outVerts.address(), outNorms.address());
+
+        for (U32 i = 0; i < count; i++)
+        {
+            skinnedVerts[i].point = outVerts[i];
+            skinnedVerts[i].normal = outNorms[i];
+            skinnedVerts[i].texCoord = skin->tverts[i];
+        }
+
+        // The same thing fillVertexBuffer() does for the skinned verts.
+        skin->fillTextureSpaceInfo(bindVerts.address());
+        skin->fillTextureSpaceInfo(skinnedVerts.address());
+
+        for (U32 i = 0; i < count; i++)
+        {
+            const Point3F* bind[4] = { &bindVerts[i].normal, &bindVerts[i].T, &bindVerts[i].B, &bindVerts[i].N };
+            const Point3F* skinned[4] = { &skinnedVerts[i].normal, &skinnedVerts[i].T, &skinnedVerts[i].B, &skinnedVerts[i].N };
+            for (U32 k = 0; k < 4; k++)
+            {
+                Point3F expected;
+                rigid.mulV(*bind[k], &expected);
+                if (expected.lenSquared() < 1e-12f)
+                    continue;
+
+                Point3F actual = *skinned[k];
+                expected.normalize();
+                if (actual.lenSquared() > 1e-12f)
+                    actual.normalize();
+                maxError = getMax(maxError, (actual - expected).len());
+            }
+        }
+
+        numSkins++;
+        numVerts += count;
+    }
+
+    if (!numSkins)
+    {
+        Con::printf("testSkinMeshTangents - '%s' has no textured skin meshes.", argv[1]);
+        return false;
+    }
+
+    bool ok = maxError < 1e-3f;
+    Con::printf("testSkinMeshTangents - %s: %d skin meshes, %d verts, max error %g: %s",
+        argv[1], numSkins, numVerts, maxError, ok ? "ok" : "FAILED");
+    return ok;
+}
+
 //-----------------------------------------------------
 // encoded normals
 //-----------------------------------------------------
@@ -3244,8 +3598,19 @@ void TSMesh::createVBIB()
 
     PROFILE_START(CreateVBIB);
 
+    fillVertexBuffer(mVB, mDynamic ? GFXBufferTypeVolatile : GFXBufferTypeStatic);
+    createPrimitiveBuffer();
 
-    MeshVertex* tempVerts = new MeshVertex[verts.size()];
+    PROFILE_END();
+}
+
+// Scratch space for building vertex buffer contents; only grows.
+static Vector<MeshVertex> gVertexBufferScratch;
+
+void TSMesh::fillVertexBuffer(GFXVertexBufferHandle<MeshVertex>& vb, GFXBufferType type)
+{
+    gVertexBufferScratch.setSize(verts.size());
+    MeshVertex* tempVerts = gVertexBufferScratch.address();
 
     // fill in basic info
     for (U32 i = 0; i < verts.size(); i++)
@@ -3259,16 +3624,18 @@ void TSMesh::createVBIB()
     fillTextureSpaceInfo(tempVerts);
 
     // copy to video mem
+    if (vb.isNull() || vb->mNumVerts != verts.size() || vb->mBufferType != type || type == GFXBufferTypeVolatile)
+        vb.set(GFX, verts.size(), type);
 
-    mVB.set(GFX, verts.size(), mDynamic ? GFXBufferTypeVolatile : GFXBufferTypeStatic);
-    MeshVertex* vbVerts = mVB.lock();
+    MeshVertex* vbVerts = vb.lock();
 
     dMemcpy(vbVerts, tempVerts, sizeof(MeshVertex) * verts.size());
 
-    mVB.unlock();
-
-    delete[] tempVerts;
+    vb.unlock();
+}
 
+void TSMesh::createPrimitiveBuffer()
+{
     // go through and create PrimitiveInfo array
     Vector <GFXPrimitive> piArray;
     for (S32 i = 0; i < primitives.size(); i++)
@@ -3316,8 +3683,6 @@ void TSMesh::createVBIB()
     dMemcpy(piInput, piArray.address(), piArray.size() * sizeof(GFXPrimitive));
 
     mPB.unlock();
-
-    PROFILE_END();
 }
 
 
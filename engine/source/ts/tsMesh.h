@@ -235,6 +235,13 @@ public:
     virtual GFXVertexBufferHandle<MeshVertex>& getVertexBuffer() { return mVB; };
 
     void createVBIB();
+
+    /// Fill in a vertex buffer from verts, tverts and norms, (re)creating it
+    /// only if it doesn't already hold the right number of verts.
+    void fillVertexBuffer(GFXVertexBufferHandle<MeshVertex>& vb, GFXBufferType type);
+
+    /// Build the primitive buffer from indices and primitives.
+    void createPrimitiveBuffer();
     void createTextureSpaceMatrix(MeshVertex* v0, MeshVertex* v1, MeshVertex* v2);
     void fillTextureSpaceInfo(MeshVertex* vertArray);
 
@@ -294,6 +301,25 @@ public:
 
 inline const Point3F& TSMesh::decodeNormal(U8 ncode) { return smU8ToNormalTable[ncode]; }
 
+class TSSkinMesh;
+
+/// Skinned verts and normals for one skin mesh of one shape instance.
+///
+/// Remembers the node transforms it was skinned with, so an instance whose
+/// pose hasn't changed skips both the skinning and the vertex buffer upload.
+struct TSSkinCache
+{
+    const TSSkinMesh* mesh;         ///< mesh the cache currently holds results for
+    Vector<MatrixF> nodeTransforms; ///< transforms of the mesh's bone nodes when skinned
+    Vector<Point3F> verts;
+    Vector<Point3F> norms;
+    Vector<MatrixF> boneTransforms; ///< skinning scratch
+    bool vbValid;                   ///< instance vertex buffer holds verts and norms
+    U32 vbResetCount;               ///< GFX reset count when the buffer was filled
+
+    TSSkinCache() : mesh(NULL), vbValid(false), vbResetCount(0) {}
+};
+
 class TSSkinMesh : public TSMesh
 {
 public:
@@ -315,9 +341,52 @@ public:
     ToolVector<Point3F> initialVerts;
     ToolVector<Point3F> initialNorms;
 
+    /// Influences regrouped for the skinning kernel, built on first use.
+    /// One run per skinned vertex, with that vertex's influences stored
+    /// consecutively in the influence arrays.
+    /// @{
+    Vector<S32>     mRunVertex;       ///< vertex written by each run
+    Vector<U32>     mRunInfluences;   ///< number of influences in each run
+    Vector<Point4F> mRunInitialVerts; ///< initial vert of each run, w = 1
+    Vector<Point4F> mRunInitialNorms; ///< initial (decoded) normal of each run, w = 0
+    Vector<U32>     mInfluenceBone;
+    Vector<F32>     mInfluenceWeight;
+    bool            mSkinBatchBuilt;
+    /// @}
+
+    /// Skinned verts and normals when there's no shape instance to cache
+    /// them with (collision queries and the like).
+    Vector<Point3F> mSkinVerts;
+    Vector<Point3F> mSkinNorms;
+
+    void buildSkinBatch();
+
+    /// Use the SSE skinning kernel where available.
+    static bool smUseSSE;
+
     /// set verts and normals...
     void updateSkin();
 
+    /// Skin every vert and normal using the given node transforms (indexed
+    /// by shape node, as in TSShapeInstance::mNodeTransforms). Verts not
+    /// referenced by any influence are left untouched.  boneTransforms is
+    /// scratch space; the skin batch must already be built if this is being
+    /// called off the main thread.
+    void skinVerts(const MatrixF* nodeTransforms, Vector<MatrixF>& boneTransforms,
+        Point3F* outVerts, Point3F* outNorms);
+
+    /// Bring cache up to date with the given node transforms, reskinning
+    /// only if one of the mesh's bones moved.  Touches nothing but the mesh's
+    /// (already built) skin batch and the cache, so it's safe to run for
+    /// different caches in parallel.
+    ///
+    /// @returns true if the verts were reskinned.
+    bool updateSkinCache(TSSkinCache* cache, const MatrixF* nodeTransforms);
+
+    /// Upload verts and norms into a vertex buffer.  The T/B/N vectors for
+    /// normal mapping are rebuilt from the skinned verts as they go up.
+    void fillSkinVB(GFXVertexBufferHandle<MeshVertex>& vb);
+
     // overrides from TSMesh
     GFXVertexBufferHandle<MeshVertex>& getVertexBuffer();
 
@@ -348,6 +417,7 @@ public:
     {
         meshType = SkinMeshType;
         mDynamic = true;
+        mSkinBatchBuilt = false;
     }
 };
 
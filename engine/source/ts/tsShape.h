@@ -568,7 +568,7 @@ public:
     bool reflectionInAlpha(U32 index) { return mReflectanceMaps[index] == index; }
     bool isIFL(U32 index)
     {
-        if (index < mFlags.size())
+        if (index < U32(mFlags.size()))
         {
             return mFlags[index] & IflMaterial;
         }
@@ -10,6 +10,7 @@
 #include "ts/tsDecal.h"
 #include "platform/profiler.h"
 #include "core/frameAllocator.h"
+#include "core/threadPool.h"
 #include "gfx/gfxDevice.h"
 #include "gfx/gfxCanon.h"
 #include "materials/sceneData.h"
@@ -28,15 +29,10 @@ S32                           TSShapeInstance::smNumSkipRenderDetails = 0;
 bool                          TSShapeInstance::smSkipFirstFog = false;
 bool                          TSShapeInstance::smSkipFog = false;
 
-Vector<QuatF>                 TSShapeInstance::smNodeCurrentRotations(__FILE__, __LINE__);
-Vector<Point3F>               TSShapeInstance::smNodeCurrentTranslations(__FILE__, __LINE__);
-Vector<F32>                   TSShapeInstance::smNodeCurrentUniformScales(__FILE__, __LINE__);
-Vector<Point3F>               TSShapeInstance::smNodeCurrentAlignedScales(__FILE__, __LINE__);
-Vector<TSScale>               TSShapeInstance::smNodeCurrentArbitraryScales(__FILE__, __LINE__);
+S32                           TSShapeInstance::smAnimateThreads = 3;
+Vector<TSShapeInstance*>      TSShapeInstance::smAnimateQueue(__FILE__, __LINE__);
+ThreadPool*                   TSShapeInstance::smAnimatePool = NULL;
 
-Vector<TSThread*>             TSShapeInstance::smRotationThreads(__FILE__, __LINE__);
-Vector<TSThread*>             TSShapeInstance::smTranslationThreads(__FILE__, __LINE__);
-Vector<TSThread*>             TSShapeInstance::smScaleThreads(__FILE__, __LINE__);
 
 namespace {
 
@@ -78,6 +74,14 @@ TSShapeInstance::TSShapeInstance(const Resource<TSShape>& shape, bool loadMateri
     VECTOR_SET_ASSOCIATION(mNodeReferenceUniformScales);
     VECTOR_SET_ASSOCIATION(mNodeReferenceScaleFactors);
     VECTOR_SET_ASSOCIATION(mNodeReferenceArbitraryScaleRots);
+    VECTOR_SET_ASSOCIATION(mNodeCurrentRotations);
+    VECTOR_SET_ASSOCIATION(mNodeCurrentTranslations);
+    VECTOR_SET_ASSOCIATION(mNodeCurrentUniformScales);
+    VECTOR_SET_ASSOCIATION(mNodeCurrentAlignedScales);
+    VECTOR_SET_ASSOCIATION(mNodeCurrentArbitraryScales);
+    VECTOR_SET_ASSOCIATION(mRotationThreads);
+    VECTOR_SET_ASSOCIATION(mTranslationThreads);
+    VECTOR_SET_ASSOCIATION(mScaleThreads);
     VECTOR_SET_ASSOCIATION(mThreadList);
     VECTOR_SET_ASSOCIATION(mTransitionThreads);
 
@@ -99,6 +103,14 @@ TSShapeInstance::TSShapeInstance(TSShape* _shape, bool loadMaterials)
     VECTOR_SET_ASSOCIATION(mNodeReferenceUniformScales);
     VECTOR_SET_ASSOCIATION(mNodeReferenceScaleFactors);
     VECTOR_SET_ASSOCIATION(mNodeReferenceArbitraryScaleRots);
+    VECTOR_SET_ASSOCIATION(mNodeCurrentRotations);
+    VECTOR_SET_ASSOCIATION(mNodeCurrentTranslations);
+    VECTOR_SET_ASSOCIATION(mNodeCurrentUniformScales);
+    VECTOR_SET_ASSOCIATION(mNodeCurrentAlignedScales);
+    VECTOR_SET_ASSOCIATION(mNodeCurrentArbitraryScales);
+    VECTOR_SET_ASSOCIATION(mRotationThreads);
+    VECTOR_SET_ASSOCIATION(mTranslationThreads);
+    VECTOR_SET_ASSOCIATION(mScaleThreads);
     VECTOR_SET_ASSOCIATION(mThreadList);
     VECTOR_SET_ASSOCIATION(mTransitionThreads);
 
@@ -109,6 +121,15 @@ TSShapeInstance::TSShapeInstance(TSShape* _shape, bool loadMaterials)
 TSShapeInstance::~TSShapeInstance()
 {
     S32 i;
+    if (mAnimateQueueIndex != -1)
+    {
+        // swap the last queued instance into our slot
+        TSShapeInstance* last = smAnimateQueue.last();
+        smAnimateQueue[mAnimateQueueIndex] = last;
+        last->mAnimateQueueIndex = mAnimateQueueIndex;
+        smAnimateQueue.decrement();
+    }
+
     for (i = 0; i < mMeshObjects.size(); i++)
         destructInPlace(&mMeshObjects[i]);
 
@@ -139,11 +160,16 @@ void TSShapeInstance::init()
     Con::addVariable("$pref::TS::skipRenderDLs", TypeS32, &smNumSkipRenderDetails);
     Con::addVariable("$pref::TS::skipFirstFog", TypeBool, &smSkipFirstFog);
     Con::addVariable("$pref::TS::screenError", TypeF32, &smScreenError);
+    Con::addVariable("$pref::TS::sseSkinning", TypeBool, &TSSkinMesh::smUseSSE);
+    Con::addVariable("$pref::TS::animateThreads", TypeS32, &smAnimateThreads);
 }
 
 void TSShapeInstance::destroy()
 {
     //   delete smRenderData.fogHandle;
+
+    delete smAnimatePool;
+    smAnimatePool = NULL;
 }
 
 void TSShapeInstance::buildInstanceData(TSShape* _shape, bool loadMaterials)
@@ -168,6 +194,8 @@ void TSShapeInstance::buildInstanceData(TSShape* _shape, bool loadMaterials)
     mCallback = NULL;
     mCallbackData = 0;
 
+    mAnimateQueueIndex = -1;
+
     mCurrentDetailLevel = 0;
     mCurrentIntraDetailLevel = 1.0f;
 
@@ -28,6 +28,7 @@
 class RenderItem;
 class TSThread;
 class ConvexFeature;
+class ThreadPool;
 
 //-------------------------------------------------------------------------------------
 // Instance versions of shape objects
@@ -134,6 +135,9 @@ public:
         // when rendering.
         GFXVertexBufferHandle<MeshVertex> mVB;
 
+        /// Skinned results for the skin mesh last rendered in mVB.
+        TSSkinCache mSkinCache;
+
         S32 getSizeVB(S32 size);
         bool hasMergeIndices();
         /// @name Vertex Buffer functions
@@ -220,20 +224,37 @@ public:
     /// @}
 
     /// @name Workspace for Node Transforms
+    /// Kept per instance (rather than shared) so separate instances can be
+    /// animated on separate threads, and so transitions start from this
+    /// instance's last pose.
+    /// @{
+    Vector<QuatF>   mNodeCurrentRotations;
+    Vector<Point3F> mNodeCurrentTranslations;
+    Vector<F32>     mNodeCurrentUniformScales;
+    Vector<Point3F> mNodeCurrentAlignedScales;
+    Vector<TSScale> mNodeCurrentArbitraryScales;
+    /// @}
+
+    /// @name Parallel Animation
     /// @{
-    static Vector<QuatF>   smNodeCurrentRotations;
-    static Vector<Point3F> smNodeCurrentTranslations;
-    static Vector<F32>     smNodeCurrentUniformScales;
-    static Vector<Point3F> smNodeCurrentAlignedScales;
-    static Vector<TSScale> smNodeCurrentArbitraryScales;
+    static Vector<TSShapeInstance*> smAnimateQueue;
+    static ThreadPool* smAnimatePool;
+    S32 mAnimateQueueIndex; ///< index in smAnimateQueue, -1 if not queued
+
+    static void animateQueuedWork(void* data, U32 index);
+
+    /// Bring the skin caches of the skin meshes drawn at the current detail
+    /// up to date with mNodeTransforms.  If buildOnly is set, only make sure
+    /// their skin batches are built.
+    void updateSkinCaches(bool buildOnly);
     /// @}
 
     /// @name Threads
-    /// keep track of who controls what on currently animating shape
+    /// keep track of who controls what on this shape while it animates
     /// @{
-    static Vector<TSThread*> smRotationThreads;
-    static Vector<TSThread*> smTranslationThreads;
-    static Vector<TSThread*> smScaleThreads;
+    Vector<TSThread*> mRotationThreads;
+    Vector<TSThread*> mTranslationThreads;
+    Vector<TSThread*> mScaleThreads;
     /// @}
 
  //-------------------------------------------------------------------------------------
@@ -580,6 +601,26 @@ public:
     void animateSubtrees(bool forceFull = true);
     void animateNodeSubtrees(bool forceFull = true);
 
+    /// @name Parallel Animation
+    /// Instances drawn in a frame are queued, and the queue is animated
+    /// across a pool of threads before the next scene is prepped, along with
+    /// the skins of the detail being drawn.  The animate() and skinning done
+    /// while prepping then mostly find nothing left to do.
+    /// @{
+
+    /// Queue this instance for the next animateQueued().  Call after the
+    /// instance's detail level for rendering has been selected.
+    void queueAnimate();
+
+    /// Animate every queued instance at its current detail level, update
+    /// the skin caches of the meshes that detail draws, and empty the queue.
+    /// Instances with a node callback are animated on the calling thread.
+    static void animateQueued();
+
+    /// Worker threads used by animateQueued(), not counting the calling thread.
+    static S32 smAnimateThreads;
+    /// @}
+
     bool hasTranslucency();
     bool hasSolid();
 
@@ -637,14 +637,32 @@ void TSShapeInstance::updateTransitions()
         return;
 
     S32 i;
+    if (U32(mNodeCurrentRotations.size()) != mShape->nodes.size())
+    {
+        // never animated, so transition from the default pose
+        mNodeCurrentRotations.setSize(mShape->nodes.size());
+        mNodeCurrentTranslations.setSize(mShape->nodes.size());
+        mNodeCurrentUniformScales.setSize(mShape->nodes.size());
+        mNodeCurrentAlignedScales.setSize(mShape->nodes.size());
+        mNodeCurrentArbitraryScales.setSize(mShape->nodes.size());
+        for (i = 0; i < S32(mShape->nodes.size()); i++)
+        {
+            mShape->defaultRotations[i].getQuatF(&mNodeCurrentRotations[i]);
+            mNodeCurrentTranslations[i] = mShape->defaultTranslations[i];
+            mNodeCurrentUniformScales[i] = 1.0f;
+            mNodeCurrentAlignedScales[i].set(1.0f, 1.0f, 1.0f);
+            mNodeCurrentArbitraryScales[i].identity();
+        }
+    }
+
     mNodeReferenceRotations.setSize(mShape->nodes.size());
     mNodeReferenceTranslations.setSize(mShape->nodes.size());
     for (i = 0; i < mShape->nodes.size(); i++)
     {
         if (mTransitionRotationNodes.test(i))
-            mNodeReferenceRotations[i].set(smNodeCurrentRotations[i]);
+            mNodeReferenceRotations[i].set(mNodeCurrentRotations[i]);
         if (mTransitionTranslationNodes.test(i))
-            mNodeReferenceTranslations[i] = smNodeCurrentTranslations[i];
+            mNodeReferenceTranslations[i] = mNodeCurrentTranslations[i];
     }
 
     if (animatesScale())
@@ -655,7 +673,7 @@ void TSShapeInstance::updateTransitions()
             for (i = 0; i < mShape->nodes.size(); i++)
             {
                 if (mTransitionScaleNodes.test(i))
-                    mNodeReferenceUniformScales[i] = smNodeCurrentUniformScales[i];
+                    mNodeReferenceUniformScales[i] = mNodeCurrentUniformScales[i];
             }
         }
         else if (animatesAlignedScale())
@@ -664,7 +682,7 @@ void TSShapeInstance::updateTransitions()
             for (i = 0; i < mShape->nodes.size(); i++)
             {
                 if (mTransitionScaleNodes.test(i))
-                    mNodeReferenceScaleFactors[i] = smNodeCurrentAlignedScales[i];
+                    mNodeReferenceScaleFactors[i] = mNodeCurrentAlignedScales[i];
             }
         }
         else
@@ -675,8 +693,8 @@ void TSShapeInstance::updateTransitions()
             {
                 if (mTransitionScaleNodes.test(i))
                 {
-                    mNodeReferenceScaleFactors[i] = smNodeCurrentArbitraryScales[i].mScale;
-                    mNodeReferenceArbitraryScaleRots[i].set(smNodeCurrentArbitraryScales[i].mRotate);
+                    mNodeReferenceScaleFactors[i] = mNodeCurrentArbitraryScales[i].mScale;
+                    mNodeReferenceArbitraryScaleRots[i].set(mNodeCurrentArbitraryScales[i].mRotate);
                 }
             }
         }
@@ -74,12 +74,18 @@ function loadMissionStage2()
    // to caching mission lighting.
    $missionCRC = getFileCRC( %file );
 
+   // Start reading the mission's interiors and shapes in the background,
+   // the mission objects pick them up as they're created.
+   %preload = preloadMissionResources( %file );
+
    // Exec the mission, objects are added to the ServerGroup
    exec(%file);
    
    // If there was a problem with the load, let's try another mission
    if( !isObject(MissionGroup) ) {
       error( "No 'MissionGroup' found in mission \"" @ $missionName @ "\"." );
+      if( %preload )
+         releaseResourcePreload( %preload );
       schedule( 3000, ServerGroup, CycleMissions );
       return;
    }
@@ -97,6 +103,12 @@ function loadMissionStage2()
 
    // Mission loading done...
    echo("*** Mission loaded");
+   if( %preload )
+   {
+      waitForResourcePreload( %preload );
+      resourcePreloadReport( %preload, getRealTime() - $missionLoadStart );
+      releaseResourcePreload( %preload );
+   }
    
    // Start all the clients in the mission
    $missionRunning = true;
@@ -110,6 +110,7 @@ addPath("${srcDir}/sceneGraph")
 addPath("${srcDir}/sfx")
 addPath("${srcDir}/sfx/vorbis")
 addPath("${srcDir}/sfx/null")
+addPath("${srcDir}/sfx/soft")
 addPath("${srcDir}/shaderGen")
 addPath("${srcDir}/sim")
 #addPath("${srcDir}/terrain")